@@ -89,6 +89,8 @@
 #include "03 Command Buffers and Synchronization/17 Destroying a semaphore.h"
 #include "03 Command Buffers and Synchronization/18 Freeing command buffers.h"
 #include "03 Command Buffers and Synchronization/19 Destroying a command pool.h"
+#include "03 Command Buffers and Synchronization/20 Using a ring of command pools.h"
+#include "03 Command Buffers and Synchronization/21 Deferring destruction of objects used by frames in flight.h"
 
 #include "04 Resources and Memory/01 Creating a buffer.h"
 #include "04 Resources and Memory/02 Allocating and binding memory object to a buffer.h"
@@ -111,6 +113,11 @@
 #include "04 Resources and Memory/19 Destroying a buffer view.h"
 #include "04 Resources and Memory/20 Freeing a memory object.h"
 #include "04 Resources and Memory/21 Destroying a buffer.h"
+#include "04 Resources and Memory/22 Sub-allocating memory objects from larger memory blocks.h"
+#include "04 Resources and Memory/23 Uploading data through a persistently mapped staging ring.h"
+#include "04 Resources and Memory/24 Generating mipmaps of an image with blits.h"
+#include "04 Resources and Memory/25 Sub-allocating uniform data from a per-frame ring buffer.h"
+#include "04 Resources and Memory/26 Keeping memory objects persistently mapped with dirty range tracking.h"
 
 #include "05 Descriptor Sets/01 Creating a sampler.h"
 #include "05 Descriptor Sets/02 Creating a sampled image.h"
@@ -132,6 +139,8 @@
 #include "05 Descriptor Sets/18 Destroying a descriptor pool.h"
 #include "05 Descriptor Sets/19 Destroying a descriptor set layout.h"
 #include "05 Descriptor Sets/20 Destroying a sampler.h"
+#include "05 Descriptor Sets/21 Allocating transient descriptor sets from growable pool chains.h"
+#include "05 Descriptor Sets/22 Batching descriptor set updates.h"
 
 #include "06 Render Passes and Framebuffers/01 Specifying attachments descriptions.h"
 #include "06 Render Passes and Framebuffers/02 Specifying subpass descriptions.h"
@@ -145,6 +154,7 @@
 #include "06 Render Passes and Framebuffers/10 Ending a render pass.h"
 #include "06 Render Passes and Framebuffers/11 Destroying a framebuffer.h"
 #include "06 Render Passes and Framebuffers/12 Destroying a render pass.h"
+#include "06 Render Passes and Framebuffers/13 Caching framebuffers.h"
 
 #include "08 Graphics and Compute Pipelines/01 Creating a shader module.h"
 #include "08 Graphics and Compute Pipelines/02 Specifying pipeline shader stages.h"
@@ -172,6 +182,8 @@
 #include "08 Graphics and Compute Pipelines/24 Destroying a pipeline cache.h"
 #include "08 Graphics and Compute Pipelines/25 Destroying a pipeline layout.h"
 #include "08 Graphics and Compute Pipelines/26 Destroying a shader module.h"
+#include "08 Graphics and Compute Pipelines/27 Storing pipeline cache data in a file.h"
+#include "08 Graphics and Compute Pipelines/28 Caching descriptor set layouts and pipeline layouts.h"
 
 #include "09 Command Recording and Drawing/01 Clearing a color image.h"
 #include "09 Command Recording and Drawing/02 Clearing a depth-stencil image.h"
@@ -192,6 +204,8 @@
 #include "09 Command Recording and Drawing/17 Recording command buffers on multiple threads.h"
 #include "09 Command Recording and Drawing/18 Preparing a single frame of animation.h"
 #include "09 Command Recording and Drawing/19 Increasing the performance through increasing the number of separately rendered frames.h"
+#include "09 Command Recording and Drawing/20 Pacing frames rendered in parallel.h"
+#include "09 Command Recording and Drawing/21 Recording command buffers on a persistent pool of threads.h"
 
 #include "10 Helper Recipes/01 Preparing a translation matrix.h"
 #include "10 Helper Recipes/02 Preparing a rotation matrix.h"
@@ -200,6 +214,12 @@
 #include "10 Helper Recipes/05 Preparing an orthographic projection matrix.h"
 #include "10 Helper Recipes/06 Loading texture data from a file.h"
 #include "10 Helper Recipes/07 Loading a 3D model from an OBJ file.h"
+#include "10 Helper Recipes/08 Loading an indexed 3D model from an OBJ file.h"
+#include "10 Helper Recipes/09 Optimizing an indexed mesh for the post-transform vertex cache.h"
+#include "10 Helper Recipes/10 Caching a 3D model in a binary file.h"
+#include "10 Helper Recipes/11 Loading texture data from multiple files in parallel.h"
+#include "10 Helper Recipes/12 Generating a mipmap chain on a CPU.h"
+#include "10 Helper Recipes/13 Loading texture data from a KTX or DDS file.h"
 
 
 #endif // ALL_HEADERS
\ No newline at end of file
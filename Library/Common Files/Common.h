@@ -68,7 +68,7 @@ namespace VulkanCookbook {
 #elif defined VK_USE_PLATFORM_XLIB_KHR
 
     Display          * Dpy;
-    Window             Window;
+    ::Window           Window;
 
 #elif defined VK_USE_PLATFORM_XCB_KHR
 
@@ -112,10 +112,12 @@ DEVICE_LEVEL_VULKAN_FUNCTION( vkBindImageMemory )
 DEVICE_LEVEL_VULKAN_FUNCTION( vkCreateImageView )
 DEVICE_LEVEL_VULKAN_FUNCTION( vkMapMemory )
 DEVICE_LEVEL_VULKAN_FUNCTION( vkFlushMappedMemoryRanges )
+DEVICE_LEVEL_VULKAN_FUNCTION( vkInvalidateMappedMemoryRanges )
 DEVICE_LEVEL_VULKAN_FUNCTION( vkUnmapMemory )
 DEVICE_LEVEL_VULKAN_FUNCTION( vkCmdCopyBuffer )
 DEVICE_LEVEL_VULKAN_FUNCTION( vkCmdCopyBufferToImage )
 DEVICE_LEVEL_VULKAN_FUNCTION( vkCmdCopyImageToBuffer )
+DEVICE_LEVEL_VULKAN_FUNCTION( vkCmdBlitImage )
 DEVICE_LEVEL_VULKAN_FUNCTION( vkBeginCommandBuffer )
 DEVICE_LEVEL_VULKAN_FUNCTION( vkEndCommandBuffer )
 DEVICE_LEVEL_VULKAN_FUNCTION( vkQueueSubmit )
@@ -129,6 +131,7 @@ DEVICE_LEVEL_VULKAN_FUNCTION( vkCreateSemaphore )
 DEVICE_LEVEL_VULKAN_FUNCTION( vkCreateFence )
 DEVICE_LEVEL_VULKAN_FUNCTION( vkWaitForFences )
 DEVICE_LEVEL_VULKAN_FUNCTION( vkResetFences )
+DEVICE_LEVEL_VULKAN_FUNCTION( vkGetFenceStatus )
 DEVICE_LEVEL_VULKAN_FUNCTION( vkDestroyFence )
 DEVICE_LEVEL_VULKAN_FUNCTION( vkDestroySemaphore )
 DEVICE_LEVEL_VULKAN_FUNCTION( vkResetCommandBuffer )
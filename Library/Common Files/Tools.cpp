@@ -25,6 +25,7 @@
 //
 // Tools
 
+#include <cstdio>
 #include <fstream>
 #include <iostream>
 #include <cmath>
@@ -60,6 +61,38 @@ namespace VulkanCookbook {
     return true;
   }
 
+  bool SaveBinaryFile( std::string const                & filename,
+                       std::vector<unsigned char> const & contents ) {
+    // Contents are written to a temporary file first and then it replaces the target file,
+    // so readers never see a partially written file (e.g. when application is terminated)
+    std::string temporary_filename = filename + ".tmp";
+
+    std::ofstream file( temporary_filename, std::ios::binary | std::ios::trunc );
+    if( file.fail() ) {
+      std::cout << "Could not open '" << temporary_filename << "' file." << std::endl;
+      return false;
+    }
+    file.write( reinterpret_cast<char const*>(contents.data()), contents.size() );
+    file.close();
+    if( file.fail() ) {
+      std::cout << "Could not write to '" << temporary_filename << "' file." << std::endl;
+      std::remove( temporary_filename.c_str() );
+      return false;
+    }
+
+#ifdef _WIN32
+    bool renamed = 0 != MoveFileExA( temporary_filename.c_str(), filename.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH );
+#else
+    bool renamed = 0 == std::rename( temporary_filename.c_str(), filename.c_str() );
+#endif
+    if( !renamed ) {
+      std::cout << "Could not replace '" << filename << "' file." << std::endl;
+      std::remove( temporary_filename.c_str() );
+      return false;
+    }
+    return true;
+  }
+
   float Deg2Rad( float value ) {
     return value * 0.01745329251994329576923690768489f;
   }
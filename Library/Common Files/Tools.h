@@ -42,6 +42,9 @@ namespace VulkanCookbook {
   bool GetBinaryFileContents( std::string const          & filename,
                               std::vector<unsigned char> & contents );
 
+  bool SaveBinaryFile( std::string const                & filename,
+                       std::vector<unsigned char> const & contents );
+
   float Deg2Rad( float value );
 
   float Dot( Vector3 const & left,
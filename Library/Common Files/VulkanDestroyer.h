@@ -32,7 +32,6 @@
 #ifndef VULKAN_DESTROYER
 #define VULKAN_DESTROYER
 
-#include <functional>
 #include "VulkanFunctions.h"
 
 namespace VulkanCookbook {
@@ -107,49 +106,77 @@ namespace VulkanCookbook {
   VK_DESTROYER_SPECIALIZATION( VkCommandPool, vkDestroyCommandPool )
   VK_DESTROYER_SPECIALIZATION( VkSwapchainKHR, vkDestroySwapchainKHR )
 
+  // Parent objects needed to destroy objects of a given type - most objects are created from a logical device;
+  // instances and devices don't have parents, so only a flag is stored which informs that the destroyer was initialized
+
+  template<class VkTypeWrapper>
+  struct VkDestroyerParent {
+    typedef VkDevice Type;
+  };
+
+  template<>
+  struct VkDestroyerParent<VkInstanceWrapper> {
+    typedef bool Type;
+  };
+
+  template<>
+  struct VkDestroyerParent<VkDeviceWrapper> {
+    typedef bool Type;
+  };
+
+  template<>
+  struct VkDestroyerParent<VkSurfaceKHRWrapper> {
+    typedef VkInstance Type;
+  };
+
   // Class definition
 
+  // Only a handle and its parent are stored; a deleter is selected at compile time from the DestroyVulkanObject<>()
+  // specializations, so there is no per-object allocation and no indirect call during destruction
+
   template<class VkTypeWrapper>
   class VkDestroyer {
   public:
+    typedef typename VkDestroyerParent<VkTypeWrapper>::Type VkParentType;
+
     VkDestroyer() :
-      DestroyerFunction( nullptr ) {
+      Parent() {
       Object.Handle = VK_NULL_HANDLE;
     }
 
-    VkDestroyer( std::function<void( VkTypeWrapper )> destroyer_function ) :
-      DestroyerFunction( destroyer_function ) {
+    explicit VkDestroyer( VkParentType parent ) :
+      Parent( parent ) {
       Object.Handle = VK_NULL_HANDLE;
     }
 
-    VkDestroyer( VkTypeWrapper object, std::function<void( VkTypeWrapper )> destroyer_function ) :
-      DestroyerFunction( destroyer_function ) {
+    VkDestroyer( VkTypeWrapper object, VkParentType parent ) :
+      Parent( parent ) {
       Object.Handle = object.Handle;
     }
 
     ~VkDestroyer() {
-      if( DestroyerFunction && Object.Handle ) {
-        DestroyerFunction( Object );
+      if( Parent && Object.Handle ) {
+        Destroy( Parent, Object );
       }
     }
 
     VkDestroyer( VkDestroyer<VkTypeWrapper> && other ) :
-      DestroyerFunction( other.DestroyerFunction ) {
+      Parent( other.Parent ) {
       Object.Handle = other.Object.Handle;
       other.Object.Handle = VK_NULL_HANDLE;
-      other.DestroyerFunction = nullptr;
+      other.Parent = VkParentType();
     }
 
     VkDestroyer& operator=( VkDestroyer<VkTypeWrapper> && other ) {
       if( this != &other ) {
         VkTypeWrapper object = Object;
-        std::function<void( VkTypeWrapper )> destroyer_function = DestroyerFunction;
+        VkParentType parent = Parent;
 
         Object.Handle = other.Object.Handle;
-        DestroyerFunction = other.DestroyerFunction;
+        Parent = other.Parent;
 
         other.Object.Handle = object.Handle;
-        other.DestroyerFunction = destroyer_function;
+        other.Parent = parent;
       }
       return *this;
     }
@@ -170,12 +197,33 @@ namespace VulkanCookbook {
       return Object.Handle != VK_NULL_HANDLE;
     }
 
+    VkParentType GetParent() const {
+      return Parent;
+    }
+
+    // Gives up the ownership - returned object is not destroyed by the destroyer anymore
+    decltype(VkTypeWrapper::Handle) Release() {
+      decltype(VkTypeWrapper::Handle) handle = Object.Handle;
+      Object.Handle = VK_NULL_HANDLE;
+      Parent = VkParentType();
+      return handle;
+    }
+
     VkDestroyer( VkDestroyer<VkTypeWrapper> const & ) = delete;
     VkDestroyer& operator=( VkDestroyer<VkTypeWrapper> const & ) = delete;
 
   private:
+    static void Destroy( bool, VkTypeWrapper object ) {
+      DestroyVulkanObject<VkTypeWrapper>( object );
+    }
+
+    template<class VkParent>
+    static void Destroy( VkParent parent, VkTypeWrapper object ) {
+      DestroyVulkanObject<VkParent, VkTypeWrapper>( parent, object );
+    }
+
     VkTypeWrapper Object;
-    std::function<void( VkTypeWrapper )> DestroyerFunction;
+    VkParentType  Parent;
   };
 
   // Helper macro
@@ -185,21 +233,21 @@ namespace VulkanCookbook {
   // Helper functions
 
   inline void InitVkDestroyer( VkDestroyer<VkInstanceWrapper> & destroyer ) {
-    destroyer = VkDestroyer<VkInstanceWrapper>( std::bind( DestroyVulkanObject<VkInstanceWrapper>, std::placeholders::_1 ) );
+    destroyer = VkDestroyer<VkInstanceWrapper>( true );
   }
 
   inline void InitVkDestroyer( VkDestroyer<VkDeviceWrapper> & destroyer ) {
-    destroyer = VkDestroyer<VkDeviceWrapper>( std::bind( DestroyVulkanObject<VkDeviceWrapper>, std::placeholders::_1 ) );
+    destroyer = VkDestroyer<VkDeviceWrapper>( true );
   }
 
   template<class VkParent, class VkType>
   inline void InitVkDestroyer( VkParent const & parent, VkDestroyer<VkType> & destroyer ) {
-    destroyer = VkDestroyer<VkType>( std::bind( DestroyVulkanObject<VkParent, VkType>, parent, std::placeholders::_1 ) );
+    destroyer = VkDestroyer<VkType>( parent );
   }
 
   template<class VkParent, class VkType>
   inline void InitVkDestroyer( VkDestroyer<VkParent> const & parent, VkDestroyer<VkType> & destroyer ) {
-    destroyer = VkDestroyer<VkType>( std::bind( DestroyVulkanObject<decltype(VkParent::Handle), VkType>, *parent, std::placeholders::_1 ) );
+    destroyer = VkDestroyer<VkType>( *parent );
   }
 
 } // namespace VulkanCookbook
@@ -38,4 +38,7 @@ namespace VulkanCookbook {
 
 #include "ListOfVulkanFunctions.inl"
 
+  InstanceDispatch DefaultInstanceDispatch = {};
+  DeviceDispatch   DefaultDeviceDispatch = {};
+
 } // namespace VulkanCookbook
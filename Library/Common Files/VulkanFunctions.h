@@ -45,6 +45,30 @@ namespace VulkanCookbook {
 
 #include "ListOfVulkanFunctions.inl"
 
+  // Dispatch tables hold functions of a single instance or a single logical device, so many
+  // devices can be used in one process. Device-level functions are acquired directly from a
+  // driver, without going through a loader's trampoline.
+
+  struct InstanceDispatch {
+#define INSTANCE_LEVEL_VULKAN_FUNCTION( name ) PFN_##name name;
+#define INSTANCE_LEVEL_VULKAN_FUNCTION_FROM_EXTENSION( name, extension ) PFN_##name name;
+
+#include "ListOfVulkanFunctions.inl"
+  };
+
+  struct DeviceDispatch {
+#define DEVICE_LEVEL_VULKAN_FUNCTION( name ) PFN_##name name;
+#define DEVICE_LEVEL_VULKAN_FUNCTION_FROM_EXTENSION( name, extension ) PFN_##name name;
+
+#include "ListOfVulkanFunctions.inl"
+  };
+
+  // Tables filled by the loading functions which also set the global function pointers above
+  // (the global pointers are kept for code calling Vulkan functions directly)
+
+  extern InstanceDispatch DefaultInstanceDispatch;
+  extern DeviceDispatch   DefaultDeviceDispatch;
+
 } // namespace VulkanCookbook
 
 #endif // VULKAN_FUNCTIONS
\ No newline at end of file
@@ -32,10 +32,28 @@ namespace VulkanCookbook {
 
   bool LoadInstanceLevelFunctions( VkInstance                        instance,
                                    std::vector<char const *> const & enabled_extensions ) {
+    if( !LoadInstanceLevelFunctions( instance, enabled_extensions, DefaultInstanceDispatch ) ) {
+      return false;
+    }
+
+#define INSTANCE_LEVEL_VULKAN_FUNCTION( name ) name = DefaultInstanceDispatch.name;
+#define INSTANCE_LEVEL_VULKAN_FUNCTION_FROM_EXTENSION( name, extension ) name = DefaultInstanceDispatch.name;
+
+#include "ListOfVulkanFunctions.inl"
+
+    return true;
+  }
+
+  bool LoadInstanceLevelFunctions( VkInstance                        instance,
+                                   std::vector<char const *> const & enabled_extensions,
+                                   InstanceDispatch                  & dispatch ) {
+    // Functions from extensions which aren't enabled stay empty
+    dispatch = {};
+
     // Load core Vulkan API instance-level functions
 #define INSTANCE_LEVEL_VULKAN_FUNCTION( name )                                  \
-    name = (PFN_##name)vkGetInstanceProcAddr( instance, #name );                \
-    if( name == nullptr ) {                                                     \
+    dispatch.name = (PFN_##name)vkGetInstanceProcAddr( instance, #name );       \
+    if( dispatch.name == nullptr ) {                                            \
       std::cout << "Could not load instance-level Vulkan function named: "      \
         #name << std::endl;                                                     \
       return false;                                                             \
@@ -45,8 +63,8 @@ namespace VulkanCookbook {
 #define INSTANCE_LEVEL_VULKAN_FUNCTION_FROM_EXTENSION( name, extension )        \
     for( auto & enabled_extension : enabled_extensions ) {                      \
       if( std::string( enabled_extension ) == std::string( extension ) ) {      \
-        name = (PFN_##name)vkGetInstanceProcAddr( instance, #name );            \
-        if( name == nullptr ) {                                                 \
+        dispatch.name = (PFN_##name)vkGetInstanceProcAddr( instance, #name );   \
+        if( dispatch.name == nullptr ) {                                        \
           std::cout << "Could not load instance-level Vulkan function named: "  \
             #name << std::endl;                                                 \
           return false;                                                         \
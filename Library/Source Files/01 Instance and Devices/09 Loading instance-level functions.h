@@ -36,6 +36,12 @@ namespace VulkanCookbook {
   bool LoadInstanceLevelFunctions( VkInstance                        instance,
                                    std::vector<char const *> const & enabled_extensions );
 
+  // Functions of a given instance are loaded into a dispatch table instead of global function pointers
+
+  bool LoadInstanceLevelFunctions( VkInstance                        instance,
+                                   std::vector<char const *> const & enabled_extensions,
+                                   InstanceDispatch                  & dispatch );
+
 } // namespace VulkanCookbook
 
 #endif // LOADING_INSTANCE_LEVEL_FUNCTIONS
\ No newline at end of file
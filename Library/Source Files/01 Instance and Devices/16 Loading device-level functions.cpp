@@ -32,10 +32,28 @@ namespace VulkanCookbook {
 
   bool LoadDeviceLevelFunctions( VkDevice                          logical_device,
                                  std::vector<char const *> const & enabled_extensions ) {
+    if( !LoadDeviceLevelFunctions( logical_device, enabled_extensions, DefaultDeviceDispatch ) ) {
+      return false;
+    }
+
+#define DEVICE_LEVEL_VULKAN_FUNCTION( name ) name = DefaultDeviceDispatch.name;
+#define DEVICE_LEVEL_VULKAN_FUNCTION_FROM_EXTENSION( name, extension ) name = DefaultDeviceDispatch.name;
+
+#include "ListOfVulkanFunctions.inl"
+
+    return true;
+  }
+
+  bool LoadDeviceLevelFunctions( VkDevice                          logical_device,
+                                 std::vector<char const *> const & enabled_extensions,
+                                 DeviceDispatch                    & dispatch ) {
+    // Functions from extensions which aren't enabled stay empty
+    dispatch = {};
+
     // Load core Vulkan API device-level functions
 #define DEVICE_LEVEL_VULKAN_FUNCTION( name )                                    \
-    name = (PFN_##name)vkGetDeviceProcAddr( logical_device, #name );            \
-    if( name == nullptr ) {                                                     \
+    dispatch.name = (PFN_##name)vkGetDeviceProcAddr( logical_device, #name );   \
+    if( dispatch.name == nullptr ) {                                            \
       std::cout << "Could not load device-level Vulkan function named: "        \
         #name << std::endl;                                                     \
       return false;                                                             \
@@ -45,8 +63,8 @@ namespace VulkanCookbook {
 #define DEVICE_LEVEL_VULKAN_FUNCTION_FROM_EXTENSION( name, extension )          \
     for( auto & enabled_extension : enabled_extensions ) {                      \
       if( std::string( enabled_extension ) == std::string( extension ) ) {      \
-        name = (PFN_##name)vkGetDeviceProcAddr( logical_device, #name );        \
-        if( name == nullptr ) {                                                 \
+        dispatch.name = (PFN_##name)vkGetDeviceProcAddr( logical_device, #name ); \
+        if( dispatch.name == nullptr ) {                                        \
           std::cout << "Could not load device-level Vulkan function named: "    \
             #name << std::endl;                                                 \
           return false;                                                         \
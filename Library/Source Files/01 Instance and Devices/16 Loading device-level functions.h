@@ -36,6 +36,12 @@ namespace VulkanCookbook {
   bool LoadDeviceLevelFunctions( VkDevice                          logical_device,
                                  std::vector<char const *> const & enabled_extensions );
 
+  // Functions of a given logical device are loaded into a dispatch table instead of global function pointers
+
+  bool LoadDeviceLevelFunctions( VkDevice                          logical_device,
+                                 std::vector<char const *> const & enabled_extensions,
+                                 DeviceDispatch                    & dispatch );
+
 } // namespace VulkanCookbook
 
 #endif // LOADING_DEVICE_LEVEL_FUNCTIONS
\ No newline at end of file
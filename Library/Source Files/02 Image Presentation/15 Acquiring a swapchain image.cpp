@@ -35,9 +35,23 @@ namespace VulkanCookbook {
                               VkSemaphore      semaphore,
                               VkFence          fence,
                               uint32_t       & image_index ) {
+    return AcquireSwapchainImage( DefaultDeviceDispatch, logical_device, swapchain, semaphore, fence, image_index );
+  }
+
+  bool AcquireSwapchainImage( DeviceDispatch const & dispatch,
+                              VkDevice               logical_device,
+                              VkSwapchainKHR         swapchain,
+                              VkSemaphore            semaphore,
+                              VkFence                fence,
+                              uint32_t             & image_index ) {
+    if( VK_NULL_HANDLE == swapchain ) {
+      std::cout << "Could not acquire a swapchain image as there is no swapchain." << std::endl;
+      return false;
+    }
+
     VkResult result;
 
-    result = vkAcquireNextImageKHR( logical_device, swapchain, 2000000000, semaphore, fence, &image_index );
+    result = dispatch.vkAcquireNextImageKHR( logical_device, swapchain, 2000000000, semaphore, fence, &image_index );
     switch( result ) {
       case VK_SUCCESS:
       case VK_SUBOPTIMAL_KHR:
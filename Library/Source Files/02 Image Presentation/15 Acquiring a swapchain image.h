@@ -39,6 +39,13 @@ namespace VulkanCookbook {
                               VkFence          fence,
                               uint32_t       & image_index );
 
+  bool AcquireSwapchainImage( DeviceDispatch const & dispatch,
+                              VkDevice               logical_device,
+                              VkSwapchainKHR         swapchain,
+                              VkSemaphore            semaphore,
+                              VkFence                fence,
+                              uint32_t             & image_index );
+
 } // namespace VulkanCookbook
 
 #endif // ACQUIRING_A_SWAPCHAIN_IMAGE
\ No newline at end of file
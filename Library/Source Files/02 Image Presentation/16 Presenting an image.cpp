@@ -33,6 +33,13 @@ namespace VulkanCookbook {
   bool PresentImage( VkQueue                  queue,
                      std::vector<VkSemaphore> rendering_semaphores,
                      std::vector<PresentInfo> images_to_present ) {
+    return PresentImage( DefaultDeviceDispatch, queue, std::move( rendering_semaphores ), std::move( images_to_present ) );
+  }
+
+  bool PresentImage( DeviceDispatch const     & dispatch,
+                     VkQueue                    queue,
+                     std::vector<VkSemaphore>   rendering_semaphores,
+                     std::vector<PresentInfo>   images_to_present ) {
     VkResult result;
     std::vector<VkSwapchainKHR> swapchains;
     std::vector<uint32_t> image_indices;
@@ -53,7 +60,7 @@ namespace VulkanCookbook {
       nullptr                                               // VkResult*                pResults
     };
 
-    result = vkQueuePresentKHR( queue, &present_info );
+    result = dispatch.vkQueuePresentKHR( queue, &present_info );
     switch( result ) {
     case VK_SUCCESS:
       return true;
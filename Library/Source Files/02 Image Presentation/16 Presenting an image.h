@@ -42,6 +42,11 @@ namespace VulkanCookbook {
                      std::vector<VkSemaphore> rendering_semaphores,
                      std::vector<PresentInfo> images_to_present );
 
+  bool PresentImage( DeviceDispatch const     & dispatch,
+                     VkQueue                    queue,
+                     std::vector<VkSemaphore>   rendering_semaphores,
+                     std::vector<PresentInfo>   images_to_present );
+
 } // namespace VulkanCookbook
 
 #endif // PRESENTING_AN_IMAGE
\ No newline at end of file
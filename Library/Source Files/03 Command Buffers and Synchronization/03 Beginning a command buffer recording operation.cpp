@@ -33,6 +33,13 @@ namespace VulkanCookbook {
   bool BeginCommandBufferRecordingOperation( VkCommandBuffer                  command_buffer,
                                              VkCommandBufferUsageFlags        usage,
                                              VkCommandBufferInheritanceInfo * secondary_command_buffer_info ) {
+    return BeginCommandBufferRecordingOperation( DefaultDeviceDispatch, command_buffer, usage, secondary_command_buffer_info );
+  }
+
+  bool BeginCommandBufferRecordingOperation( DeviceDispatch const           & dispatch,
+                                             VkCommandBuffer                  command_buffer,
+                                             VkCommandBufferUsageFlags        usage,
+                                             VkCommandBufferInheritanceInfo * secondary_command_buffer_info ) {
     VkCommandBufferBeginInfo command_buffer_begin_info = {
       VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,    // VkStructureType                        sType
       nullptr,                                        // const void                           * pNext
@@ -40,7 +47,7 @@ namespace VulkanCookbook {
       secondary_command_buffer_info                   // const VkCommandBufferInheritanceInfo * pInheritanceInfo
     };
 
-    VkResult result = vkBeginCommandBuffer( command_buffer, &command_buffer_begin_info );
+    VkResult result = dispatch.vkBeginCommandBuffer( command_buffer, &command_buffer_begin_info );
     if( VK_SUCCESS != result ) {
       std::cout << "Could not begin command buffer recording operation." << std::endl;
       return false;
@@ -37,6 +37,11 @@ namespace VulkanCookbook {
                                              VkCommandBufferUsageFlags        usage,
                                              VkCommandBufferInheritanceInfo * secondary_command_buffer_info );
 
+  bool BeginCommandBufferRecordingOperation( DeviceDispatch const           & dispatch,
+                                             VkCommandBuffer                  command_buffer,
+                                             VkCommandBufferUsageFlags        usage,
+                                             VkCommandBufferInheritanceInfo * secondary_command_buffer_info );
+
 } // namespace VulkanCookbook
 
 #endif // BEGINNING_A_COMMAND_BUFFER_RECORDING_OPERATION
\ No newline at end of file
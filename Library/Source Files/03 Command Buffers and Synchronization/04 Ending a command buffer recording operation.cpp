@@ -31,7 +31,12 @@
 namespace VulkanCookbook {
 
   bool EndCommandBufferRecordingOperation( VkCommandBuffer command_buffer ) {
-    VkResult result = vkEndCommandBuffer( command_buffer );
+    return EndCommandBufferRecordingOperation( DefaultDeviceDispatch, command_buffer );
+  }
+
+  bool EndCommandBufferRecordingOperation( DeviceDispatch const & dispatch,
+                                           VkCommandBuffer        command_buffer ) {
+    VkResult result = dispatch.vkEndCommandBuffer( command_buffer );
     if( VK_SUCCESS != result ) {
       std::cout << "Error occurred during command buffer recording." << std::endl;
       return false;
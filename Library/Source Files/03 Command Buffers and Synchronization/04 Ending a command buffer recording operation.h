@@ -35,6 +35,9 @@ namespace VulkanCookbook {
 
   bool EndCommandBufferRecordingOperation( VkCommandBuffer command_buffer );
 
+  bool EndCommandBufferRecordingOperation( DeviceDispatch const & dispatch,
+                                           VkCommandBuffer        command_buffer );
+
 } // namespace VulkanCookbook
 
 #endif // ENDING_A_COMMAND_BUFFER_RECORDING_OPERATIONko
\ No newline at end of file
@@ -37,6 +37,11 @@ namespace VulkanCookbook {
                          VkCommandPool command_pool,
                          bool          release_resources );
 
+  bool ResetCommandPool( DeviceDispatch const & dispatch,
+                         VkDevice               logical_device,
+                         VkCommandPool          command_pool,
+                         bool                   release_resources );
+
 } // namespace VulkanCookbook
 
 #endif // RESETTING_A_COMMAND_POOL
\ No newline at end of file
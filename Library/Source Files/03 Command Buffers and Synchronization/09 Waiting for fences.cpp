@@ -34,8 +34,16 @@ namespace VulkanCookbook {
                       std::vector<VkFence> const & fences,
                       VkBool32                     wait_for_all,
                       uint64_t                     timeout ) {
+    return WaitForFences( DefaultDeviceDispatch, logical_device, fences, wait_for_all, timeout );
+  }
+
+  bool WaitForFences( DeviceDispatch const       & dispatch,
+                      VkDevice                     logical_device,
+                      std::vector<VkFence> const & fences,
+                      VkBool32                     wait_for_all,
+                      uint64_t                     timeout ) {
     if( fences.size() > 0 ) {
-      VkResult result = vkWaitForFences( logical_device, static_cast<uint32_t>(fences.size()), fences.data(), wait_for_all, timeout );
+      VkResult result = dispatch.vkWaitForFences( logical_device, static_cast<uint32_t>(fences.size()), fences.data(), wait_for_all, timeout );
       if( VK_SUCCESS != result ) {
         std::cout << "Waiting on fence failed." << std::endl;
         return false;
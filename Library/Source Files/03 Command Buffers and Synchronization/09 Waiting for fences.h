@@ -38,6 +38,12 @@ namespace VulkanCookbook {
                       VkBool32                     wait_for_all,
                       uint64_t                     timeout );
 
+  bool WaitForFences( DeviceDispatch const       & dispatch,
+                      VkDevice                     logical_device,
+                      std::vector<VkFence> const & fences,
+                      VkBool32                     wait_for_all,
+                      uint64_t                     timeout );
+
 } // namespace VulkanCookbook
 
 #endif // WAITING_FOR_FENCES
\ No newline at end of file
@@ -32,8 +32,14 @@ namespace VulkanCookbook {
 
   bool ResetFences( VkDevice                     logical_device,
                     std::vector<VkFence> const & fences ) {
+    return ResetFences( DefaultDeviceDispatch, logical_device, fences );
+  }
+
+  bool ResetFences( DeviceDispatch const       & dispatch,
+                    VkDevice                     logical_device,
+                    std::vector<VkFence> const & fences ) {
     if( fences.size() > 0 ) {
-      VkResult result = vkResetFences( logical_device, static_cast<uint32_t>(fences.size()), fences.data() );
+      VkResult result = dispatch.vkResetFences( logical_device, static_cast<uint32_t>(fences.size()), fences.data() );
       if( VK_SUCCESS != result ) {
         std::cout << "Error occurred when tried to reset fences." << std::endl;
         return false;
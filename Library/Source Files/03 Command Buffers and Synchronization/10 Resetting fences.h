@@ -36,6 +36,10 @@ namespace VulkanCookbook {
   bool ResetFences( VkDevice                     logical_device,
                     std::vector<VkFence> const & fences );
 
+  bool ResetFences( DeviceDispatch const       & dispatch,
+                    VkDevice                     logical_device,
+                    std::vector<VkFence> const & fences );
+
 } // namespace VulkanCookbook
 
 #endif // RESETTING_FENCES
\ No newline at end of file
@@ -35,6 +35,15 @@ namespace VulkanCookbook {
                                     std::vector<VkCommandBuffer>    command_buffers,
                                     std::vector<VkSemaphore>        signal_semaphores,
                                     VkFence                         fence ) {
+    return SubmitCommandBuffersToQueue( DefaultDeviceDispatch, queue, std::move( wait_semaphore_infos ), std::move( command_buffers ), std::move( signal_semaphores ), fence );
+  }
+
+  bool SubmitCommandBuffersToQueue( DeviceDispatch const           & dispatch,
+                                    VkQueue                          queue,
+                                    std::vector<WaitSemaphoreInfo>   wait_semaphore_infos,
+                                    std::vector<VkCommandBuffer>     command_buffers,
+                                    std::vector<VkSemaphore>         signal_semaphores,
+                                    VkFence                          fence ) {
     std::vector<VkSemaphore>          wait_semaphore_handles;
     std::vector<VkPipelineStageFlags> wait_semaphore_stages;
 
@@ -55,7 +64,7 @@ namespace VulkanCookbook {
       signal_semaphores.data()                              // const VkSemaphore            * pSignalSemaphores
     };
 
-    VkResult result = vkQueueSubmit( queue, 1, &submit_info, fence );
+    VkResult result = dispatch.vkQueueSubmit( queue, 1, &submit_info, fence );
     if( VK_SUCCESS != result ) {
       std::cout << "Error occurred during command buffer submission." << std::endl;
       return false;
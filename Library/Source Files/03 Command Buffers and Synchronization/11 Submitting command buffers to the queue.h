@@ -44,6 +44,13 @@ namespace VulkanCookbook {
                                     std::vector<VkSemaphore>        signal_semaphores,
                                     VkFence                         fence );
 
+  bool SubmitCommandBuffersToQueue( DeviceDispatch const           & dispatch,
+                                    VkQueue                          queue,
+                                    std::vector<WaitSemaphoreInfo>   wait_semaphore_infos,
+                                    std::vector<VkCommandBuffer>     command_buffers,
+                                    std::vector<VkSemaphore>         signal_semaphores,
+                                    VkFence                          fence );
+
 } // namespace VulkanCookbook
 
 #endif // SUBMITTING_A_COMMAND_BUFFER_TO_THE_QUEUE
\ No newline at end of file
@@ -0,0 +1,141 @@
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and / or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The below copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// Chapter: 03 Command Buffers and Synchronization
+// Recipe:  20 Using a ring of command pools
+
+#include "03 Command Buffers and Synchronization/01 Creating a command pool.h"
+#include "03 Command Buffers and Synchronization/02 Allocating command buffers.h"
+#include "03 Command Buffers and Synchronization/06 Resetting a command pool.h"
+#include "03 Command Buffers and Synchronization/20 Using a ring of command pools.h"
+
+namespace VulkanCookbook {
+
+  CommandPoolRing::CommandPoolRing() :
+    LogicalDevice( VK_NULL_HANDLE ),
+    ThreadsCount( 0 ),
+    FramesCount( 0 ) {
+  }
+
+  bool CommandPoolRing::Initialize( VkDevice  logical_device,
+                                    uint32_t  queue_family_index,
+                                    uint32_t  threads_count,
+                                    uint32_t  frames_count ) {
+    Destroy();
+
+    if( (0 == threads_count) ||
+        (0 == frames_count) ) {
+      std::cout << "Command pool ring requires at least one thread and one frame." << std::endl;
+      return false;
+    }
+
+    // Pools are stored frame by frame, so all pools of a single frame lie next to each other
+    Pools.resize( threads_count * frames_count );
+    for( auto & pool : Pools ) {
+      pool.UsedPrimaryCommandBuffers = 0;
+      pool.UsedSecondaryCommandBuffers = 0;
+      InitVkDestroyer( logical_device, pool.Handle );
+      if( !CreateCommandPool( logical_device, VK_COMMAND_POOL_CREATE_TRANSIENT_BIT, queue_family_index, *pool.Handle ) ) {
+        Pools.clear();
+        return false;
+      }
+    }
+
+    LogicalDevice = logical_device;
+    ThreadsCount = threads_count;
+    FramesCount = frames_count;
+    return true;
+  }
+
+  void CommandPoolRing::Destroy() {
+    // Command buffers are freed along with their pools
+    Pools.clear();
+    LogicalDevice = VK_NULL_HANDLE;
+    ThreadsCount = 0;
+    FramesCount = 0;
+  }
+
+  bool CommandPoolRing::Reset( uint32_t frame_index ) {
+    return Reset( DefaultDeviceDispatch, frame_index );
+  }
+
+  bool CommandPoolRing::Reset( DeviceDispatch const & dispatch,
+                               uint32_t               frame_index ) {
+    if( frame_index >= FramesCount ) {
+      std::cout << "Invalid frame index provided for a command pool ring." << std::endl;
+      return false;
+    }
+
+    for( uint32_t thread_index = 0; thread_index < ThreadsCount; ++thread_index ) {
+      Pool & pool = Pools[frame_index * ThreadsCount + thread_index];
+      if( (0 == pool.UsedPrimaryCommandBuffers) &&
+          (0 == pool.UsedSecondaryCommandBuffers) ) {
+        continue;
+      }
+      // Command buffers stay allocated, so they can be handed out again without calling the driver
+      if( !ResetCommandPool( dispatch, LogicalDevice, *pool.Handle, false ) ) {
+        return false;
+      }
+      pool.UsedPrimaryCommandBuffers = 0;
+      pool.UsedSecondaryCommandBuffers = 0;
+    }
+    return true;
+  }
+
+  bool CommandPoolRing::AllocateCommandBuffer( uint32_t               thread_index,
+                                               uint32_t               frame_index,
+                                               VkCommandBufferLevel   level,
+                                               VkCommandBuffer      & command_buffer ) {
+    if( (thread_index >= ThreadsCount) ||
+        (frame_index >= FramesCount) ) {
+      std::cout << "Invalid thread or frame index provided for a command pool ring." << std::endl;
+      return false;
+    }
+
+    Pool & pool = Pools[frame_index * ThreadsCount + thread_index];
+    bool primary = VK_COMMAND_BUFFER_LEVEL_PRIMARY == level;
+    std::vector<VkCommandBuffer> & command_buffers = primary ? pool.PrimaryCommandBuffers : pool.SecondaryCommandBuffers;
+    size_t & used_command_buffers = primary ? pool.UsedPrimaryCommandBuffers : pool.UsedSecondaryCommandBuffers;
+
+    if( used_command_buffers == command_buffers.size() ) {
+      std::vector<VkCommandBuffer> new_command_buffers;
+      if( !AllocateCommandBuffers( LogicalDevice, *pool.Handle, level, 1, new_command_buffers ) ) {
+        return false;
+      }
+      command_buffers.push_back( new_command_buffers[0] );
+    }
+    command_buffer = command_buffers[used_command_buffers++];
+    return true;
+  }
+
+  uint32_t CommandPoolRing::GetThreadsCount() const {
+    return ThreadsCount;
+  }
+
+  uint32_t CommandPoolRing::GetFramesCount() const {
+    return FramesCount;
+  }
+
+} // namespace VulkanCookbook
@@ -0,0 +1,77 @@
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and / or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The below copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// Chapter: 03 Command Buffers and Synchronization
+// Recipe:  20 Using a ring of command pools
+
+#ifndef USING_A_RING_OF_COMMAND_POOLS
+#define USING_A_RING_OF_COMMAND_POOLS
+
+#include "Common.h"
+
+namespace VulkanCookbook {
+
+  // Separate transient command pool for each thread and each frame in flight.
+  // Command buffers are handed out linearly from a pool and are never reset individually -
+  // all pools of a given frame are reset at once, when the frame's fence is signaled.
+  // Pools of a given frame and thread may be accessed only from that thread, so no locks are required.
+
+  class CommandPoolRing {
+  public:
+    CommandPoolRing();
+
+    bool      Initialize( VkDevice  logical_device,
+                          uint32_t  queue_family_index,
+                          uint32_t  threads_count,
+                          uint32_t  frames_count );
+    void      Destroy();
+    bool      Reset( uint32_t frame_index );
+    bool      Reset( DeviceDispatch const & dispatch,
+                     uint32_t               frame_index );
+    bool      AllocateCommandBuffer( uint32_t               thread_index,
+                                     uint32_t               frame_index,
+                                     VkCommandBufferLevel   level,
+                                     VkCommandBuffer      & command_buffer );
+    uint32_t  GetThreadsCount() const;
+    uint32_t  GetFramesCount() const;
+
+  private:
+    struct Pool {
+      VkDestroyer(VkCommandPool)    Handle;
+      std::vector<VkCommandBuffer>  PrimaryCommandBuffers;
+      size_t                        UsedPrimaryCommandBuffers;
+      std::vector<VkCommandBuffer>  SecondaryCommandBuffers;
+      size_t                        UsedSecondaryCommandBuffers;
+    };
+
+    VkDevice           LogicalDevice;
+    uint32_t           ThreadsCount;
+    uint32_t           FramesCount;
+    std::vector<Pool>  Pools;
+  };
+
+} // namespace VulkanCookbook
+
+#endif // USING_A_RING_OF_COMMAND_POOLS
@@ -0,0 +1,72 @@
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and / or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The below copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// Chapter: 03 Command Buffers and Synchronization
+// Recipe:  21 Deferring destruction of objects used by frames in flight
+
+#include "03 Command Buffers and Synchronization/21 Deferring destruction of objects used by frames in flight.h"
+
+namespace VulkanCookbook {
+
+  DeferredDestructionQueue::DeferredDestructionQueue() :
+    FrameNumber( 0 ),
+    RetiredObjectsCount( 0 ),
+    DestroyedObjectsCount( 0 ) {
+  }
+
+  DeferredDestructionQueue::~DeferredDestructionQueue() {
+    DestroyRetiredObjects();
+  }
+
+  void DeferredDestructionQueue::BeginFrame( uint64_t frame_number,
+                                             uint64_t finished_frames_count ) {
+    // Objects are stored in the order of retirement, so frame numbers never decrease
+    while( !Objects.empty() &&
+           (Objects.front().FrameNumber < finished_frames_count) ) {
+      Objects.front().Destroy( Objects.front().LogicalDevice, Objects.front().Handle );
+      Objects.pop_front();
+      ++DestroyedObjectsCount;
+    }
+    FrameNumber = frame_number;
+  }
+
+  void DeferredDestructionQueue::DestroyRetiredObjects() {
+    // Should be called only when the device doesn't use any of the retired objects, for example after it is idle
+    for( auto & object : Objects ) {
+      object.Destroy( object.LogicalDevice, object.Handle );
+      ++DestroyedObjectsCount;
+    }
+    Objects.clear();
+  }
+
+  DeferredDestructionStatistics DeferredDestructionQueue::GetStatistics() const {
+    return {
+      RetiredObjectsCount,                      // uint64_t   RetiredObjects
+      DestroyedObjectsCount,                    // uint64_t   DestroyedObjects
+      static_cast<uint32_t>(Objects.size())     // uint32_t   PendingObjects
+    };
+  }
+
+} // namespace VulkanCookbook
@@ -0,0 +1,139 @@
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and / or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The below copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// Chapter: 03 Command Buffers and Synchronization
+// Recipe:  21 Deferring destruction of objects used by frames in flight
+
+#ifndef DEFERRING_DESTRUCTION_OF_OBJECTS_USED_BY_FRAMES_IN_FLIGHT
+#define DEFERRING_DESTRUCTION_OF_OBJECTS_USED_BY_FRAMES_IN_FLIGHT
+
+#include <deque>
+#include <type_traits>
+#include "Common.h"
+
+namespace VulkanCookbook {
+
+  struct DeferredDestructionStatistics {
+    uint64_t  RetiredObjects;
+    uint64_t  DestroyedObjects;
+    uint32_t  PendingObjects;
+  };
+
+  // Objects which may still be used by frames in flight are not destroyed immediately. They are tagged with
+  // the number of the frame during which they were retired and destroyed only when that frame is finished
+  // (when its fence is signaled), so recreating or streaming resources doesn't require waiting for the whole device.
+
+  class DeferredDestructionQueue {
+  public:
+    DeferredDestructionQueue();
+    ~DeferredDestructionQueue();
+
+    template<class VkTypeWrapper>
+    void  Retire( VkDestroyer<VkTypeWrapper> && destroyer );
+    template<class VkTypeWrapper>
+    void  Retire( std::vector<VkDestroyer<VkTypeWrapper>> & destroyers );
+    void  BeginFrame( uint64_t frame_number,
+                      uint64_t finished_frames_count );
+    void  DestroyRetiredObjects();
+
+    DeferredDestructionStatistics GetStatistics() const;
+
+  private:
+    struct RetiredObject {
+      uint64_t  FrameNumber;
+      VkDevice  LogicalDevice;
+      uint64_t  Handle;
+      void   (* Destroy)( VkDevice, uint64_t );
+    };
+
+    template<class VkTypeWrapper>
+    static void  DestroyObject( VkDevice logical_device,
+                                uint64_t handle );
+
+    std::deque<RetiredObject>  Objects;
+    uint64_t                   FrameNumber;
+    uint64_t                   RetiredObjectsCount;
+    uint64_t                   DestroyedObjectsCount;
+  };
+
+  template<class VkTypeWrapper>
+  void DeferredDestructionQueue::Retire( VkDestroyer<VkTypeWrapper> && destroyer ) {
+    static_assert( std::is_same<typename VkDestroyer<VkTypeWrapper>::VkParentType, VkDevice>::value, "Only objects created from a logical device can be retired." );
+
+    VkDevice logical_device = destroyer.GetParent();
+    auto handle = destroyer.Release();
+    // Objects which weren't supposed to be destroyed by a destroyer aren't destroyed by the queue either
+    if( (VK_NULL_HANDLE == logical_device) ||
+        (VK_NULL_HANDLE == handle) ) {
+      return;
+    }
+
+    RetiredObject object = {
+      FrameNumber,                    // uint64_t   FrameNumber
+      logical_device,                 // VkDevice   LogicalDevice
+      0,                              // uint64_t   Handle
+      DestroyObject<VkTypeWrapper>    // void    (* Destroy)( VkDevice, uint64_t )
+    };
+    std::memcpy( &object.Handle, &handle, sizeof( handle ) );
+    Objects.push_back( object );
+    ++RetiredObjectsCount;
+  }
+
+  template<class VkTypeWrapper>
+  void DeferredDestructionQueue::Retire( std::vector<VkDestroyer<VkTypeWrapper>> & destroyers ) {
+    for( auto & destroyer : destroyers ) {
+      Retire( std::move( destroyer ) );
+    }
+    destroyers.clear();
+  }
+
+  template<class VkTypeWrapper>
+  void DeferredDestructionQueue::DestroyObject( VkDevice logical_device,
+                                                uint64_t handle ) {
+    VkTypeWrapper object;
+    std::memcpy( &object.Handle, &handle, sizeof( object.Handle ) );
+    DestroyVulkanObject<VkDevice, VkTypeWrapper>( logical_device, object );
+  }
+
+  // Works like InitVkDestroyer(), but an object held by the destroyer is handed over to the queue instead of being destroyed
+
+  template<class VkType>
+  void InitVkDestroyer( VkDevice                   logical_device,
+                        VkDestroyer<VkType>      & destroyer,
+                        DeferredDestructionQueue & deferred_destruction_queue ) {
+    deferred_destruction_queue.Retire( std::move( destroyer ) );
+    InitVkDestroyer( logical_device, destroyer );
+  }
+
+  template<class VkType>
+  void InitVkDestroyer( VkDestroyer<VkDeviceWrapper> const & logical_device,
+                        VkDestroyer<VkType>                & destroyer,
+                        DeferredDestructionQueue           & deferred_destruction_queue ) {
+    InitVkDestroyer( *logical_device, destroyer, deferred_destruction_queue );
+  }
+
+} // namespace VulkanCookbook
+
+#endif // DEFERRING_DESTRUCTION_OF_OBJECTS_USED_BY_FRAMES_IN_FLIGHT
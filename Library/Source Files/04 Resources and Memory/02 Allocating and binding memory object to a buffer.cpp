@@ -73,4 +73,26 @@ namespace VulkanCookbook {
     return true;
   }
 
+  bool AllocateAndBindMemoryObjectToBuffer( VkDevice                   logical_device,
+                                            VkBuffer                   buffer,
+                                            VkMemoryPropertyFlagBits   memory_properties,
+                                            MemoryAllocator          & allocator,
+                                            MemoryAllocation         & allocation ) {
+    VkMemoryRequirements memory_requirements;
+    vkGetBufferMemoryRequirements( logical_device, buffer, &memory_requirements );
+
+    if( !allocator.Allocate( memory_requirements, memory_properties, true, allocation ) ) {
+      std::cout << "Could not allocate memory for a buffer." << std::endl;
+      return false;
+    }
+
+    VkResult result = vkBindBufferMemory( logical_device, buffer, allocation.Memory, allocation.Offset );
+    if( VK_SUCCESS != result ) {
+      std::cout << "Could not bind memory object to a buffer." << std::endl;
+      allocator.Free( allocation );
+      return false;
+    }
+    return true;
+  }
+
 } // namespace VulkanCookbook
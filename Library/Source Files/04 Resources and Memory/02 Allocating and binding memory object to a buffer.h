@@ -29,6 +29,7 @@
 #ifndef ALLOCATING_AND_BINDING_MEMORY_OBJECT_TO_A_BUFFER
 #define ALLOCATING_AND_BINDING_MEMORY_OBJECT_TO_A_BUFFER
 
+#include "04 Resources and Memory/22 Sub-allocating memory objects from larger memory blocks.h"
 #include "Common.h"
 
 namespace VulkanCookbook {
@@ -39,6 +40,12 @@ namespace VulkanCookbook {
                                             VkMemoryPropertyFlagBits   memory_properties,
                                             VkDeviceMemory           & memory_object );
 
+  bool AllocateAndBindMemoryObjectToBuffer( VkDevice                   logical_device,
+                                            VkBuffer                   buffer,
+                                            VkMemoryPropertyFlagBits   memory_properties,
+                                            MemoryAllocator          & allocator,
+                                            MemoryAllocation         & allocation );
+
 } // namespace VulkanCookbook
 
 #endif // ALLOCATING_AND_BINDING_MEMORY_OBJECT_TO_A_BUFFER
\ No newline at end of file
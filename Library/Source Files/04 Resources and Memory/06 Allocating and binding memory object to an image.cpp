@@ -73,4 +73,26 @@ namespace VulkanCookbook {
     return true;
   }
 
+  bool AllocateAndBindMemoryObjectToImage( VkDevice                   logical_device,
+                                           VkImage                    image,
+                                           VkMemoryPropertyFlagBits   memory_properties,
+                                           MemoryAllocator          & allocator,
+                                           MemoryAllocation         & allocation ) {
+    VkMemoryRequirements memory_requirements;
+    vkGetImageMemoryRequirements( logical_device, image, &memory_requirements );
+
+    if( !allocator.Allocate( memory_requirements, memory_properties, false, allocation ) ) {
+      std::cout << "Could not allocate memory for an image." << std::endl;
+      return false;
+    }
+
+    VkResult result = vkBindImageMemory( logical_device, image, allocation.Memory, allocation.Offset );
+    if( VK_SUCCESS != result ) {
+      std::cout << "Could not bind memory object to an image." << std::endl;
+      allocator.Free( allocation );
+      return false;
+    }
+    return true;
+  }
+
 } // namespace VulkanCookbook
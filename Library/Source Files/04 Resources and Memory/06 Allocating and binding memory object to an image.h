@@ -29,6 +29,7 @@
 #ifndef ALLOCATING_AND_BINDING_MEMORY_OBJECT_TO_AN_IMAGE
 #define ALLOCATING_AND_BINDING_MEMORY_OBJECT_TO_AN_IMAGE
 
+#include "04 Resources and Memory/22 Sub-allocating memory objects from larger memory blocks.h"
 #include "Common.h"
 
 namespace VulkanCookbook {
@@ -39,6 +40,12 @@ namespace VulkanCookbook {
                                            VkMemoryPropertyFlagBits   memory_properties,
                                            VkDeviceMemory           & memory_object );
 
+  bool AllocateAndBindMemoryObjectToImage( VkDevice                   logical_device,
+                                           VkImage                    image,
+                                           VkMemoryPropertyFlagBits   memory_properties,
+                                           MemoryAllocator          & allocator,
+                                           MemoryAllocation         & allocation );
+
 } // namespace VulkanCookbook
 
 #endif // ALLOCATING_AND_BINDING_MEMORY_OBJECT_TO_AN_IMAGE
\ No newline at end of file
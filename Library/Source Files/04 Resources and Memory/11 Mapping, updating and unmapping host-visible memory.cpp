@@ -57,7 +57,7 @@ namespace VulkanCookbook {
       }
     };
 
-    vkFlushMappedMemoryRanges( logical_device, static_cast<uint32_t>(memory_ranges.size()), memory_ranges.data() );
+    result = vkFlushMappedMemoryRanges( logical_device, static_cast<uint32_t>(memory_ranges.size()), memory_ranges.data() );
     if( VK_SUCCESS != result ) {
       std::cout << "Could not flush mapped memory." << std::endl;
       return false;
@@ -0,0 +1,263 @@
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and / or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The below copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// Chapter: 04 Resources and Memory
+// Recipe:  22 Sub-allocating memory objects from larger memory blocks
+
+#include "04 Resources and Memory/22 Sub-allocating memory objects from larger memory blocks.h"
+
+namespace VulkanCookbook {
+
+  namespace {
+
+    VkDeviceSize AlignUp( VkDeviceSize value,
+                          VkDeviceSize alignment ) {
+      if( 1 >= alignment ) {
+        return value;
+      }
+      return (value + alignment - 1) / alignment * alignment;
+    }
+
+  }
+
+  MemoryAllocator::MemoryAllocator() :
+    LogicalDevice( VK_NULL_HANDLE ),
+    MemoryProperties(),
+    BufferImageGranularity( 1 ),
+    BlockSize( 0 ) {
+  }
+
+  MemoryAllocator::~MemoryAllocator() {
+    Destroy();
+  }
+
+  bool MemoryAllocator::Initialize( VkPhysicalDevice  physical_device,
+                                    VkDevice          logical_device,
+                                    VkDeviceSize      block_size ) {
+    Destroy();
+
+    if( 0 == block_size ) {
+      std::cout << "Memory allocator block size must be greater than zero." << std::endl;
+      return false;
+    }
+
+    VkPhysicalDeviceProperties device_properties;
+    vkGetPhysicalDeviceProperties( physical_device, &device_properties );
+    vkGetPhysicalDeviceMemoryProperties( physical_device, &MemoryProperties );
+
+    std::lock_guard<std::mutex> lock( Mutex );
+    LogicalDevice = logical_device;
+    BufferImageGranularity = device_properties.limits.bufferImageGranularity;
+    BlockSize = block_size;
+    return true;
+  }
+
+  bool MemoryAllocator::Allocate( VkMemoryRequirements const & memory_requirements,
+                                  VkMemoryPropertyFlags        memory_properties,
+                                  bool                         linear,
+                                  MemoryAllocation           & allocation ) {
+    std::lock_guard<std::mutex> lock( Mutex );
+
+    allocation = {};
+    if( VK_NULL_HANDLE == LogicalDevice ) {
+      std::cout << "Memory allocator is not initialized." << std::endl;
+      return false;
+    }
+
+    // When granularity is not greater than any alignment, linear and non-linear resources may share blocks
+    if( 1 >= BufferImageGranularity ) {
+      linear = true;
+    }
+
+    // Resources bigger than half of a block get their own, dedicated memory object
+    bool dedicated = memory_requirements.size > BlockSize / 2;
+
+    for( uint32_t type = 0; type < MemoryProperties.memoryTypeCount; ++type ) {
+      if( (memory_requirements.memoryTypeBits & (1 << type)) &&
+          ((MemoryProperties.memoryTypes[type].propertyFlags & memory_properties) == memory_properties) ) {
+
+        if( !dedicated ) {
+          for( auto & block : Blocks ) {
+            if( (block.MemoryTypeIndex == type) &&
+                (block.Linear == linear) &&
+                (!block.Dedicated) &&
+                AllocateFromBlock( block, memory_requirements, allocation ) ) {
+              return true;
+            }
+          }
+        }
+
+        if( AllocateBlock( type, dedicated ? memory_requirements.size : BlockSize, linear, dedicated ) &&
+            AllocateFromBlock( Blocks.back(), memory_requirements, allocation ) ) {
+          return true;
+        }
+      }
+    }
+
+    std::cout << "Could not sub-allocate memory of " << memory_requirements.size << " bytes." << std::endl;
+    return false;
+  }
+
+  void MemoryAllocator::Free( MemoryAllocation & allocation ) {
+    std::lock_guard<std::mutex> lock( Mutex );
+
+    if( VK_NULL_HANDLE == allocation.Memory ) {
+      return;
+    }
+
+    for( size_t i = 0; i < Blocks.size(); ++i ) {
+      Block & block = Blocks[i];
+      if( block.Memory != allocation.Memory ) {
+        continue;
+      }
+
+      // Insert the range back, keeping free ranges sorted by offset, and merge it with its neighbours
+      auto next = block.FreeRanges.begin();
+      while( (next != block.FreeRanges.end()) &&
+             (next->Offset < allocation.Offset) ) {
+        ++next;
+      }
+      next = block.FreeRanges.insert( next, { allocation.Offset, allocation.Size } );
+
+      if( ((next + 1) != block.FreeRanges.end()) &&
+          (next->Offset + next->Size == (next + 1)->Offset) ) {
+        next->Size += (next + 1)->Size;
+        block.FreeRanges.erase( next + 1 );
+      }
+      if( (next != block.FreeRanges.begin()) &&
+          ((next - 1)->Offset + (next - 1)->Size == next->Offset) ) {
+        (next - 1)->Size += next->Size;
+        block.FreeRanges.erase( next );
+      }
+
+      --block.AllocationCount;
+      // Dedicated blocks are released immediately, regular blocks are kept for reuse
+      if( block.Dedicated &&
+          (0 == block.AllocationCount) ) {
+        vkFreeMemory( LogicalDevice, block.Memory, nullptr );
+        Blocks.erase( Blocks.begin() + i );
+      }
+      break;
+    }
+
+    allocation = {};
+  }
+
+  void MemoryAllocator::Destroy() {
+    std::lock_guard<std::mutex> lock( Mutex );
+
+    for( auto & block : Blocks ) {
+      vkFreeMemory( LogicalDevice, block.Memory, nullptr );
+    }
+    Blocks.clear();
+  }
+
+  MemoryAllocatorStatistics MemoryAllocator::GetStatistics() const {
+    std::lock_guard<std::mutex> lock( Mutex );
+
+    MemoryAllocatorStatistics statistics = {};
+    statistics.BlockCount = static_cast<uint32_t>(Blocks.size());
+    for( auto & block : Blocks ) {
+      VkDeviceSize free_bytes = 0;
+      for( auto & range : block.FreeRanges ) {
+        free_bytes += range.Size;
+        if( range.Size > statistics.LargestFreeRange ) {
+          statistics.LargestFreeRange = range.Size;
+        }
+      }
+      statistics.AllocationCount += block.AllocationCount;
+      statistics.FreeRangeCount += static_cast<uint32_t>(block.FreeRanges.size());
+      statistics.ReservedBytes += block.Size;
+      statistics.UsedBytes += block.Size - free_bytes;
+    }
+    return statistics;
+  }
+
+  bool MemoryAllocator::AllocateFromBlock( Block                      & block,
+                                           VkMemoryRequirements const & memory_requirements,
+                                           MemoryAllocation           & allocation ) {
+    // First fit - the front of a chosen range may be left free because of alignment padding
+    for( auto range = block.FreeRanges.begin(); range != block.FreeRanges.end(); ++range ) {
+      VkDeviceSize offset = AlignUp( range->Offset, memory_requirements.alignment );
+      VkDeviceSize padding = offset - range->Offset;
+      if( padding + memory_requirements.size > range->Size ) {
+        continue;
+      }
+
+      VkDeviceSize remaining = range->Size - padding - memory_requirements.size;
+      if( 0 < padding ) {
+        range->Size = padding;
+        if( 0 < remaining ) {
+          block.FreeRanges.insert( range + 1, { offset + memory_requirements.size, remaining } );
+        }
+      } else if( 0 < remaining ) {
+        range->Offset = offset + memory_requirements.size;
+        range->Size = remaining;
+      } else {
+        block.FreeRanges.erase( range );
+      }
+
+      ++block.AllocationCount;
+      allocation = {
+        block.Memory,               // VkDeviceMemory   Memory
+        offset,                     // VkDeviceSize     Offset
+        memory_requirements.size,   // VkDeviceSize     Size
+        block.MemoryTypeIndex       // uint32_t         MemoryTypeIndex
+      };
+      return true;
+    }
+    return false;
+  }
+
+  bool MemoryAllocator::AllocateBlock( uint32_t       memory_type_index,
+                                       VkDeviceSize   size,
+                                       bool           linear,
+                                       bool           dedicated ) {
+    VkMemoryAllocateInfo memory_allocate_info = {
+      VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,   // VkStructureType    sType
+      nullptr,                                  // const void       * pNext
+      size,                                     // VkDeviceSize       allocationSize
+      memory_type_index                         // uint32_t           memoryTypeIndex
+    };
+
+    VkDeviceMemory memory_object;
+    VkResult result = vkAllocateMemory( LogicalDevice, &memory_allocate_info, nullptr, &memory_object );
+    if( VK_SUCCESS != result ) {
+      return false;
+    }
+
+    Blocks.push_back( {
+      memory_object,          // VkDeviceMemory       Memory
+      size,                   // VkDeviceSize         Size
+      memory_type_index,      // uint32_t             MemoryTypeIndex
+      linear,                 // bool                 Linear
+      dedicated,              // bool                 Dedicated
+      0,                      // uint32_t             AllocationCount
+      { { 0, size } }         // std::vector<Range>   FreeRanges
+    } );
+    return true;
+  }
+
+} // namespace VulkanCookbook
@@ -0,0 +1,111 @@
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and / or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The below copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// Chapter: 04 Resources and Memory
+// Recipe:  22 Sub-allocating memory objects from larger memory blocks
+
+#ifndef SUB_ALLOCATING_MEMORY_OBJECTS_FROM_LARGER_MEMORY_BLOCKS
+#define SUB_ALLOCATING_MEMORY_OBJECTS_FROM_LARGER_MEMORY_BLOCKS
+
+#include <mutex>
+#include "Common.h"
+
+namespace VulkanCookbook {
+
+  struct MemoryAllocation {
+    VkDeviceMemory  Memory;
+    VkDeviceSize    Offset;
+    VkDeviceSize    Size;
+    uint32_t        MemoryTypeIndex;
+  };
+
+  struct MemoryAllocatorStatistics {
+    uint32_t        BlockCount;
+    uint32_t        AllocationCount;
+    uint32_t        FreeRangeCount;
+    VkDeviceSize    ReservedBytes;
+    VkDeviceSize    UsedBytes;
+    VkDeviceSize    LargestFreeRange;
+  };
+
+  // Grabs large memory blocks per memory type and sub-allocates resources from them.
+  // Linear (buffers) and non-linear (optimally tiled images) resources never share a block,
+  // so bufferImageGranularity doesn't need to be tracked between neighbouring ranges.
+
+  class MemoryAllocator {
+  public:
+    MemoryAllocator();
+    ~MemoryAllocator();
+
+    bool  Initialize( VkPhysicalDevice  physical_device,
+                      VkDevice          logical_device,
+                      VkDeviceSize      block_size = 64 * 1024 * 1024 );
+    bool  Allocate( VkMemoryRequirements const & memory_requirements,
+                    VkMemoryPropertyFlags        memory_properties,
+                    bool                         linear,
+                    MemoryAllocation           & allocation );
+    void  Free( MemoryAllocation & allocation );
+    void  Destroy();
+
+    MemoryAllocatorStatistics GetStatistics() const;
+
+    MemoryAllocator( MemoryAllocator const & ) = delete;
+    MemoryAllocator& operator=( MemoryAllocator const & ) = delete;
+
+  private:
+    struct Range {
+      VkDeviceSize  Offset;
+      VkDeviceSize  Size;
+    };
+
+    struct Block {
+      VkDeviceMemory      Memory;
+      VkDeviceSize        Size;
+      uint32_t            MemoryTypeIndex;
+      bool                Linear;
+      bool                Dedicated;
+      uint32_t            AllocationCount;
+      std::vector<Range>  FreeRanges;
+    };
+
+    bool  AllocateFromBlock( Block                      & block,
+                             VkMemoryRequirements const & memory_requirements,
+                             MemoryAllocation           & allocation );
+    bool  AllocateBlock( uint32_t       memory_type_index,
+                         VkDeviceSize   size,
+                         bool           linear,
+                         bool           dedicated );
+
+    VkDevice                          LogicalDevice;
+    VkPhysicalDeviceMemoryProperties  MemoryProperties;
+    VkDeviceSize                      BufferImageGranularity;
+    VkDeviceSize                      BlockSize;
+    std::vector<Block>                Blocks;
+    mutable std::mutex                Mutex;
+  };
+
+} // namespace VulkanCookbook
+
+#endif // SUB_ALLOCATING_MEMORY_OBJECTS_FROM_LARGER_MEMORY_BLOCKS
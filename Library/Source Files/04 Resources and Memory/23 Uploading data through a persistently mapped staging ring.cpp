@@ -0,0 +1,519 @@
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and / or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The below copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// Chapter: 04 Resources and Memory
+// Recipe:  23 Uploading data through a persistently mapped staging ring
+
+#include "01 Instance and Devices/12 Getting features and properties of a physical device.h"
+#include "03 Command Buffers and Synchronization/01 Creating a command pool.h"
+#include "03 Command Buffers and Synchronization/02 Allocating command buffers.h"
+#include "03 Command Buffers and Synchronization/03 Beginning a command buffer recording operation.h"
+#include "03 Command Buffers and Synchronization/04 Ending a command buffer recording operation.h"
+#include "03 Command Buffers and Synchronization/06 Resetting a command pool.h"
+#include "03 Command Buffers and Synchronization/08 Creating a fence.h"
+#include "03 Command Buffers and Synchronization/09 Waiting for fences.h"
+#include "03 Command Buffers and Synchronization/10 Resetting fences.h"
+#include "03 Command Buffers and Synchronization/11 Submitting command buffers to the queue.h"
+#include "04 Resources and Memory/01 Creating a buffer.h"
+#include "04 Resources and Memory/02 Allocating and binding memory object to a buffer.h"
+#include "04 Resources and Memory/12 Copying data between buffers.h"
+#include "04 Resources and Memory/13 Copying data from a buffer to an image.h"
+#include "04 Resources and Memory/23 Uploading data through a persistently mapped staging ring.h"
+
+namespace VulkanCookbook {
+
+  StagingUploader::StagingUploader() :
+    LogicalDevice( VK_NULL_HANDLE ),
+    Queue( VK_NULL_HANDLE ),
+    MappedData( nullptr ),
+    Size( 0 ),
+    Alignment( 16 ),
+    Head( 0 ),
+    Tail( 0 ),
+    NextSubmission( 0 ),
+    NextTicket( 1 ),
+    FinishedTicket( 0 ),
+    PendingGeneratingStages( 0 ),
+    PendingConsumingStages( 0 ),
+    Statistics() {
+  }
+
+  StagingUploader::~StagingUploader() {
+    Destroy();
+  }
+
+  bool StagingUploader::Initialize( VkPhysicalDevice  physical_device,
+                                    VkDevice          logical_device,
+                                    VkQueue           queue,
+                                    uint32_t          queue_family_index,
+                                    VkDeviceSize      ring_size,
+                                    uint32_t          max_submissions_in_flight ) {
+    Destroy();
+
+    if( (0 == ring_size) ||
+        (0 == max_submissions_in_flight) ) {
+      std::cout << "Staging ring requires non-zero size and at least one submission in flight." << std::endl;
+      return false;
+    }
+
+    // Offsets of buffer-to-image copies must be multiples of 4 and of the texel size
+    VkPhysicalDeviceFeatures   device_features;
+    VkPhysicalDeviceProperties device_properties;
+    GetFeaturesAndPropertiesOfPhysicalDevice( physical_device, device_features, device_properties );
+    Alignment = device_properties.limits.optimalBufferCopyOffsetAlignment > 16 ? device_properties.limits.optimalBufferCopyOffsetAlignment : 16;
+
+    InitVkDestroyer( logical_device, Buffer );
+    if( !CreateBuffer( logical_device, ring_size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, *Buffer ) ) {
+      return false;
+    }
+
+    // Coherent memory doesn't need explicit flushes after data is written
+    InitVkDestroyer( logical_device, Memory );
+    if( !AllocateAndBindMemoryObjectToBuffer( physical_device, logical_device, *Buffer,
+      static_cast<VkMemoryPropertyFlagBits>(VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT), *Memory ) ) {
+      Buffer = VkDestroyer(VkBuffer)();
+      return false;
+    }
+
+    void * mapped_data;
+    VkResult result = vkMapMemory( logical_device, *Memory, 0, VK_WHOLE_SIZE, 0, &mapped_data );
+    if( VK_SUCCESS != result ) {
+      std::cout << "Could not map memory object of a staging ring." << std::endl;
+      Memory = VkDestroyer(VkDeviceMemory)();
+      Buffer = VkDestroyer(VkBuffer)();
+      return false;
+    }
+
+    Submissions.resize( max_submissions_in_flight );
+    for( auto & submission : Submissions ) {
+      InitVkDestroyer( logical_device, submission.CommandPool );
+      InitVkDestroyer( logical_device, submission.Fence );
+      std::vector<VkCommandBuffer> command_buffers;
+      if( !CreateCommandPool( logical_device, VK_COMMAND_POOL_CREATE_TRANSIENT_BIT, queue_family_index, *submission.CommandPool ) ||
+          !AllocateCommandBuffers( logical_device, *submission.CommandPool, VK_COMMAND_BUFFER_LEVEL_PRIMARY, 1, command_buffers ) ||
+          !CreateFence( logical_device, false, *submission.Fence ) ) {
+        LogicalDevice = logical_device;
+        MappedData = static_cast<unsigned char *>(mapped_data);
+        Destroy();
+        return false;
+      }
+      submission.CommandBuffer = command_buffers[0];
+      submission.Ticket = 0;
+      submission.RingEnd = 0;
+    }
+
+    LogicalDevice = logical_device;
+    Queue = queue;
+    MappedData = static_cast<unsigned char *>(mapped_data);
+    Size = ring_size;
+    return true;
+  }
+
+  void StagingUploader::Destroy() {
+    if( VK_NULL_HANDLE != LogicalDevice ) {
+      WaitForAll();
+      if( nullptr != MappedData ) {
+        vkUnmapMemory( LogicalDevice, *Memory );
+      }
+    }
+    Submissions.clear();
+    SubmissionsInFlight.clear();
+    Memory = VkDestroyer(VkDeviceMemory)();
+    Buffer = VkDestroyer(VkBuffer)();
+    PendingBufferTransitionsBefore.clear();
+    PendingBufferTransitionsAfter.clear();
+    PendingImageTransitionsBefore.clear();
+    PendingImageTransitionsAfter.clear();
+    PendingBufferCopies.clear();
+    PendingImageCopies.clear();
+    InterruptedImageTransitions.clear();
+    PendingGeneratingStages = 0;
+    PendingConsumingStages = 0;
+    LogicalDevice = VK_NULL_HANDLE;
+    Queue = VK_NULL_HANDLE;
+    MappedData = nullptr;
+    Size = 0;
+    Head = 0;
+    Tail = 0;
+    NextSubmission = 0;
+  }
+
+  bool StagingUploader::UpdateBuffer( VkDeviceSize          data_size,
+                                      void const          * data,
+                                      VkBuffer              destination_buffer,
+                                      VkDeviceSize          destination_offset,
+                                      VkAccessFlags         destination_buffer_current_access,
+                                      VkAccessFlags         destination_buffer_new_access,
+                                      VkPipelineStageFlags  destination_buffer_generating_stages,
+                                      VkPipelineStageFlags  destination_buffer_consuming_stages,
+                                      uint64_t            * ticket ) {
+    VkDeviceSize offset;
+    if( !Allocate( data_size, offset ) ) {
+      return false;
+    }
+    std::memcpy( MappedData + offset, data, static_cast<size_t>(data_size) );
+
+    PendingBufferTransitionsBefore.push_back( { destination_buffer, destination_buffer_current_access, VK_ACCESS_TRANSFER_WRITE_BIT, VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED } );
+    PendingBufferTransitionsAfter.push_back( { destination_buffer, VK_ACCESS_TRANSFER_WRITE_BIT, destination_buffer_new_access, VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED } );
+    PendingBufferCopies.push_back( { destination_buffer, { offset, destination_offset, data_size } } );
+    PendingGeneratingStages |= destination_buffer_generating_stages;
+    PendingConsumingStages |= destination_buffer_consuming_stages;
+
+    ++Statistics.UploadCount;
+    Statistics.UploadedBytes += data_size;
+    if( ticket ) {
+      *ticket = NextTicket;
+    }
+    return true;
+  }
+
+  bool StagingUploader::UpdateImage( VkDeviceSize               data_size,
+                                     void const               * data,
+                                     VkImage                    destination_image,
+                                     VkImageSubresourceLayers   destination_image_subresource,
+                                     VkOffset3D                 destination_image_offset,
+                                     VkExtent3D                 destination_image_size,
+                                     VkImageLayout              destination_image_current_layout,
+                                     VkImageLayout              destination_image_new_layout,
+                                     VkAccessFlags              destination_image_current_access,
+                                     VkAccessFlags              destination_image_new_access,
+                                     VkImageAspectFlags         destination_image_aspect,
+                                     VkPipelineStageFlags       destination_image_generating_stages,
+                                     VkPipelineStageFlags       destination_image_consuming_stages,
+                                     uint64_t                 * ticket ) {
+    VkDeviceSize offset;
+    if( !Allocate( data_size, offset ) ) {
+      return false;
+    }
+    std::memcpy( MappedData + offset, data, static_cast<size_t>(data_size) );
+
+    // Contents written by a submission forced by a full ring in the middle of a batch must be preserved
+    for( auto & transition : InterruptedImageTransitions ) {
+      if( destination_image == transition.Image ) {
+        destination_image_current_layout = transition.NewLayout;
+        destination_image_current_access = transition.NewAccess | VK_ACCESS_TRANSFER_WRITE_BIT;
+        destination_image_generating_stages |= VK_PIPELINE_STAGE_TRANSFER_BIT;
+      }
+    }
+
+    // Barriers cover the whole image, so an image updated many times in a batch (e.g. cubemap faces)
+    // must be transitioned only once
+    bool transition_recorded = false;
+    for( size_t i = 0; i < PendingImageTransitionsBefore.size(); ++i ) {
+      if( destination_image == PendingImageTransitionsBefore[i].Image ) {
+        PendingImageTransitionsBefore[i].CurrentAccess |= destination_image_current_access;
+        PendingImageTransitionsAfter[i].NewAccess |= destination_image_new_access;
+        PendingImageTransitionsAfter[i].NewLayout = destination_image_new_layout;
+        transition_recorded = true;
+        break;
+      }
+    }
+    if( !transition_recorded ) {
+      PendingImageTransitionsBefore.push_back( { destination_image, destination_image_current_access, VK_ACCESS_TRANSFER_WRITE_BIT, destination_image_current_layout,
+        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, destination_image_aspect } );
+      PendingImageTransitionsAfter.push_back( { destination_image, VK_ACCESS_TRANSFER_WRITE_BIT, destination_image_new_access, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        destination_image_new_layout, VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, destination_image_aspect } );
+    }
+
+    VkBufferImageCopy region = {
+      offset,                                 // VkDeviceSize               bufferOffset
+      0,                                      // uint32_t                   bufferRowLength
+      0,                                      // uint32_t                   bufferImageHeight
+      destination_image_subresource,          // VkImageSubresourceLayers   imageSubresource
+      destination_image_offset,               // VkOffset3D                 imageOffset
+      destination_image_size                  // VkExtent3D                 imageExtent
+    };
+    PendingImageCopies.push_back( { destination_image, region } );
+    PendingGeneratingStages |= destination_image_generating_stages;
+    PendingConsumingStages |= destination_image_consuming_stages;
+
+    ++Statistics.UploadCount;
+    Statistics.UploadedBytes += data_size;
+    if( ticket ) {
+      *ticket = NextTicket;
+    }
+    return true;
+  }
+
+  bool StagingUploader::Flush( uint64_t * ticket ) {
+    if( !Submit( ticket ) ) {
+      return false;
+    }
+    InterruptedImageTransitions.clear();
+    return true;
+  }
+
+  bool StagingUploader::IsFinished( uint64_t ticket ) {
+    RetireFinishedSubmissions();
+    return ticket <= FinishedTicket;
+  }
+
+  bool StagingUploader::Wait( uint64_t ticket,
+                              uint64_t timeout ) {
+    // Uploads which weren't submitted yet can't finish
+    if( ticket >= NextTicket ) {
+      if( !Flush() ) {
+        return false;
+      }
+    }
+    while( ticket > FinishedTicket ) {
+      if( !RetireOldestSubmission( timeout ) ) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool StagingUploader::WaitForAll( uint64_t timeout ) {
+    if( !Flush() ) {
+      return false;
+    }
+    while( !SubmissionsInFlight.empty() ) {
+      if( !RetireOldestSubmission( timeout ) ) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  StagingUploaderStatistics StagingUploader::GetStatistics() const {
+    return Statistics;
+  }
+
+  bool StagingUploader::Submit( uint64_t * ticket ) {
+    if( PendingBufferCopies.empty() &&
+        PendingImageCopies.empty() ) {
+      if( ticket ) {
+        *ticket = NextTicket - 1;
+      }
+      return true;
+    }
+
+    if( SubmissionsInFlight.size() == Submissions.size() ) {
+      if( !RetireOldestSubmission( 1000000000 ) ) {
+        return false;
+      }
+    }
+
+    Submission & submission = Submissions[NextSubmission];
+    if( !ResetCommandPool( LogicalDevice, *submission.CommandPool, false ) ) {
+      return false;
+    }
+    if( !BeginCommandBufferRecordingOperation( submission.CommandBuffer, VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT, nullptr ) ) {
+      return false;
+    }
+
+    VkPipelineStageFlags generating_stages = 0 != PendingGeneratingStages ? PendingGeneratingStages : static_cast<VkPipelineStageFlags>(VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT);
+    VkPipelineStageFlags consuming_stages = 0 != PendingConsumingStages ? PendingConsumingStages : static_cast<VkPipelineStageFlags>(VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
+
+    SetBufferMemoryBarrier( submission.CommandBuffer, generating_stages, VK_PIPELINE_STAGE_TRANSFER_BIT, PendingBufferTransitionsBefore );
+    SetImageMemoryBarrier( submission.CommandBuffer, generating_stages, VK_PIPELINE_STAGE_TRANSFER_BIT, PendingImageTransitionsBefore );
+
+    // Consecutive copies into the same resource (e.g. all mipmap levels or array layers of an image)
+    // are recorded with a single copy command, as long as their destination regions don't overlap.
+    // Writes into overlapping regions must be performed in order, so they are separated with a barrier
+    std::vector<VkBufferCopy> buffer_regions;
+    std::vector<BufferCopy> unordered_buffer_copies;
+    for( size_t i = 0; i < PendingBufferCopies.size(); ++i ) {
+      BufferCopy const & copy = PendingBufferCopies[i];
+      bool overlaps = false;
+      for( auto & previous_copy : unordered_buffer_copies ) {
+        overlaps |= (copy.Buffer == previous_copy.Buffer) &&
+                    (copy.Region.dstOffset < previous_copy.Region.dstOffset + previous_copy.Region.size) &&
+                    (previous_copy.Region.dstOffset < copy.Region.dstOffset + copy.Region.size);
+      }
+      if( (!buffer_regions.empty()) &&
+          (overlaps || (copy.Buffer != PendingBufferCopies[i - 1].Buffer)) ) {
+        CopyDataBetweenBuffers( submission.CommandBuffer, *Buffer, PendingBufferCopies[i - 1].Buffer, buffer_regions );
+        buffer_regions.clear();
+      }
+      if( overlaps ) {
+        SetBufferMemoryBarrier( submission.CommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+          { { copy.Buffer, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_TRANSFER_WRITE_BIT, VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED } } );
+        unordered_buffer_copies.clear();
+      }
+      unordered_buffer_copies.push_back( copy );
+      buffer_regions.push_back( copy.Region );
+    }
+    if( !buffer_regions.empty() ) {
+      CopyDataBetweenBuffers( submission.CommandBuffer, *Buffer, PendingBufferCopies.back().Buffer, buffer_regions );
+    }
+
+    std::vector<VkBufferImageCopy> image_regions;
+    std::vector<ImageCopy> unordered_image_copies;
+    for( size_t i = 0; i < PendingImageCopies.size(); ++i ) {
+      ImageCopy const & copy = PendingImageCopies[i];
+      VkImageSubresourceLayers const & subresource = copy.Region.imageSubresource;
+      bool overlaps = false;
+      for( auto & previous_copy : unordered_image_copies ) {
+        VkImageSubresourceLayers const & previous_subresource = previous_copy.Region.imageSubresource;
+        overlaps |= (copy.Image == previous_copy.Image) &&
+                    (subresource.mipLevel == previous_subresource.mipLevel) &&
+                    (subresource.baseArrayLayer < previous_subresource.baseArrayLayer + previous_subresource.layerCount) &&
+                    (previous_subresource.baseArrayLayer < subresource.baseArrayLayer + subresource.layerCount);
+      }
+      if( (!image_regions.empty()) &&
+          (overlaps || (copy.Image != PendingImageCopies[i - 1].Image)) ) {
+        CopyDataFromBufferToImage( submission.CommandBuffer, *Buffer, PendingImageCopies[i - 1].Image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, image_regions );
+        image_regions.clear();
+      }
+      if( overlaps ) {
+        SetImageMemoryBarrier( submission.CommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+          { { copy.Image, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_TRANSFER_WRITE_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+          VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, subresource.aspectMask } } );
+        unordered_image_copies.clear();
+      }
+      unordered_image_copies.push_back( copy );
+      image_regions.push_back( copy.Region );
+    }
+    if( !image_regions.empty() ) {
+      CopyDataFromBufferToImage( submission.CommandBuffer, *Buffer, PendingImageCopies.back().Image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, image_regions );
+    }
+
+    SetBufferMemoryBarrier( submission.CommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, consuming_stages, PendingBufferTransitionsAfter );
+    SetImageMemoryBarrier( submission.CommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, consuming_stages, PendingImageTransitionsAfter );
+
+    if( !EndCommandBufferRecordingOperation( submission.CommandBuffer ) ) {
+      return false;
+    }
+    if( !ResetFences( LogicalDevice, { *submission.Fence } ) ) {
+      return false;
+    }
+    if( !SubmitCommandBuffersToQueue( Queue, {}, { submission.CommandBuffer }, {}, *submission.Fence ) ) {
+      return false;
+    }
+
+    submission.Ticket = NextTicket++;
+    submission.RingEnd = Head;
+    SubmissionsInFlight.push_back( NextSubmission );
+    NextSubmission = (NextSubmission + 1) % static_cast<uint32_t>(Submissions.size());
+    ++Statistics.SubmissionCount;
+
+    PendingBufferTransitionsBefore.clear();
+    PendingBufferTransitionsAfter.clear();
+    PendingImageTransitionsBefore.clear();
+    PendingImageTransitionsAfter.clear();
+    PendingBufferCopies.clear();
+    PendingImageCopies.clear();
+    PendingGeneratingStages = 0;
+    PendingConsumingStages = 0;
+
+    if( ticket ) {
+      *ticket = submission.Ticket;
+    }
+    return true;
+  }
+
+  bool StagingUploader::Allocate( VkDeviceSize   size,
+                                  VkDeviceSize & offset ) {
+    if( nullptr == MappedData ) {
+      std::cout << "Staging ring is not initialized." << std::endl;
+      return false;
+    }
+    if( size > Size ) {
+      std::cout << "Data is too big to fit in a staging ring." << std::endl;
+      return false;
+    }
+
+    RetireFinishedSubmissions();
+    if( TryAllocate( size, offset ) ) {
+      return true;
+    }
+
+    // Ring is full - pending uploads are submitted and space is reclaimed from the oldest submissions.
+    // Images transitioned by this submission are remembered, so the rest of the batch doesn't transition them again
+    ++Statistics.StallCount;
+    InterruptedImageTransitions.insert( InterruptedImageTransitions.end(), PendingImageTransitionsAfter.begin(), PendingImageTransitionsAfter.end() );
+    if( !Submit() ) {
+      return false;
+    }
+    while( !SubmissionsInFlight.empty() ) {
+      if( !RetireOldestSubmission( 1000000000 ) ) {
+        return false;
+      }
+      if( TryAllocate( size, offset ) ) {
+        return true;
+      }
+    }
+    return TryAllocate( size, offset );
+  }
+
+  bool StagingUploader::TryAllocate( VkDeviceSize   size,
+                                     VkDeviceSize & offset ) {
+    bool pending_uploads = !PendingBufferCopies.empty() || !PendingImageCopies.empty();
+    if( SubmissionsInFlight.empty() && !pending_uploads ) {
+      Head = 0;
+      Tail = 0;
+    }
+
+    // Free space is [aligned_head, Size) and [0, Tail) or [aligned_head, Tail) when the ring has wrapped.
+    // Head never reaches Tail from below, so Head == Tail always means an empty ring.
+    VkDeviceSize aligned_head = (Head + Alignment - 1) / Alignment * Alignment;
+    if( Head >= Tail ) {
+      if( aligned_head + size <= Size ) {
+        offset = aligned_head;
+        Head = aligned_head + size;
+        return true;
+      }
+      if( size < Tail ) {
+        offset = 0;
+        Head = size;
+        return true;
+      }
+    } else if( aligned_head + size < Tail ) {
+      offset = aligned_head;
+      Head = aligned_head + size;
+      return true;
+    }
+    return false;
+  }
+
+  bool StagingUploader::RetireOldestSubmission( uint64_t timeout ) {
+    if( SubmissionsInFlight.empty() ) {
+      return true;
+    }
+    Submission & submission = Submissions[SubmissionsInFlight.front()];
+    if( !WaitForFences( LogicalDevice, { *submission.Fence }, VK_FALSE, timeout ) ) {
+      return false;
+    }
+    Tail = submission.RingEnd;
+    FinishedTicket = submission.Ticket;
+    SubmissionsInFlight.pop_front();
+    return true;
+  }
+
+  void StagingUploader::RetireFinishedSubmissions() {
+    while( !SubmissionsInFlight.empty() ) {
+      Submission & submission = Submissions[SubmissionsInFlight.front()];
+      if( VK_SUCCESS != vkGetFenceStatus( LogicalDevice, *submission.Fence ) ) {
+        break;
+      }
+      Tail = submission.RingEnd;
+      FinishedTicket = submission.Ticket;
+      SubmissionsInFlight.pop_front();
+    }
+  }
+
+} // namespace VulkanCookbook
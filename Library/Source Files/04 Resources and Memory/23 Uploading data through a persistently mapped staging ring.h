@@ -0,0 +1,152 @@
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and / or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The below copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// Chapter: 04 Resources and Memory
+// Recipe:  23 Uploading data through a persistently mapped staging ring
+
+#ifndef UPLOADING_DATA_THROUGH_A_PERSISTENTLY_MAPPED_STAGING_RING
+#define UPLOADING_DATA_THROUGH_A_PERSISTENTLY_MAPPED_STAGING_RING
+
+#include <deque>
+#include "04 Resources and Memory/03 Setting a buffer memory barrier.h"
+#include "04 Resources and Memory/07 Setting an image memory barrier.h"
+
+namespace VulkanCookbook {
+
+  struct StagingUploaderStatistics {
+    uint64_t      UploadCount;
+    uint64_t      SubmissionCount;
+    VkDeviceSize  UploadedBytes;
+    uint64_t      StallCount;
+  };
+
+  // Data is copied into a single, persistently mapped staging buffer used as a ring.
+  // Uploads are gathered and recorded into one command buffer with one set of barriers
+  // on Flush(), so many uploads cost a single submission. Each submission gets a ticket,
+  // which can be polled or waited on only when the uploaded data is really needed.
+  // Ring space is reclaimed once the submission which used it has finished.
+
+  class StagingUploader {
+  public:
+    StagingUploader();
+    ~StagingUploader();
+
+    bool  Initialize( VkPhysicalDevice  physical_device,
+                      VkDevice          logical_device,
+                      VkQueue           queue,
+                      uint32_t          queue_family_index,
+                      VkDeviceSize      ring_size,
+                      uint32_t          max_submissions_in_flight = 4 );
+    void  Destroy();
+    bool  UpdateBuffer( VkDeviceSize          data_size,
+                        void const          * data,
+                        VkBuffer              destination_buffer,
+                        VkDeviceSize          destination_offset,
+                        VkAccessFlags         destination_buffer_current_access,
+                        VkAccessFlags         destination_buffer_new_access,
+                        VkPipelineStageFlags  destination_buffer_generating_stages,
+                        VkPipelineStageFlags  destination_buffer_consuming_stages,
+                        uint64_t            * ticket = nullptr );
+    bool  UpdateImage( VkDeviceSize               data_size,
+                       void const               * data,
+                       VkImage                    destination_image,
+                       VkImageSubresourceLayers   destination_image_subresource,
+                       VkOffset3D                 destination_image_offset,
+                       VkExtent3D                 destination_image_size,
+                       VkImageLayout              destination_image_current_layout,
+                       VkImageLayout              destination_image_new_layout,
+                       VkAccessFlags              destination_image_current_access,
+                       VkAccessFlags              destination_image_new_access,
+                       VkImageAspectFlags         destination_image_aspect,
+                       VkPipelineStageFlags       destination_image_generating_stages,
+                       VkPipelineStageFlags       destination_image_consuming_stages,
+                       uint64_t                 * ticket = nullptr );
+    bool  Flush( uint64_t * ticket = nullptr );
+    bool  IsFinished( uint64_t ticket );
+    bool  Wait( uint64_t ticket,
+                uint64_t timeout = 1000000000 );
+    bool  WaitForAll( uint64_t timeout = 1000000000 );
+
+    StagingUploaderStatistics GetStatistics() const;
+
+    StagingUploader( StagingUploader const & ) = delete;
+    StagingUploader& operator=( StagingUploader const & ) = delete;
+
+  private:
+    struct Submission {
+      VkDestroyer(VkCommandPool)  CommandPool;
+      VkCommandBuffer             CommandBuffer;
+      VkDestroyer(VkFence)        Fence;
+      uint64_t                    Ticket;
+      VkDeviceSize                RingEnd;
+    };
+
+    struct BufferCopy {
+      VkBuffer                    Buffer;
+      VkBufferCopy                Region;
+    };
+
+    struct ImageCopy {
+      VkImage                     Image;
+      VkBufferImageCopy           Region;
+    };
+
+    bool  Submit( uint64_t * ticket = nullptr );
+    bool  Allocate( VkDeviceSize   size,
+                    VkDeviceSize & offset );
+    bool  TryAllocate( VkDeviceSize   size,
+                       VkDeviceSize & offset );
+    bool  RetireOldestSubmission( uint64_t timeout );
+    void  RetireFinishedSubmissions();
+
+    VkDevice                          LogicalDevice;
+    VkQueue                           Queue;
+    VkDestroyer(VkBuffer)             Buffer;
+    VkDestroyer(VkDeviceMemory)       Memory;
+    unsigned char                   * MappedData;
+    VkDeviceSize                      Size;
+    VkDeviceSize                      Alignment;
+    VkDeviceSize                      Head;
+    VkDeviceSize                      Tail;
+    std::vector<Submission>           Submissions;
+    std::deque<uint32_t>              SubmissionsInFlight;
+    uint32_t                          NextSubmission;
+    uint64_t                          NextTicket;
+    uint64_t                          FinishedTicket;
+    std::vector<BufferTransition>     PendingBufferTransitionsBefore;
+    std::vector<BufferTransition>     PendingBufferTransitionsAfter;
+    std::vector<ImageTransition>      PendingImageTransitionsBefore;
+    std::vector<ImageTransition>      PendingImageTransitionsAfter;
+    std::vector<BufferCopy>           PendingBufferCopies;
+    std::vector<ImageCopy>            PendingImageCopies;
+    std::vector<ImageTransition>      InterruptedImageTransitions;
+    VkPipelineStageFlags              PendingGeneratingStages;
+    VkPipelineStageFlags              PendingConsumingStages;
+    StagingUploaderStatistics         Statistics;
+  };
+
+} // namespace VulkanCookbook
+
+#endif // UPLOADING_DATA_THROUGH_A_PERSISTENTLY_MAPPED_STAGING_RING
@@ -0,0 +1,157 @@
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and / or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The below copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// Chapter: 04 Resources and Memory
+// Recipe:  24 Generating mipmaps of an image with blits
+
+#include "04 Resources and Memory/24 Generating mipmaps of an image with blits.h"
+
+namespace VulkanCookbook {
+
+  namespace {
+
+    VkImageMemoryBarrier PrepareMipmapLevelsBarrier( VkImage             image,
+                                                     VkImageAspectFlags  aspect,
+                                                     uint32_t            base_mipmap,
+                                                     uint32_t            num_mipmaps,
+                                                     uint32_t            num_layers,
+                                                     VkAccessFlags       current_access,
+                                                     VkAccessFlags       new_access,
+                                                     VkImageLayout       current_layout,
+                                                     VkImageLayout       new_layout ) {
+      return {
+        VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,   // VkStructureType            sType
+        nullptr,                                  // const void               * pNext
+        current_access,                           // VkAccessFlags              srcAccessMask
+        new_access,                               // VkAccessFlags              dstAccessMask
+        current_layout,                           // VkImageLayout              oldLayout
+        new_layout,                               // VkImageLayout              newLayout
+        VK_QUEUE_FAMILY_IGNORED,                  // uint32_t                   srcQueueFamilyIndex
+        VK_QUEUE_FAMILY_IGNORED,                  // uint32_t                   dstQueueFamilyIndex
+        image,                                    // VkImage                    image
+        {                                         // VkImageSubresourceRange    subresourceRange
+          aspect,                                   // VkImageAspectFlags         aspectMask
+          base_mipmap,                              // uint32_t                   baseMipLevel
+          num_mipmaps,                              // uint32_t                   levelCount
+          0,                                        // uint32_t                   baseArrayLayer
+          num_layers                                // uint32_t                   layerCount
+        }
+      };
+    }
+
+  } // namespace
+
+  bool CheckIfFormatSupportsMipmapGenerationWithBlits( VkPhysicalDevice  physical_device,
+                                                       VkFormat          format ) {
+    VkFormatProperties format_properties;
+    vkGetPhysicalDeviceFormatProperties( physical_device, format, &format_properties );
+    VkFormatFeatureFlags required_features = VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+    return required_features == (format_properties.optimalTilingFeatures & required_features);
+  }
+
+  bool GenerateMipmapsWithBlits( VkPhysicalDevice      physical_device,
+                                 VkCommandBuffer       command_buffer,
+                                 VkImage               image,
+                                 VkFormat              format,
+                                 VkExtent3D            size,
+                                 uint32_t              num_mipmaps,
+                                 uint32_t              num_layers,
+                                 VkImageAspectFlags    aspect,
+                                 VkImageLayout         current_layout,
+                                 VkAccessFlags         current_access,
+                                 VkPipelineStageFlags  generating_stages,
+                                 VkImageLayout         new_layout,
+                                 VkAccessFlags         new_access,
+                                 VkPipelineStageFlags  consuming_stages ) {
+    if( (1 < num_mipmaps) &&
+        !CheckIfFormatSupportsMipmapGenerationWithBlits( physical_device, format ) ) {
+      std::cout << "Provided format doesn't support linearly filtered blits required for mipmap generation." << std::endl;
+      return false;
+    }
+
+    // Level 0 becomes a source of the first blit, all other levels become destinations - both in one barrier
+    std::vector<VkImageMemoryBarrier> barriers = {
+      PrepareMipmapLevelsBarrier( image, aspect, 0, 1, num_layers, current_access, VK_ACCESS_TRANSFER_READ_BIT, current_layout, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL )
+    };
+    if( 1 < num_mipmaps ) {
+      barriers.push_back( PrepareMipmapLevelsBarrier( image, aspect, 1, num_mipmaps - 1, num_layers, 0, VK_ACCESS_TRANSFER_WRITE_BIT, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL ) );
+    }
+    vkCmdPipelineBarrier( command_buffer, generating_stages, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, static_cast<uint32_t>(barriers.size()), barriers.data() );
+
+    for( uint32_t level = 1; level < num_mipmaps; ++level ) {
+      VkImageBlit image_blit = {
+        {                                                             // VkImageSubresourceLayers   srcSubresource
+          aspect,                                                       // VkImageAspectFlags         aspectMask
+          level - 1,                                                    // uint32_t                   mipLevel
+          0,                                                            // uint32_t                   baseArrayLayer
+          num_layers                                                    // uint32_t                   layerCount
+        },
+        {                                                             // VkOffset3D                 srcOffsets[2]
+          { 0, 0, 0 },
+          {
+            static_cast<int32_t>(std::max( 1u, size.width >> (level - 1) )),
+            static_cast<int32_t>(std::max( 1u, size.height >> (level - 1) )),
+            static_cast<int32_t>(std::max( 1u, size.depth >> (level - 1) ))
+          }
+        },
+        {                                                             // VkImageSubresourceLayers   dstSubresource
+          aspect,                                                       // VkImageAspectFlags         aspectMask
+          level,                                                        // uint32_t                   mipLevel
+          0,                                                            // uint32_t                   baseArrayLayer
+          num_layers                                                    // uint32_t                   layerCount
+        },
+        {                                                             // VkOffset3D                 dstOffsets[2]
+          { 0, 0, 0 },
+          {
+            static_cast<int32_t>(std::max( 1u, size.width >> level )),
+            static_cast<int32_t>(std::max( 1u, size.height >> level )),
+            static_cast<int32_t>(std::max( 1u, size.depth >> level ))
+          }
+        }
+      };
+      vkCmdBlitImage( command_buffer, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &image_blit, VK_FILTER_LINEAR );
+
+      // Freshly written level becomes a source for the next one
+      if( level + 1 < num_mipmaps ) {
+        VkImageMemoryBarrier barrier = PrepareMipmapLevelsBarrier( image, aspect, level, 1, num_layers, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+          VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL );
+        vkCmdPipelineBarrier( command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier );
+      }
+    }
+
+    // All source levels and the last, only written level are transitioned with a single barrier command
+    barriers = {
+      PrepareMipmapLevelsBarrier( image, aspect, 0, std::max( 1u, num_mipmaps - 1 ), num_layers, VK_ACCESS_TRANSFER_READ_BIT, new_access,
+        VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, new_layout )
+    };
+    if( 1 < num_mipmaps ) {
+      barriers.push_back( PrepareMipmapLevelsBarrier( image, aspect, num_mipmaps - 1, 1, num_layers, VK_ACCESS_TRANSFER_WRITE_BIT, new_access,
+        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, new_layout ) );
+    }
+    vkCmdPipelineBarrier( command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, consuming_stages, 0, 0, nullptr, 0, nullptr, static_cast<uint32_t>(barriers.size()), barriers.data() );
+    return true;
+  }
+
+} // namespace VulkanCookbook
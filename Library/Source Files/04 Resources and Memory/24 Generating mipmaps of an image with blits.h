@@ -0,0 +1,60 @@
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and / or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The below copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// Chapter: 04 Resources and Memory
+// Recipe:  24 Generating mipmaps of an image with blits
+
+#ifndef GENERATING_MIPMAPS_OF_AN_IMAGE_WITH_BLITS
+#define GENERATING_MIPMAPS_OF_AN_IMAGE_WITH_BLITS
+
+#include "Common.h"
+
+namespace VulkanCookbook {
+
+  bool CheckIfFormatSupportsMipmapGenerationWithBlits( VkPhysicalDevice  physical_device,
+                                                       VkFormat          format );
+
+  // Records blits which fill all mipmap levels (of all array layers) from the contents of level 0.
+  // Current layout and access describe level 0 only - contents of other levels are discarded.
+  // After the operation all levels are transitioned to the new layout.
+
+  bool GenerateMipmapsWithBlits( VkPhysicalDevice      physical_device,
+                                 VkCommandBuffer       command_buffer,
+                                 VkImage               image,
+                                 VkFormat              format,
+                                 VkExtent3D            size,
+                                 uint32_t              num_mipmaps,
+                                 uint32_t              num_layers,
+                                 VkImageAspectFlags    aspect,
+                                 VkImageLayout         current_layout,
+                                 VkAccessFlags         current_access,
+                                 VkPipelineStageFlags  generating_stages,
+                                 VkImageLayout         new_layout,
+                                 VkAccessFlags         new_access,
+                                 VkPipelineStageFlags  consuming_stages );
+
+} // namespace VulkanCookbook
+
+#endif // GENERATING_MIPMAPS_OF_AN_IMAGE_WITH_BLITS
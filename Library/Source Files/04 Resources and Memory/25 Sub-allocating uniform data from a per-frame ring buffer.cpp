@@ -0,0 +1,166 @@
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and / or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The below copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// Chapter: 04 Resources and Memory
+// Recipe:  25 Sub-allocating uniform data from a per-frame ring buffer
+
+#include "01 Instance and Devices/12 Getting features and properties of a physical device.h"
+#include "04 Resources and Memory/01 Creating a buffer.h"
+#include "04 Resources and Memory/02 Allocating and binding memory object to a buffer.h"
+#include "04 Resources and Memory/25 Sub-allocating uniform data from a per-frame ring buffer.h"
+
+namespace VulkanCookbook {
+
+  UniformRingBuffer::UniformRingBuffer() :
+    LogicalDevice( VK_NULL_HANDLE ),
+    MappedData( nullptr ),
+    FrameSize( 0 ),
+    Alignment( 256 ),
+    FrameIndex( 0 ),
+    Statistics() {
+  }
+
+  UniformRingBuffer::~UniformRingBuffer() {
+    Destroy();
+  }
+
+  bool UniformRingBuffer::Initialize( VkPhysicalDevice  physical_device,
+                                      VkDevice          logical_device,
+                                      VkDeviceSize      frame_size,
+                                      uint32_t          frames_count ) {
+    Destroy();
+
+    if( (0 == frame_size) ||
+        (0 == frames_count) ) {
+      std::cout << "Uniform ring buffer requires non-zero frame size and at least one frame." << std::endl;
+      return false;
+    }
+
+    // Dynamic offsets must be multiples of the minUniformBufferOffsetAlignment limit, so is the size of each frame's part
+    VkPhysicalDeviceFeatures   device_features;
+    VkPhysicalDeviceProperties device_properties;
+    GetFeaturesAndPropertiesOfPhysicalDevice( physical_device, device_features, device_properties );
+    Alignment = device_properties.limits.minUniformBufferOffsetAlignment > 0 ? device_properties.limits.minUniformBufferOffsetAlignment : 1;
+    frame_size = (frame_size + Alignment - 1) / Alignment * Alignment;
+
+    InitVkDestroyer( logical_device, Buffer );
+    if( !CreateBuffer( logical_device, frame_size * frames_count, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, *Buffer ) ) {
+      return false;
+    }
+
+    // Coherent memory doesn't need explicit flushes after data is written
+    InitVkDestroyer( logical_device, Memory );
+    if( !AllocateAndBindMemoryObjectToBuffer( physical_device, logical_device, *Buffer,
+      static_cast<VkMemoryPropertyFlagBits>(VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT), *Memory ) ) {
+      Buffer = VkDestroyer(VkBuffer)();
+      return false;
+    }
+
+    void * mapped_data;
+    VkResult result = vkMapMemory( logical_device, *Memory, 0, VK_WHOLE_SIZE, 0, &mapped_data );
+    if( VK_SUCCESS != result ) {
+      std::cout << "Could not map memory object of a uniform ring buffer." << std::endl;
+      Memory = VkDestroyer(VkDeviceMemory)();
+      Buffer = VkDestroyer(VkBuffer)();
+      return false;
+    }
+
+    LogicalDevice = logical_device;
+    MappedData = static_cast<unsigned char *>(mapped_data);
+    FrameSize = frame_size;
+    FrameIndex = 0;
+    FrameBytesUsed.assign( frames_count, 0 );
+    return true;
+  }
+
+  void UniformRingBuffer::Destroy() {
+    if( (VK_NULL_HANDLE != LogicalDevice) &&
+        (nullptr != MappedData) ) {
+      vkUnmapMemory( LogicalDevice, *Memory );
+    }
+    Memory = VkDestroyer(VkDeviceMemory)();
+    Buffer = VkDestroyer(VkBuffer)();
+    LogicalDevice = VK_NULL_HANDLE;
+    MappedData = nullptr;
+    FrameSize = 0;
+    FrameIndex = 0;
+    FrameBytesUsed.clear();
+  }
+
+  bool UniformRingBuffer::BeginFrame( uint32_t frame_index ) {
+    if( FrameBytesUsed.empty() ) {
+      std::cout << "Uniform ring buffer is not initialized." << std::endl;
+      return false;
+    }
+    FrameIndex = frame_index % static_cast<uint32_t>(FrameBytesUsed.size());
+    FrameBytesUsed[FrameIndex] = 0;
+    return true;
+  }
+
+  bool UniformRingBuffer::Allocate( VkDeviceSize    data_size,
+                                    void const    * data,
+                                    uint32_t      & dynamic_offset ) {
+    if( FrameBytesUsed.empty() ) {
+      std::cout << "Uniform ring buffer is not initialized." << std::endl;
+      return false;
+    }
+
+    VkDeviceSize offset = (FrameBytesUsed[FrameIndex] + Alignment - 1) / Alignment * Alignment;
+    if( offset + data_size > FrameSize ) {
+      ++Statistics.OverflowCount;
+      std::cout << "Uniform ring buffer overflow: " << data_size << " bytes requested, " << (FrameSize - FrameBytesUsed[FrameIndex])
+                << " of " << FrameSize << " bytes left in frame " << FrameIndex << "." << std::endl;
+      return false;
+    }
+
+    VkDeviceSize buffer_offset = FrameIndex * FrameSize + offset;
+    std::memcpy( MappedData + buffer_offset, data, static_cast<size_t>(data_size) );
+    dynamic_offset = static_cast<uint32_t>(buffer_offset);
+
+    FrameBytesUsed[FrameIndex] = offset + data_size;
+    ++Statistics.AllocationCount;
+    Statistics.AllocatedBytes += data_size;
+    if( FrameBytesUsed[FrameIndex] > Statistics.PeakFrameBytesUsed ) {
+      Statistics.PeakFrameBytesUsed = FrameBytesUsed[FrameIndex];
+    }
+    return true;
+  }
+
+  VkBuffer UniformRingBuffer::GetBuffer() const {
+    return *Buffer;
+  }
+
+  VkDeviceSize UniformRingBuffer::GetFrameBytesUsed( uint32_t frame_index ) const {
+    if( FrameBytesUsed.empty() ) {
+      return 0;
+    }
+    return FrameBytesUsed[frame_index % FrameBytesUsed.size()];
+  }
+
+  UniformRingBufferStatistics UniformRingBuffer::GetStatistics() const {
+    return Statistics;
+  }
+
+} // namespace VulkanCookbook
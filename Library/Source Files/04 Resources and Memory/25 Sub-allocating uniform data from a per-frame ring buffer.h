@@ -0,0 +1,86 @@
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and / or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The below copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// Chapter: 04 Resources and Memory
+// Recipe:  25 Sub-allocating uniform data from a per-frame ring buffer
+
+#ifndef SUB_ALLOCATING_UNIFORM_DATA_FROM_A_PER_FRAME_RING_BUFFER
+#define SUB_ALLOCATING_UNIFORM_DATA_FROM_A_PER_FRAME_RING_BUFFER
+
+#include "Common.h"
+
+namespace VulkanCookbook {
+
+  struct UniformRingBufferStatistics {
+    uint64_t      AllocationCount;
+    VkDeviceSize  AllocatedBytes;
+    VkDeviceSize  PeakFrameBytesUsed;
+    uint64_t      OverflowCount;
+  };
+
+  // A single, persistently mapped uniform buffer split into one part per frame in flight.
+  // Data of each frame is sub-allocated linearly from the frame's part and is accessed through
+  // VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC descriptors with the returned dynamic offsets,
+  // so updates need neither copies into device-local memory nor barriers.
+  // A frame's part is reset in BeginFrame(), which can be called only after the previous
+  // submission of that frame has finished (e.g. after FramePacer::WaitForFrame()).
+
+  class UniformRingBuffer {
+  public:
+    UniformRingBuffer();
+    ~UniformRingBuffer();
+
+    bool          Initialize( VkPhysicalDevice  physical_device,
+                              VkDevice          logical_device,
+                              VkDeviceSize      frame_size,
+                              uint32_t          frames_count );
+    void          Destroy();
+    bool          BeginFrame( uint32_t frame_index );
+    bool          Allocate( VkDeviceSize    data_size,
+                            void const    * data,
+                            uint32_t      & dynamic_offset );
+    VkBuffer      GetBuffer() const;
+    VkDeviceSize  GetFrameBytesUsed( uint32_t frame_index ) const;
+
+    UniformRingBufferStatistics GetStatistics() const;
+
+    UniformRingBuffer( UniformRingBuffer const & ) = delete;
+    UniformRingBuffer& operator=( UniformRingBuffer const & ) = delete;
+
+  private:
+    VkDevice                      LogicalDevice;
+    VkDestroyer(VkBuffer)         Buffer;
+    VkDestroyer(VkDeviceMemory)   Memory;
+    unsigned char               * MappedData;
+    VkDeviceSize                  FrameSize;
+    VkDeviceSize                  Alignment;
+    uint32_t                      FrameIndex;
+    std::vector<VkDeviceSize>     FrameBytesUsed;
+    UniformRingBufferStatistics   Statistics;
+  };
+
+} // namespace VulkanCookbook
+
+#endif // SUB_ALLOCATING_UNIFORM_DATA_FROM_A_PER_FRAME_RING_BUFFER
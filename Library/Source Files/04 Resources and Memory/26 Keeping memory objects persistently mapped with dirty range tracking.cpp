@@ -0,0 +1,232 @@
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and / or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The below copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// Chapter: 04 Resources and Memory
+// Recipe:  26 Keeping memory objects persistently mapped with dirty range tracking
+
+#include <algorithm>
+#include "01 Instance and Devices/12 Getting features and properties of a physical device.h"
+#include "04 Resources and Memory/26 Keeping memory objects persistently mapped with dirty range tracking.h"
+
+namespace VulkanCookbook {
+
+  MappedMemoryManager::MappedMemoryManager() :
+    LogicalDevice( VK_NULL_HANDLE ),
+    NonCoherentAtomSize( 1 ),
+    Statistics() {
+  }
+
+  MappedMemoryManager::~MappedMemoryManager() {
+    Destroy();
+  }
+
+  bool MappedMemoryManager::Initialize( VkPhysicalDevice  physical_device,
+                                        VkDevice          logical_device ) {
+    Destroy();
+
+    VkPhysicalDeviceFeatures   device_features;
+    VkPhysicalDeviceProperties device_properties;
+    GetFeaturesAndPropertiesOfPhysicalDevice( physical_device, device_features, device_properties );
+    NonCoherentAtomSize = device_properties.limits.nonCoherentAtomSize > 0 ? device_properties.limits.nonCoherentAtomSize : 1;
+
+    LogicalDevice = logical_device;
+    return true;
+  }
+
+  void MappedMemoryManager::Destroy() {
+    if( VK_NULL_HANDLE != LogicalDevice ) {
+      FlushDirtyRanges();
+      for( auto & memory : MemoryObjects ) {
+        vkUnmapMemory( LogicalDevice, memory.first );
+      }
+    }
+    MemoryObjects.clear();
+    FlushRanges.clear();
+    LogicalDevice = VK_NULL_HANDLE;
+  }
+
+  bool MappedMemoryManager::Map( VkDeviceMemory          memory_object,
+                                 VkDeviceSize            memory_size,
+                                 VkMemoryPropertyFlags   memory_properties,
+                                 void                * * pointer ) {
+    auto memory = MemoryObjects.find( memory_object );
+    if( MemoryObjects.end() == memory ) {
+      void * mapped_data;
+      VkResult result = vkMapMemory( LogicalDevice, memory_object, 0, VK_WHOLE_SIZE, 0, &mapped_data );
+      if( VK_SUCCESS != result ) {
+        std::cout << "Could not map memory object." << std::endl;
+        return false;
+      }
+      ++Statistics.MapCount;
+
+      MappedMemoryObject mapped_memory = {
+        static_cast<unsigned char *>(mapped_data),
+        memory_size,
+        0 != (memory_properties & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT),
+        {}
+      };
+      memory = MemoryObjects.emplace( memory_object, std::move( mapped_memory ) ).first;
+    }
+
+    if( nullptr != pointer ) {
+      *pointer = memory->second.Pointer;
+    }
+    return true;
+  }
+
+  void MappedMemoryManager::Unmap( VkDeviceMemory memory_object ) {
+    auto memory = MemoryObjects.find( memory_object );
+    if( MemoryObjects.end() != memory ) {
+      if( !memory->second.DirtyRanges.empty() ) {
+        FlushDirtyRanges();
+      }
+      vkUnmapMemory( LogicalDevice, memory_object );
+      MemoryObjects.erase( memory );
+    }
+  }
+
+  bool MappedMemoryManager::Write( VkDeviceMemory   memory_object,
+                                   VkDeviceSize     offset,
+                                   VkDeviceSize     data_size,
+                                   void const     * data ) {
+    auto memory = MemoryObjects.find( memory_object );
+    if( (MemoryObjects.end() == memory) ||
+        (offset + data_size > memory->second.Size) ) {
+      std::cout << "Could not write data outside of a mapped memory range." << std::endl;
+      return false;
+    }
+
+    std::memcpy( memory->second.Pointer + offset, data, static_cast<size_t>(data_size) );
+    MarkDirty( memory_object, offset, data_size );
+    return true;
+  }
+
+  void MappedMemoryManager::MarkDirty( VkDeviceMemory  memory_object,
+                                       VkDeviceSize    offset,
+                                       VkDeviceSize    size ) {
+    auto memory = MemoryObjects.find( memory_object );
+    if( (MemoryObjects.end() == memory) ||
+        memory->second.Coherent ||
+        (0 == size) ) {
+      return;
+    }
+    memory->second.DirtyRanges.push_back( AlignRange( memory->second, offset, size ) );
+  }
+
+  bool MappedMemoryManager::FlushDirtyRanges() {
+    Statistics.FrameFlushedBytes = 0;
+    FlushRanges.clear();
+    for( auto & memory : MemoryObjects ) {
+      auto & ranges = memory.second.DirtyRanges;
+      if( ranges.empty() ) {
+        continue;
+      }
+
+      // Overlapping and adjacent ranges are merged, so each byte is flushed once
+      std::sort( ranges.begin(), ranges.end(), []( MemoryRange const & left, MemoryRange const & right ) {
+        return left.Begin < right.Begin;
+      } );
+      MemoryRange merged_range = ranges[0];
+      for( size_t i = 1; i <= ranges.size(); ++i ) {
+        if( (i < ranges.size()) &&
+            (ranges[i].Begin <= merged_range.End) ) {
+          merged_range.End = std::max( merged_range.End, ranges[i].End );
+        } else {
+          FlushRanges.push_back( PrepareMappedMemoryRange( memory.first, memory.second, merged_range ) );
+          Statistics.FrameFlushedBytes += merged_range.End - merged_range.Begin;
+          if( i < ranges.size() ) {
+            merged_range = ranges[i];
+          }
+        }
+      }
+      ranges.clear();
+    }
+
+    if( FlushRanges.empty() ) {
+      return true;
+    }
+
+    ++Statistics.FlushCallCount;
+    Statistics.FlushedBytes += Statistics.FrameFlushedBytes;
+    VkResult result = vkFlushMappedMemoryRanges( LogicalDevice, static_cast<uint32_t>(FlushRanges.size()), FlushRanges.data() );
+    if( VK_SUCCESS != result ) {
+      std::cout << "Could not flush mapped memory." << std::endl;
+      return false;
+    }
+    return true;
+  }
+
+  bool MappedMemoryManager::Invalidate( VkDeviceMemory  memory_object,
+                                        VkDeviceSize    offset,
+                                        VkDeviceSize    size ) {
+    auto memory = MemoryObjects.find( memory_object );
+    if( MemoryObjects.end() == memory ) {
+      std::cout << "Could not invalidate memory object which is not mapped." << std::endl;
+      return false;
+    }
+    if( memory->second.Coherent ||
+        (0 == size) ) {
+      return true;
+    }
+
+    MemoryRange range = AlignRange( memory->second, offset, size );
+    VkMappedMemoryRange memory_range = PrepareMappedMemoryRange( memory_object, memory->second, range );
+    ++Statistics.InvalidateCallCount;
+    Statistics.InvalidatedBytes += range.End - range.Begin;
+    VkResult result = vkInvalidateMappedMemoryRanges( LogicalDevice, 1, &memory_range );
+    if( VK_SUCCESS != result ) {
+      std::cout << "Could not invalidate mapped memory." << std::endl;
+      return false;
+    }
+    return true;
+  }
+
+  MappedMemoryStatistics MappedMemoryManager::GetStatistics() const {
+    return Statistics;
+  }
+
+  MappedMemoryManager::MemoryRange MappedMemoryManager::AlignRange( MappedMemoryObject const & memory,
+                                                                    VkDeviceSize               offset,
+                                                                    VkDeviceSize               size ) const {
+    VkDeviceSize begin = offset / NonCoherentAtomSize * NonCoherentAtomSize;
+    VkDeviceSize end = (offset + size + NonCoherentAtomSize - 1) / NonCoherentAtomSize * NonCoherentAtomSize;
+    return { begin, std::min( end, memory.Size ) };
+  }
+
+  VkMappedMemoryRange MappedMemoryManager::PrepareMappedMemoryRange( VkDeviceMemory             memory_object,
+                                                                     MappedMemoryObject const & memory,
+                                                                     MemoryRange                range ) const {
+    // Range reaching the end of the mapped data may not be a multiple of the atom size,
+    // so it is extended to the end of the memory object
+    return {
+      VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE,                                    // VkStructureType    sType
+      nullptr,                                                                  // const void       * pNext
+      memory_object,                                                            // VkDeviceMemory     memory
+      range.Begin,                                                              // VkDeviceSize       offset
+      (range.End < memory.Size) ? range.End - range.Begin : VK_WHOLE_SIZE      // VkDeviceSize       size
+    };
+  }
+
+} // namespace VulkanCookbook
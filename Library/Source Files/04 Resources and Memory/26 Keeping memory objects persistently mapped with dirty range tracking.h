@@ -0,0 +1,110 @@
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and / or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The below copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// Chapter: 04 Resources and Memory
+// Recipe:  26 Keeping memory objects persistently mapped with dirty range tracking
+
+#ifndef KEEPING_MEMORY_OBJECTS_PERSISTENTLY_MAPPED_WITH_DIRTY_RANGE_TRACKING
+#define KEEPING_MEMORY_OBJECTS_PERSISTENTLY_MAPPED_WITH_DIRTY_RANGE_TRACKING
+
+#include <unordered_map>
+#include "Common.h"
+
+namespace VulkanCookbook {
+
+  struct MappedMemoryStatistics {
+    uint64_t      MapCount;
+    uint64_t      FlushCallCount;
+    VkDeviceSize  FlushedBytes;
+    VkDeviceSize  FrameFlushedBytes;      // flushed by the most recent FlushDirtyRanges() call
+    uint64_t      InvalidateCallCount;
+    VkDeviceSize  InvalidatedBytes;
+  };
+
+  // Each memory object is mapped once and stays mapped until Unmap() or Destroy().
+  // Writes into non-coherent memory are recorded as dirty ranges rounded to nonCoherentAtomSize;
+  // FlushDirtyRanges() flushes all of them, from all memory objects, with one call (e.g. once per frame).
+  // Nothing is flushed or invalidated for host-coherent memory.
+
+  class MappedMemoryManager {
+  public:
+    MappedMemoryManager();
+    ~MappedMemoryManager();
+
+    bool    Initialize( VkPhysicalDevice  physical_device,
+                        VkDevice          logical_device );
+    void    Destroy();
+    bool    Map( VkDeviceMemory          memory_object,
+                 VkDeviceSize            memory_size,
+                 VkMemoryPropertyFlags   memory_properties,
+                 void                * * pointer = nullptr );
+    void    Unmap( VkDeviceMemory memory_object );
+    bool    Write( VkDeviceMemory   memory_object,
+                   VkDeviceSize     offset,
+                   VkDeviceSize     data_size,
+                   void const     * data );
+    void    MarkDirty( VkDeviceMemory  memory_object,
+                       VkDeviceSize    offset,
+                       VkDeviceSize    size );
+    bool    FlushDirtyRanges();
+    bool    Invalidate( VkDeviceMemory  memory_object,
+                        VkDeviceSize    offset,
+                        VkDeviceSize    size );
+
+    MappedMemoryStatistics GetStatistics() const;
+
+    MappedMemoryManager( MappedMemoryManager const & ) = delete;
+    MappedMemoryManager& operator=( MappedMemoryManager const & ) = delete;
+
+  private:
+    struct MemoryRange {
+      VkDeviceSize  Begin;
+      VkDeviceSize  End;
+    };
+
+    struct MappedMemoryObject {
+      unsigned char            * Pointer;
+      VkDeviceSize               Size;
+      bool                       Coherent;
+      std::vector<MemoryRange>   DirtyRanges;
+    };
+
+    MemoryRange         AlignRange( MappedMemoryObject const & memory,
+                                    VkDeviceSize               offset,
+                                    VkDeviceSize               size ) const;
+    VkMappedMemoryRange PrepareMappedMemoryRange( VkDeviceMemory             memory_object,
+                                                  MappedMemoryObject const & memory,
+                                                  MemoryRange                range ) const;
+
+    VkDevice                                                LogicalDevice;
+    VkDeviceSize                                            NonCoherentAtomSize;
+    std::unordered_map<VkDeviceMemory, MappedMemoryObject>  MemoryObjects;
+    std::vector<VkMappedMemoryRange>                        FlushRanges;
+    MappedMemoryStatistics                                  Statistics;
+  };
+
+} // namespace VulkanCookbook
+
+#endif // KEEPING_MEMORY_OBJECTS_PERSISTENTLY_MAPPED_WITH_DIRTY_RANGE_TRACKING
@@ -29,6 +29,7 @@
 #include "04 Resources and Memory/05 Creating an image.h"
 #include "04 Resources and Memory/06 Allocating and binding memory object to an image.h"
 #include "04 Resources and Memory/08 Creating an image view.h"
+#include "04 Resources and Memory/24 Generating mipmaps of an image with blits.h"
 #include "05 Descriptor Sets/02 Creating a sampled image.h"
 
 namespace VulkanCookbook {
@@ -47,7 +48,8 @@ namespace VulkanCookbook {
                            bool                linear_filtering,
                            VkImage           & sampled_image,
                            VkDeviceMemory    & memory_object,
-                           VkImageView       & sampled_image_view ) {
+                           VkImageView       & sampled_image_view,
+                           bool                generate_mipmaps_with_blits ) {
     VkFormatProperties format_properties;
     vkGetPhysicalDeviceFormatProperties( physical_device, format, &format_properties );
     if( !(format_properties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT) ) {
@@ -59,6 +61,14 @@ namespace VulkanCookbook {
       std::cout << "Provided format is not supported for a linear image filtering." << std::endl;
       return false;
     }
+    if( generate_mipmaps_with_blits ) {
+      if( (1 < num_mipmaps) &&
+          !CheckIfFormatSupportsMipmapGenerationWithBlits( physical_device, format ) ) {
+        std::cout << "Provided format doesn't support linearly filtered blits required for mipmap generation." << std::endl;
+        return false;
+      }
+      usage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    }
 
     if( !CreateImage( logical_device, type, format, size, num_mipmaps, num_layers, VK_SAMPLE_COUNT_1_BIT, usage | VK_IMAGE_USAGE_SAMPLED_BIT, cubemap, sampled_image ) ) {
       return false;
@@ -33,6 +33,9 @@
 
 namespace VulkanCookbook {
 
+  // When mipmaps are going to be generated with blits (e.g. of a rendered image), the format is checked
+  // for linearly filtered blits and the image is created with transfer source and destination usages
+
   bool CreateSampledImage( VkPhysicalDevice    physical_device,
                            VkDevice            logical_device,
                            VkImageType         type,
@@ -47,7 +50,8 @@ namespace VulkanCookbook {
                            bool                linear_filtering,
                            VkImage           & sampled_image,
                            VkDeviceMemory    & memory_object,
-                           VkImageView       & sampled_image_view );
+                           VkImageView       & sampled_image_view,
+                           bool                generate_mipmaps_with_blits = false );
 
 } // namespace VulkanCookbook
 
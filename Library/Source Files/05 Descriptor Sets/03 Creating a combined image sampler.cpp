@@ -61,13 +61,15 @@ namespace VulkanCookbook {
                                    VkSampler            & sampler,
                                    VkImage              & sampled_image,
                                    VkDeviceMemory       & memory_object,
-                                   VkImageView          & sampled_image_view ) {
+                                   VkImageView          & sampled_image_view,
+                                   bool                   generate_mipmaps_with_blits ) {
     if( !CreateSampler( logical_device, mag_filter, min_filter, mipmap_mode, u_address_mode, v_address_mode, w_address_mode, lod_bias, anisotropy_enable, max_anisotropy, compare_enable, compare_operator, min_lod, max_lod, border_color, unnormalized_coords, sampler ) ) {
       return false;
     }
 
     bool linear_filtering = (mag_filter == VK_FILTER_LINEAR) || (min_filter == VK_FILTER_LINEAR) || (mipmap_mode == VK_SAMPLER_MIPMAP_MODE_LINEAR);
-    if( !CreateSampledImage( physical_device, logical_device, type, format, size, num_mipmaps, num_layers, usage, cubemap, view_type, aspect, linear_filtering, sampled_image, memory_object, sampled_image_view ) ) {
+    if( !CreateSampledImage( physical_device, logical_device, type, format, size, num_mipmaps, num_layers, usage, cubemap, view_type, aspect, linear_filtering, sampled_image, memory_object, sampled_image_view,
+      generate_mipmaps_with_blits ) ) {
       return false;
     }
     return true;
@@ -62,7 +62,8 @@ namespace VulkanCookbook {
                                    VkSampler            & sampler,
                                    VkImage              & sampled_image,
                                    VkDeviceMemory       & memory_object,
-                                   VkImageView          & sampled_image_view );
+                                   VkImageView          & sampled_image_view,
+                                   bool                   generate_mipmaps_with_blits = false );
 
 } // namespace VulkanCookbook
 
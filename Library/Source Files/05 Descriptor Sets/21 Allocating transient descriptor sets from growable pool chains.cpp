@@ -0,0 +1,237 @@
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and / or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The below copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// Chapter: 05 Descriptor Sets
+// Recipe:  21 Allocating transient descriptor sets from growable pool chains
+
+#include <algorithm>
+#include "05 Descriptor Sets/11 Creating a descriptor pool.h"
+#include "05 Descriptor Sets/17 Resetting a descriptor pool.h"
+#include "05 Descriptor Sets/21 Allocating transient descriptor sets from growable pool chains.h"
+
+namespace VulkanCookbook {
+
+  namespace {
+
+    // VK_ERROR_OUT_OF_POOL_MEMORY_KHR, reported by drivers supporting VK_KHR_maintenance1
+    VkResult const OUT_OF_POOL_MEMORY_RESULT = static_cast<VkResult>(-1000069000);
+
+  } // namespace
+
+  DescriptorAllocator::DescriptorAllocator() :
+    LogicalDevice( VK_NULL_HANDLE ),
+    InitialSetsPerPool( 0 ),
+    MaxSetsPerPool( 0 ),
+    FrameIndex( 0 ),
+    Statistics() {
+  }
+
+  DescriptorAllocator::~DescriptorAllocator() {
+    Destroy();
+  }
+
+  bool DescriptorAllocator::Initialize( VkDevice  logical_device,
+                                        uint32_t  frames_count,
+                                        uint32_t  initial_sets_per_pool,
+                                        uint32_t  max_sets_per_pool ) {
+    Destroy();
+
+    if( (0 == frames_count) ||
+        (0 == initial_sets_per_pool) ||
+        (initial_sets_per_pool > max_sets_per_pool) ) {
+      std::cout << "Descriptor allocator requires at least one frame and non-zero, increasing pool sizes." << std::endl;
+      return false;
+    }
+
+    LogicalDevice = logical_device;
+    InitialSetsPerPool = initial_sets_per_pool;
+    MaxSetsPerPool = max_sets_per_pool;
+    FrameIndex = 0;
+    FramesPoolChains.resize( frames_count );
+    return true;
+  }
+
+  void DescriptorAllocator::Destroy() {
+    FramesPoolChains.clear();
+    BatchLayouts.clear();
+    Signatures.clear();
+    LayoutSignatures.clear();
+    LogicalDevice = VK_NULL_HANDLE;
+    FrameIndex = 0;
+  }
+
+  bool DescriptorAllocator::RegisterLayout( VkDescriptorSetLayout                             descriptor_set_layout,
+                                            std::vector<VkDescriptorSetLayoutBinding> const & bindings ) {
+    // Signature contains the total number of descriptors of each type, sorted by type
+    std::vector<VkDescriptorPoolSize> signature;
+    for( auto & binding : bindings ) {
+      auto pool_size = std::find_if( signature.begin(), signature.end(), [&]( VkDescriptorPoolSize const & size ) {
+        return size.type == binding.descriptorType;
+      } );
+      if( signature.end() == pool_size ) {
+        signature.push_back( { binding.descriptorType, binding.descriptorCount } );
+      } else {
+        pool_size->descriptorCount += binding.descriptorCount;
+      }
+    }
+    std::sort( signature.begin(), signature.end(), []( VkDescriptorPoolSize const & left, VkDescriptorPoolSize const & right ) {
+      return left.type < right.type;
+    } );
+
+    auto equal_signature = std::find_if( Signatures.begin(), Signatures.end(), [&]( std::vector<VkDescriptorPoolSize> const & other ) {
+      return (signature.size() == other.size()) &&
+             std::equal( signature.begin(), signature.end(), other.begin(), []( VkDescriptorPoolSize const & left, VkDescriptorPoolSize const & right ) {
+               return (left.type == right.type) && (left.descriptorCount == right.descriptorCount);
+             } );
+    } );
+    if( Signatures.end() == equal_signature ) {
+      LayoutSignatures[descriptor_set_layout] = static_cast<uint32_t>(Signatures.size());
+      Signatures.push_back( signature );
+    } else {
+      LayoutSignatures[descriptor_set_layout] = static_cast<uint32_t>(equal_signature - Signatures.begin());
+    }
+    return true;
+  }
+
+  bool DescriptorAllocator::BeginFrame( uint32_t frame_index ) {
+    FrameIndex = frame_index % static_cast<uint32_t>(FramesPoolChains.size());
+    Statistics.FrameAllocatedSets = 0;
+
+    for( auto & chain : FramesPoolChains[FrameIndex] ) {
+      for( auto & pool : chain.Pools ) {
+        if( 0 == pool.AllocatedSets ) {
+          break;
+        }
+        if( !ResetDescriptorPool( LogicalDevice, *pool.Handle ) ) {
+          return false;
+        }
+        pool.AllocatedSets = 0;
+        ++Statistics.PoolResets;
+      }
+      chain.Current = 0;
+    }
+    return true;
+  }
+
+  bool DescriptorAllocator::Allocate( VkDescriptorSetLayout   descriptor_set_layout,
+                                      uint32_t                count,
+                                      VkDescriptorSet       * descriptor_sets ) {
+    auto layout_signature = LayoutSignatures.find( descriptor_set_layout );
+    if( LayoutSignatures.end() == layout_signature ) {
+      std::cout << "Could not allocate descriptor sets for a layout which wasn't registered." << std::endl;
+      return false;
+    }
+    uint32_t signature = layout_signature->second;
+
+    auto & chains = FramesPoolChains[FrameIndex];
+    if( chains.size() <= signature ) {
+      chains.resize( signature + 1 );
+    }
+    auto & chain = chains[signature];
+
+    // Sets are allocated in batches limited by the space left in the current pool
+    while( count > 0 ) {
+      if( (chain.Current == chain.Pools.size()) &&
+          !AddPool( signature, chain ) ) {
+        return false;
+      }
+      Pool & pool = chain.Pools[chain.Current];
+      uint32_t batch_size = std::min( count, pool.Capacity - pool.AllocatedSets );
+      if( 0 == batch_size ) {
+        ++chain.Current;
+        continue;
+      }
+
+      BatchLayouts.assign( batch_size, descriptor_set_layout );
+      VkDescriptorSetAllocateInfo descriptor_set_allocate_info = {
+        VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,   // VkStructureType                  sType
+        nullptr,                                          // const void                     * pNext
+        *pool.Handle,                                     // VkDescriptorPool                 descriptorPool
+        batch_size,                                       // uint32_t                         descriptorSetCount
+        BatchLayouts.data()                               // const VkDescriptorSetLayout    * pSetLayouts
+      };
+
+      VkResult result = vkAllocateDescriptorSets( LogicalDevice, &descriptor_set_allocate_info, descriptor_sets );
+      if( (VK_ERROR_FRAGMENTED_POOL == result) ||
+          (OUT_OF_POOL_MEMORY_RESULT == result) ) {
+        // Pool can't provide more sets, even though its capacity wasn't reached - the next one is used
+        pool.AllocatedSets = pool.Capacity;
+        ++chain.Current;
+        ++Statistics.PoolExhaustions;
+        continue;
+      } else if( VK_SUCCESS != result ) {
+        std::cout << "Could not allocate descriptor sets." << std::endl;
+        return false;
+      }
+
+      pool.AllocatedSets += batch_size;
+      descriptor_sets += batch_size;
+      count -= batch_size;
+      Statistics.AllocatedSets += batch_size;
+      Statistics.FrameAllocatedSets += batch_size;
+      if( pool.AllocatedSets == pool.Capacity ) {
+        ++chain.Current;
+        ++Statistics.PoolExhaustions;
+      }
+    }
+    return true;
+  }
+
+  bool DescriptorAllocator::Allocate( VkDescriptorSetLayout   descriptor_set_layout,
+                                      VkDescriptorSet       & descriptor_set ) {
+    return Allocate( descriptor_set_layout, 1, &descriptor_set );
+  }
+
+  DescriptorAllocatorStatistics DescriptorAllocator::GetStatistics() const {
+    return Statistics;
+  }
+
+  bool DescriptorAllocator::AddPool( uint32_t    signature,
+                                     PoolChain & chain ) {
+    // Each new pool of a chain is twice as big as the previous one
+    uint32_t capacity = chain.Pools.empty() ? InitialSetsPerPool : std::min( 2 * chain.Pools.back().Capacity, MaxSetsPerPool );
+
+    std::vector<VkDescriptorPoolSize> pool_sizes = Signatures[signature];
+    for( auto & pool_size : pool_sizes ) {
+      pool_size.descriptorCount *= capacity;
+    }
+    if( pool_sizes.empty() ) {
+      // Pools require at least one descriptor type, even for layouts without any bindings
+      pool_sizes.push_back( { VK_DESCRIPTOR_TYPE_SAMPLER, 1 } );
+    }
+
+    Pool pool;
+    InitVkDestroyer( LogicalDevice, pool.Handle );
+    if( !CreateDescriptorPool( LogicalDevice, false, capacity, pool_sizes, *pool.Handle ) ) {
+      return false;
+    }
+    pool.Capacity = capacity;
+    pool.AllocatedSets = 0;
+    chain.Pools.push_back( std::move( pool ) );
+    ++Statistics.CreatedPools;
+    return true;
+  }
+
+} // namespace VulkanCookbook
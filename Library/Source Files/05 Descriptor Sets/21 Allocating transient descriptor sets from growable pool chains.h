@@ -0,0 +1,105 @@
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and / or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The below copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// Chapter: 05 Descriptor Sets
+// Recipe:  21 Allocating transient descriptor sets from growable pool chains
+
+#ifndef ALLOCATING_TRANSIENT_DESCRIPTOR_SETS_FROM_GROWABLE_POOL_CHAINS
+#define ALLOCATING_TRANSIENT_DESCRIPTOR_SETS_FROM_GROWABLE_POOL_CHAINS
+
+#include <unordered_map>
+#include "Common.h"
+
+namespace VulkanCookbook {
+
+  struct DescriptorAllocatorStatistics {
+    uint64_t  AllocatedSets;
+    uint32_t  FrameAllocatedSets;     // allocated since the most recent BeginFrame()
+    uint32_t  CreatedPools;
+    uint64_t  PoolResets;
+    uint64_t  PoolExhaustions;        // allocations which had to move to the next pool of a chain
+  };
+
+  // Descriptor sets are allocated for the duration of one frame. Each frame in flight keeps a chain of
+  // pools for each layout signature (the numbers of descriptors of each type); layouts with equal
+  // signatures share chains. When a pool is full, the next pool in the chain is used and a new, bigger
+  // pool is created when the chain is exhausted. BeginFrame() resets all pools used by the frame
+  // with a single vkResetDescriptorPool() call per pool, so sets are never freed individually;
+  // it can be called only after the previous submission of that frame has finished.
+
+  class DescriptorAllocator {
+  public:
+    DescriptorAllocator();
+    ~DescriptorAllocator();
+
+    bool  Initialize( VkDevice  logical_device,
+                      uint32_t  frames_count,
+                      uint32_t  initial_sets_per_pool = 64,
+                      uint32_t  max_sets_per_pool = 4096 );
+    void  Destroy();
+    bool  RegisterLayout( VkDescriptorSetLayout                             descriptor_set_layout,
+                          std::vector<VkDescriptorSetLayoutBinding> const & bindings );
+    bool  BeginFrame( uint32_t frame_index );
+    bool  Allocate( VkDescriptorSetLayout   descriptor_set_layout,
+                    uint32_t                count,
+                    VkDescriptorSet       * descriptor_sets );
+    bool  Allocate( VkDescriptorSetLayout   descriptor_set_layout,
+                    VkDescriptorSet       & descriptor_set );
+
+    DescriptorAllocatorStatistics GetStatistics() const;
+
+    DescriptorAllocator( DescriptorAllocator const & ) = delete;
+    DescriptorAllocator& operator=( DescriptorAllocator const & ) = delete;
+
+  private:
+    struct Pool {
+      VkDestroyer(VkDescriptorPool)  Handle;
+      uint32_t                       Capacity;
+      uint32_t                       AllocatedSets;
+    };
+
+    struct PoolChain {
+      std::vector<Pool>              Pools;
+      size_t                         Current;
+    };
+
+    bool  AddPool( uint32_t    signature,
+                   PoolChain & chain );
+
+    VkDevice                                                  LogicalDevice;
+    uint32_t                                                  InitialSetsPerPool;
+    uint32_t                                                  MaxSetsPerPool;
+    uint32_t                                                  FrameIndex;
+    std::vector<std::vector<VkDescriptorPoolSize>>            Signatures;
+    std::unordered_map<VkDescriptorSetLayout, uint32_t>       LayoutSignatures;
+    std::vector<std::vector<PoolChain>>                       FramesPoolChains;
+    // Reused by every allocation, so layouts of a batch don't require a memory allocation
+    std::vector<VkDescriptorSetLayout>                        BatchLayouts;
+    DescriptorAllocatorStatistics                             Statistics;
+  };
+
+} // namespace VulkanCookbook
+
+#endif // ALLOCATING_TRANSIENT_DESCRIPTOR_SETS_FROM_GROWABLE_POOL_CHAINS
@@ -0,0 +1,184 @@
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and / or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The below copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// Chapter: 05 Descriptor Sets
+// Recipe:  22 Batching descriptor set updates
+
+#include <functional>
+#include "05 Descriptor Sets/22 Batching descriptor set updates.h"
+
+namespace VulkanCookbook {
+
+  DescriptorWriteBatch::DescriptorWriteBatch() :
+    Statistics() {
+  }
+
+  VkDescriptorImageInfo * DescriptorWriteBatch::WriteImages( VkDescriptorSet   descriptor_set,
+                                                             uint32_t          binding,
+                                                             uint32_t          array_element,
+                                                             VkDescriptorType  descriptor_type,
+                                                             uint32_t          descriptor_count ) {
+    VkDescriptorImageInfo * image_infos = ImageInfos.Allocate( descriptor_count );
+    AddWrite( descriptor_set, binding, array_element, descriptor_type, descriptor_count ).pImageInfo = image_infos;
+    return image_infos;
+  }
+
+  VkDescriptorBufferInfo * DescriptorWriteBatch::WriteBuffers( VkDescriptorSet   descriptor_set,
+                                                               uint32_t          binding,
+                                                               uint32_t          array_element,
+                                                               VkDescriptorType  descriptor_type,
+                                                               uint32_t          descriptor_count ) {
+    VkDescriptorBufferInfo * buffer_infos = BufferInfos.Allocate( descriptor_count );
+    AddWrite( descriptor_set, binding, array_element, descriptor_type, descriptor_count ).pBufferInfo = buffer_infos;
+    return buffer_infos;
+  }
+
+  VkBufferView * DescriptorWriteBatch::WriteTexelBuffers( VkDescriptorSet   descriptor_set,
+                                                          uint32_t          binding,
+                                                          uint32_t          array_element,
+                                                          VkDescriptorType  descriptor_type,
+                                                          uint32_t          descriptor_count ) {
+    VkBufferView * buffer_views = TexelBufferViews.Allocate( descriptor_count );
+    AddWrite( descriptor_set, binding, array_element, descriptor_type, descriptor_count ).pTexelBufferView = buffer_views;
+    return buffer_views;
+  }
+
+  void DescriptorWriteBatch::WriteImage( VkDescriptorSet   descriptor_set,
+                                         uint32_t          binding,
+                                         VkDescriptorType  descriptor_type,
+                                         VkSampler         sampler,
+                                         VkImageView       image_view,
+                                         VkImageLayout     image_layout ) {
+    *WriteImages( descriptor_set, binding, 0, descriptor_type, 1 ) = {
+      sampler,                // VkSampler        sampler
+      image_view,             // VkImageView      imageView
+      image_layout            // VkImageLayout    imageLayout
+    };
+  }
+
+  void DescriptorWriteBatch::WriteBuffer( VkDescriptorSet   descriptor_set,
+                                          uint32_t          binding,
+                                          VkDescriptorType  descriptor_type,
+                                          VkBuffer          buffer,
+                                          VkDeviceSize      offset,
+                                          VkDeviceSize      range ) {
+    *WriteBuffers( descriptor_set, binding, 0, descriptor_type, 1 ) = {
+      buffer,                 // VkBuffer         buffer
+      offset,                 // VkDeviceSize     offset
+      range                   // VkDeviceSize     range
+    };
+  }
+
+  void DescriptorWriteBatch::WriteTexelBuffer( VkDescriptorSet   descriptor_set,
+                                               uint32_t          binding,
+                                               VkDescriptorType  descriptor_type,
+                                               VkBufferView      buffer_view ) {
+    *WriteTexelBuffers( descriptor_set, binding, 0, descriptor_type, 1 ) = buffer_view;
+  }
+
+  void DescriptorWriteBatch::Flush( VkDevice logical_device ) {
+    if( Writes.empty() ) {
+      return;
+    }
+
+    // Writes are visited from the last one; a write whose target was already visited is replaced by a later one.
+    // Targets are kept in an open addressing hash table, reused between flushes, which stores indices of writes
+    size_t table_size = 16;
+    while( table_size < 2 * Writes.size() ) {
+      table_size *= 2;
+    }
+    TargetTable.assign( table_size, UINT32_MAX );
+
+    for( size_t i = Writes.size(); i-- > 0; ) {
+      VkWriteDescriptorSet & write = Writes[i];
+      uint64_t hash = std::hash<VkDescriptorSet>()( write.dstSet );
+      hash = (hash ^ write.dstBinding) * 1099511628211ULL;
+      hash = (hash ^ write.dstArrayElement) * 1099511628211ULL;
+      hash = (hash ^ write.descriptorCount) * 1099511628211ULL;
+
+      for( size_t slot = (hash ^ (hash >> 32)) & (table_size - 1); ; slot = (slot + 1) & (table_size - 1) ) {
+        if( UINT32_MAX == TargetTable[slot] ) {
+          TargetTable[slot] = static_cast<uint32_t>(i);
+          break;
+        }
+        VkWriteDescriptorSet const & later = Writes[TargetTable[slot]];
+        if( (write.dstSet == later.dstSet) &&
+            (write.dstBinding == later.dstBinding) &&
+            (write.dstArrayElement == later.dstArrayElement) &&
+            (write.descriptorCount == later.descriptorCount) ) {
+          write.descriptorCount = 0;
+          ++Statistics.DiscardedWriteCount;
+          break;
+        }
+      }
+    }
+
+    auto last = std::remove_if( Writes.begin(), Writes.end(), []( VkWriteDescriptorSet const & write ) {
+      return 0 == write.descriptorCount;
+    } );
+    Writes.erase( last, Writes.end() );
+
+    for( auto & write : Writes ) {
+      Statistics.DescriptorCount += write.descriptorCount;
+    }
+    ++Statistics.FlushCount;
+
+    vkUpdateDescriptorSets( logical_device, static_cast<uint32_t>(Writes.size()), Writes.data(), 0, nullptr );
+    Clear();
+  }
+
+  void DescriptorWriteBatch::Clear() {
+    Writes.clear();
+    ImageInfos.Reset();
+    BufferInfos.Reset();
+    TexelBufferViews.Reset();
+  }
+
+  DescriptorWriteBatchStatistics DescriptorWriteBatch::GetStatistics() const {
+    return Statistics;
+  }
+
+  VkWriteDescriptorSet & DescriptorWriteBatch::AddWrite( VkDescriptorSet   descriptor_set,
+                                                         uint32_t          binding,
+                                                         uint32_t          array_element,
+                                                         VkDescriptorType  descriptor_type,
+                                                         uint32_t          descriptor_count ) {
+    ++Statistics.WriteCount;
+    Writes.push_back( {
+      VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,   // VkStructureType                  sType
+      nullptr,                                  // const void                     * pNext
+      descriptor_set,                           // VkDescriptorSet                  dstSet
+      binding,                                  // uint32_t                         dstBinding
+      array_element,                            // uint32_t                         dstArrayElement
+      descriptor_count,                         // uint32_t                         descriptorCount
+      descriptor_type,                          // VkDescriptorType                 descriptorType
+      nullptr,                                  // const VkDescriptorImageInfo    * pImageInfo
+      nullptr,                                  // const VkDescriptorBufferInfo   * pBufferInfo
+      nullptr                                   // const VkBufferView             * pTexelBufferView
+    } );
+    return Writes.back();
+  }
+
+} // namespace VulkanCookbook
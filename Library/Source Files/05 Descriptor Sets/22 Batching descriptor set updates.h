@@ -0,0 +1,144 @@
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and / or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The below copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// Chapter: 05 Descriptor Sets
+// Recipe:  22 Batching descriptor set updates
+
+#ifndef BATCHING_DESCRIPTOR_SET_UPDATES
+#define BATCHING_DESCRIPTOR_SET_UPDATES
+
+#include <algorithm>
+#include "Common.h"
+
+namespace VulkanCookbook {
+
+  struct DescriptorWriteBatchStatistics {
+    uint64_t  WriteCount;
+    uint64_t  DiscardedWriteCount;    // writes replaced by a later write to the same descriptors
+    uint64_t  FlushCount;
+    uint64_t  DescriptorCount;        // descriptors updated by all flushes
+  };
+
+  // Descriptor writes are accumulated and submitted with a single vkUpdateDescriptorSets() call.
+  // Image, buffer and texel buffer infos are stored in arenas made of fixed-size blocks, so pointers
+  // returned by Write*() functions stay valid until Flush() or Clear(). Blocks are kept between
+  // flushes, so after the first frames recording writes doesn't allocate memory. When multiple
+  // writes target the same set, binding, array element and descriptor count, only the last one is
+  // submitted; all other writes are submitted in the order they were recorded.
+
+  class DescriptorWriteBatch {
+  public:
+    DescriptorWriteBatch();
+
+    VkDescriptorImageInfo * WriteImages( VkDescriptorSet   descriptor_set,
+                                         uint32_t          binding,
+                                         uint32_t          array_element,
+                                         VkDescriptorType  descriptor_type,
+                                         uint32_t          descriptor_count );
+    VkDescriptorBufferInfo * WriteBuffers( VkDescriptorSet   descriptor_set,
+                                           uint32_t          binding,
+                                           uint32_t          array_element,
+                                           VkDescriptorType  descriptor_type,
+                                           uint32_t          descriptor_count );
+    VkBufferView * WriteTexelBuffers( VkDescriptorSet   descriptor_set,
+                                      uint32_t          binding,
+                                      uint32_t          array_element,
+                                      VkDescriptorType  descriptor_type,
+                                      uint32_t          descriptor_count );
+    void  WriteImage( VkDescriptorSet   descriptor_set,
+                      uint32_t          binding,
+                      VkDescriptorType  descriptor_type,
+                      VkSampler         sampler,
+                      VkImageView       image_view,
+                      VkImageLayout     image_layout );
+    void  WriteBuffer( VkDescriptorSet   descriptor_set,
+                       uint32_t          binding,
+                       VkDescriptorType  descriptor_type,
+                       VkBuffer          buffer,
+                       VkDeviceSize      offset,
+                       VkDeviceSize      range );
+    void  WriteTexelBuffer( VkDescriptorSet   descriptor_set,
+                            uint32_t          binding,
+                            VkDescriptorType  descriptor_type,
+                            VkBufferView      buffer_view );
+    void  Flush( VkDevice logical_device );
+    void  Clear();
+
+    DescriptorWriteBatchStatistics GetStatistics() const;
+
+    DescriptorWriteBatch( DescriptorWriteBatch const & ) = delete;
+    DescriptorWriteBatch& operator=( DescriptorWriteBatch const & ) = delete;
+
+  private:
+    template<typename InfoType>
+    struct InfoArena {
+      std::vector<std::vector<InfoType>>  Blocks;
+      size_t                              CurrentBlock;
+
+      InfoArena() :
+        CurrentBlock( 0 ) {
+      }
+
+      InfoType * Allocate( uint32_t count ) {
+        // Blocks never grow beyond their reserved capacity, so elements are never moved
+        while( CurrentBlock < Blocks.size() ) {
+          auto & block = Blocks[CurrentBlock];
+          if( block.capacity() - block.size() >= count ) {
+            block.resize( block.size() + count );
+            return &block[block.size() - count];
+          }
+          ++CurrentBlock;
+        }
+        Blocks.emplace_back();
+        Blocks.back().reserve( std::max<size_t>( 256, count ) );
+        Blocks.back().resize( count );
+        return Blocks.back().data();
+      }
+
+      void Reset() {
+        for( auto & block : Blocks ) {
+          block.clear();
+        }
+        CurrentBlock = 0;
+      }
+    };
+
+    VkWriteDescriptorSet & AddWrite( VkDescriptorSet   descriptor_set,
+                                     uint32_t          binding,
+                                     uint32_t          array_element,
+                                     VkDescriptorType  descriptor_type,
+                                     uint32_t          descriptor_count );
+
+    InfoArena<VkDescriptorImageInfo>    ImageInfos;
+    InfoArena<VkDescriptorBufferInfo>   BufferInfos;
+    InfoArena<VkBufferView>             TexelBufferViews;
+    std::vector<VkWriteDescriptorSet>   Writes;
+    std::vector<uint32_t>               TargetTable;
+    DescriptorWriteBatchStatistics      Statistics;
+  };
+
+} // namespace VulkanCookbook
+
+#endif // BATCHING_DESCRIPTOR_SET_UPDATES
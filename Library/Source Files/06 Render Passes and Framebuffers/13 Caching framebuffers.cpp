@@ -0,0 +1,145 @@
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and / or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The below copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// Chapter: 06 Render Passes and Framebuffers
+// Recipe:  13 Caching framebuffers
+
+#include "06 Render Passes and Framebuffers/05 Creating a framebuffer.h"
+#include "06 Render Passes and Framebuffers/13 Caching framebuffers.h"
+
+namespace VulkanCookbook {
+
+  FramebufferCache::FramebufferCache() :
+    Hits( 0 ),
+    Misses( 0 ) {
+  }
+
+  bool FramebufferCache::GetFramebuffer( VkDevice                         logical_device,
+                                         VkRenderPass                     render_pass,
+                                         std::vector<VkImageView> const & attachments,
+                                         uint32_t                         width,
+                                         uint32_t                         height,
+                                         uint32_t                         layers,
+                                         VkFramebuffer                  & framebuffer ) {
+    return GetFramebuffer( logical_device, render_pass, attachments.data(), static_cast<uint32_t>(attachments.size()), width, height, layers, framebuffer );
+  }
+
+  bool FramebufferCache::GetFramebuffer( VkDevice                         logical_device,
+                                         VkRenderPass                     render_pass,
+                                         VkImageView const              * attachments,
+                                         uint32_t                         attachments_count,
+                                         uint32_t                         width,
+                                         uint32_t                         height,
+                                         uint32_t                         layers,
+                                         VkFramebuffer                  & framebuffer ) {
+    KeyView key = {
+      render_pass,        // VkRenderPass           RenderPass
+      attachments,        // VkImageView const    * Attachments
+      attachments_count,  // uint32_t               AttachmentsCount
+      width,              // uint32_t               Width
+      height,             // uint32_t               Height
+      layers              // uint32_t               Layers
+    };
+
+    auto cached = std::lower_bound( Framebuffers.begin(), Framebuffers.end(), key, []( Entry const & entry, KeyView const & view ) {
+      return Compare( entry.Description, view ) < 0;
+    } );
+    if( (Framebuffers.end() != cached) &&
+        (0 == Compare( cached->Description, key )) ) {
+      ++Hits;
+      framebuffer = *cached->Framebuffer;
+      return true;
+    }
+
+    ++Misses;
+    std::vector<VkImageView> attachments_copy( attachments, attachments + attachments_count );
+    VkDestroyer(VkFramebuffer) new_framebuffer;
+    InitVkDestroyer( logical_device, new_framebuffer );
+    if( !CreateFramebuffer( logical_device, render_pass, attachments_copy, width, height, layers, *new_framebuffer ) ) {
+      return false;
+    }
+    framebuffer = *new_framebuffer;
+    Entry entry = {
+      {
+        render_pass,                    // VkRenderPass                 RenderPass
+        std::move( attachments_copy ),  // std::vector<VkImageView>     Attachments
+        width,                          // uint32_t                     Width
+        height,                         // uint32_t                     Height
+        layers                          // uint32_t                     Layers
+      },
+      std::move( new_framebuffer )      // VkDestroyer(VkFramebuffer)   Framebuffer
+    };
+    Framebuffers.insert( cached, std::move( entry ) );
+    return true;
+  }
+
+  void FramebufferCache::Clear() {
+    Framebuffers.clear();
+  }
+
+  void FramebufferCache::Clear( DeferredDestructionQueue & deferred_destruction_queue ) {
+    for( auto & entry : Framebuffers ) {
+      deferred_destruction_queue.Retire( std::move( entry.Framebuffer ) );
+    }
+    Framebuffers.clear();
+  }
+
+  void FramebufferCache::ResetStatistics() {
+    Hits = 0;
+    Misses = 0;
+  }
+
+  FramebufferCacheStatistics FramebufferCache::GetStatistics() const {
+    return {
+      Hits,                                             // uint64_t   Hits
+      Misses,                                           // uint64_t   Misses
+      static_cast<uint32_t>(Framebuffers.size())        // uint32_t   FramebufferCount
+    };
+  }
+
+  int FramebufferCache::Compare( Key const     & key,
+                                 KeyView const & view ) {
+    if( key.RenderPass != view.RenderPass ) {
+      return key.RenderPass < view.RenderPass ? -1 : 1;
+    }
+    if( key.Width != view.Width ) {
+      return key.Width < view.Width ? -1 : 1;
+    }
+    if( key.Height != view.Height ) {
+      return key.Height < view.Height ? -1 : 1;
+    }
+    if( key.Layers != view.Layers ) {
+      return key.Layers < view.Layers ? -1 : 1;
+    }
+    if( std::lexicographical_compare( key.Attachments.begin(), key.Attachments.end(), view.Attachments, view.Attachments + view.AttachmentsCount ) ) {
+      return -1;
+    }
+    if( std::lexicographical_compare( view.Attachments, view.Attachments + view.AttachmentsCount, key.Attachments.begin(), key.Attachments.end() ) ) {
+      return 1;
+    }
+    return 0;
+  }
+
+} // namespace VulkanCookbook
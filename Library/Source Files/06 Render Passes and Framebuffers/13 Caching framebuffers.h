@@ -0,0 +1,109 @@
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and / or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The below copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// Chapter: 06 Render Passes and Framebuffers
+// Recipe:  13 Caching framebuffers
+
+#ifndef CACHING_FRAMEBUFFERS
+#define CACHING_FRAMEBUFFERS
+
+#include <algorithm>
+#include "03 Command Buffers and Synchronization/21 Deferring destruction of objects used by frames in flight.h"
+
+namespace VulkanCookbook {
+
+  struct FramebufferCacheStatistics {
+    uint64_t  Hits;
+    uint64_t  Misses;
+    uint32_t  FramebufferCount;
+  };
+
+  // Framebuffers are cached by render pass, attachments, size and number of layers.
+  // Cache must be cleared whenever any of the attachments' image views is destroyed, as handles
+  // may be reused by a driver. The sample framework clears it only when a swapchain is recreated
+  // (in CreateSwapchain()), so samples destroying other attachments must clear it themselves.
+  // Framebuffers still used by frames in flight can be handed over to a deferred destruction queue.
+  // Cached framebuffers are kept sorted, so a lookup compares the provided attachments in place
+  // and they are copied only when a new framebuffer is created.
+
+  class FramebufferCache {
+  public:
+    FramebufferCache();
+
+    bool  GetFramebuffer( VkDevice                         logical_device,
+                          VkRenderPass                     render_pass,
+                          std::vector<VkImageView> const & attachments,
+                          uint32_t                         width,
+                          uint32_t                         height,
+                          uint32_t                         layers,
+                          VkFramebuffer                  & framebuffer );
+    bool  GetFramebuffer( VkDevice                         logical_device,
+                          VkRenderPass                     render_pass,
+                          VkImageView const              * attachments,
+                          uint32_t                         attachments_count,
+                          uint32_t                         width,
+                          uint32_t                         height,
+                          uint32_t                         layers,
+                          VkFramebuffer                  & framebuffer );
+    void  Clear();
+    void  Clear( DeferredDestructionQueue & deferred_destruction_queue );
+    void  ResetStatistics();
+
+    FramebufferCacheStatistics GetStatistics() const;
+
+  private:
+    struct Key {
+      VkRenderPass              RenderPass;
+      std::vector<VkImageView>  Attachments;
+      uint32_t                  Width;
+      uint32_t                  Height;
+      uint32_t                  Layers;
+    };
+
+    struct KeyView {
+      VkRenderPass              RenderPass;
+      VkImageView const       * Attachments;
+      uint32_t                  AttachmentsCount;
+      uint32_t                  Width;
+      uint32_t                  Height;
+      uint32_t                  Layers;
+    };
+
+    struct Entry {
+      Key                         Description;
+      VkDestroyer(VkFramebuffer)  Framebuffer;
+    };
+
+    static int  Compare( Key const     & key,
+                         KeyView const & view );
+
+    std::vector<Entry>  Framebuffers;
+    uint64_t            Hits;
+    uint64_t            Misses;
+  };
+
+} // namespace VulkanCookbook
+
+#endif // CACHING_FRAMEBUFFERS
@@ -26,6 +26,7 @@
 // Chapter: 08 Graphics and Compute Pipelines
 // Recipe:  22 Creating multiple graphics pipelines on multiple threads
 
+#include <chrono>
 #include "08 Graphics and Compute Pipelines/14 Creating a pipeline cache object.h"
 #include "08 Graphics and Compute Pipelines/15 Retrieving data from a pipeline cache.h"
 #include "08 Graphics and Compute Pipelines/16 Merging multiple pipeline cache objects.h"
@@ -35,6 +36,55 @@
 
 namespace VulkanCookbook {
 
+  namespace {
+
+    bool CreatePipelinesUsingSeparateCaches( VkDevice                                                       logical_device,
+                                             std::vector<unsigned char> const                             & cache_data,
+                                             std::vector<std::vector<VkGraphicsPipelineCreateInfo>> const & graphics_pipelines_create_infos,
+                                             std::vector<std::vector<VkPipeline>>                         & graphics_pipelines,
+                                             std::vector<VkDestroyer(VkPipelineCache)>                    & pipeline_caches ) {
+      // Create cache for each thread, initialize its contents with data loaded from file
+      pipeline_caches.resize( graphics_pipelines_create_infos.size() );
+      for( size_t i = 0; i < graphics_pipelines_create_infos.size(); ++i ) {
+        pipeline_caches[i] = VkDestroyer(VkPipelineCache)();
+        InitVkDestroyer( logical_device, pipeline_caches[i] );
+        if( !CreatePipelineCacheObject( logical_device, cache_data, *pipeline_caches[i] ) ) {
+          return false;
+        }
+      }
+
+      // Create multiple threads, where each thread creates multiple pipelines using its own cache
+      std::vector<std::thread> threads( graphics_pipelines_create_infos.size() );
+      for( size_t i = 0; i < graphics_pipelines_create_infos.size(); ++i ) {
+        graphics_pipelines[i].resize( graphics_pipelines_create_infos[i].size() );
+        threads[i] = std::thread( CreateGraphicsPipelines, logical_device, std::ref( graphics_pipelines_create_infos[i] ), *pipeline_caches[i], std::ref( graphics_pipelines[i] ) );
+      }
+
+      // Wait for all threads to finish
+      for( size_t i = 0; i < graphics_pipelines_create_infos.size(); ++i ) {
+        threads[i].join();
+      }
+      return true;
+    }
+
+    bool MergePipelineCaches( VkDevice                                          logical_device,
+                              std::vector<VkDestroyer(VkPipelineCache)> const & pipeline_caches,
+                              VkPipelineCache                                 & target_cache ) {
+      // Merge all the caches into one
+      target_cache = *pipeline_caches.back();
+      std::vector<VkPipelineCache> source_caches( pipeline_caches.size() - 1);
+      for( size_t i = 0; i < pipeline_caches.size() - 1; ++i ) {
+        source_caches[i] = *pipeline_caches[i];
+      }
+
+      if( !MergeMultiplePipelineCacheObjects( logical_device, target_cache, source_caches ) ) {
+        return false;
+      }
+      return true;
+    }
+
+  } // namespace
+
   bool CreateMultipleGraphicsPipelinesOnMultipleThreads( VkDevice                                                       logical_device,
                                                          std::string const                                            & pipeline_cache_filename,
                                                          std::vector<std::vector<VkGraphicsPipelineCreateInfo>> const & graphics_pipelines_create_infos,
@@ -43,47 +93,73 @@ namespace VulkanCookbook {
     std::vector<unsigned char> cache_data;
     GetBinaryFileContents( pipeline_cache_filename, cache_data );
 
-    // Create cache for each thread, initialize its contents with data loaded from file
-    std::vector<VkDestroyer(VkPipelineCache)> pipeline_caches( graphics_pipelines_create_infos.size() );
-    for( size_t i = 0; i < graphics_pipelines_create_infos.size(); ++i ) {
-      pipeline_caches[i] = VkDestroyer(VkPipelineCache)();
-      InitVkDestroyer( logical_device, pipeline_caches[i] );
-      if( !CreatePipelineCacheObject( logical_device, cache_data, *pipeline_caches[i] ) ) {
-        return false;
-      }
+    std::vector<VkDestroyer(VkPipelineCache)> pipeline_caches;
+    if( !CreatePipelinesUsingSeparateCaches( logical_device, cache_data, graphics_pipelines_create_infos, graphics_pipelines, pipeline_caches ) ) {
+      return false;
     }
 
-    // Create multiple threads, where each thread creates multiple pipelines using its own cache
-    std::vector<std::thread> threads( graphics_pipelines_create_infos.size() );
-    for( size_t i = 0; i < graphics_pipelines_create_infos.size(); ++i ) {
-      graphics_pipelines[i].resize( graphics_pipelines_create_infos[i].size() );
-      threads[i] = std::thread( CreateGraphicsPipelines, logical_device, std::ref( graphics_pipelines_create_infos[i] ), *pipeline_caches[i], std::ref( graphics_pipelines[i] ) );
+    // Merge all the caches into one and store its contents in the file
+    VkPipelineCache target_cache;
+    if( !MergePipelineCaches( logical_device, pipeline_caches, target_cache ) ) {
+      return false;
     }
 
-    // Wait for all threads to finish
-    for( size_t i = 0; i < graphics_pipelines_create_infos.size(); ++i ) {
-      threads[i].join();
+    PipelineCacheStatistics statistics = {};
+    return SavePipelineCacheDataToFile( logical_device, target_cache, pipeline_cache_filename, statistics );
+  }
+
+  bool CreateMultipleGraphicsPipelinesOnMultipleThreads( VkPhysicalDevice                                               physical_device,
+                                                         VkDevice                                                       logical_device,
+                                                         std::string const                                            & pipeline_cache_filename,
+                                                         std::vector<std::vector<VkGraphicsPipelineCreateInfo>> const & graphics_pipelines_create_infos,
+                                                         std::vector<std::vector<VkPipeline>>                         & graphics_pipelines ) {
+    // Cache data is validated, loaded and stored in the same way, only the statistics are ignored
+    PipelineCacheStatistics statistics;
+    return CreateMultipleGraphicsPipelinesOnMultipleThreads( physical_device, logical_device, pipeline_cache_filename, graphics_pipelines_create_infos,
+      graphics_pipelines, statistics );
+  }
+
+  bool CreateMultipleGraphicsPipelinesOnMultipleThreads( VkPhysicalDevice                                               physical_device,
+                                                         VkDevice                                                       logical_device,
+                                                         std::string const                                            & pipeline_cache_filename,
+                                                         std::vector<std::vector<VkGraphicsPipelineCreateInfo>> const & graphics_pipelines_create_infos,
+                                                         std::vector<std::vector<VkPipeline>>                         & graphics_pipelines,
+                                                         PipelineCacheStatistics                                      & statistics ) {
+    statistics = {};
+
+    // Load cache from file (if available and compatible with the device)
+    std::vector<unsigned char> cache_data;
+    LoadPipelineCacheDataFromFile( physical_device, pipeline_cache_filename, cache_data, statistics );
+
+    auto creation_start = std::chrono::high_resolution_clock::now();
+    std::vector<VkDestroyer(VkPipelineCache)> pipeline_caches;
+    if( !CreatePipelinesUsingSeparateCaches( logical_device, cache_data, graphics_pipelines_create_infos, graphics_pipelines, pipeline_caches ) ) {
+      return false;
     }
+    statistics.CreationTime = std::chrono::duration<float>( std::chrono::high_resolution_clock::now() - creation_start ).count();
 
-    // Merge all the caches into one, retrieve its contents and store them in the file
-    VkPipelineCache target_cache = *pipeline_caches.back();
-    std::vector<VkPipelineCache> source_caches( pipeline_caches.size() - 1);
-    for( size_t i = 0; i < pipeline_caches.size() - 1; ++i ) {
-      source_caches[i] = *pipeline_caches[i];
+    // A cache which didn't grow means all pipelines created with it were most probably found in the loaded
+    // data; hits can't be told apart from misses within a single thread's cache, hence only an estimate
+    for( size_t i = 0; i < pipeline_caches.size(); ++i ) {
+      statistics.PipelineCount += static_cast<uint32_t>(graphics_pipelines_create_infos[i].size());
+      std::vector<unsigned char> thread_cache_data;
+      if( !cache_data.empty() &&
+          RetrieveDataFromPipelineCache( logical_device, *pipeline_caches[i], thread_cache_data ) &&
+          (thread_cache_data.size() <= cache_data.size()) ) {
+        statistics.EstimatedCacheHitCount += static_cast<uint32_t>(graphics_pipelines_create_infos[i].size());
+      }
     }
 
-    if( !MergeMultiplePipelineCacheObjects( logical_device, target_cache, source_caches ) ) {
+    // Merge all the caches into one and store its contents in the file
+    VkPipelineCache target_cache;
+    if( !MergePipelineCaches( logical_device, pipeline_caches, target_cache ) ) {
       return false;
     }
 
-    if( !RetrieveDataFromPipelineCache( logical_device, target_cache, cache_data ) ) {
+    if( !SavePipelineCacheDataToFile( logical_device, target_cache, pipeline_cache_filename, statistics ) ) {
       return false;
     }
 
-    //if( !SaveBinaryFile( pipeline_cache_filename, cache_data ) ) {
-    //  return false;
-    //}
-
     return true;
   }
 
@@ -29,15 +29,35 @@
 #ifndef CREATING_MULTIPLE_GRAPHICS_PIPELINES_ON_MULTIPLE_THREADS
 #define CREATING_MULTIPLE_GRAPHICS_PIPELINES_ON_MULTIPLE_THREADS
 
+#include "08 Graphics and Compute Pipelines/27 Storing pipeline cache data in a file.h"
 #include "Common.h"
 
 namespace VulkanCookbook {
 
+  // Cache data loaded from a file is handed to the driver as is - implementations ignore data
+  // which they didn't create
+
   bool CreateMultipleGraphicsPipelinesOnMultipleThreads( VkDevice                                                       logical_device,
                                                          std::string const                                            & pipeline_cache_filename,
                                                          std::vector<std::vector<VkGraphicsPipelineCreateInfo>> const & graphics_pipelines_create_infos,
                                                          std::vector<std::vector<VkPipeline>>                         & graphics_pipelines );
 
+  // Cache data loaded from a file is used only if it was created by the same device and driver,
+  // merged cache is stored in the file and statistics allow to measure how much time the cache saves
+
+  bool CreateMultipleGraphicsPipelinesOnMultipleThreads( VkPhysicalDevice                                               physical_device,
+                                                         VkDevice                                                       logical_device,
+                                                         std::string const                                            & pipeline_cache_filename,
+                                                         std::vector<std::vector<VkGraphicsPipelineCreateInfo>> const & graphics_pipelines_create_infos,
+                                                         std::vector<std::vector<VkPipeline>>                         & graphics_pipelines );
+
+  bool CreateMultipleGraphicsPipelinesOnMultipleThreads( VkPhysicalDevice                                               physical_device,
+                                                         VkDevice                                                       logical_device,
+                                                         std::string const                                            & pipeline_cache_filename,
+                                                         std::vector<std::vector<VkGraphicsPipelineCreateInfo>> const & graphics_pipelines_create_infos,
+                                                         std::vector<std::vector<VkPipeline>>                         & graphics_pipelines,
+                                                         PipelineCacheStatistics                                      & statistics );
+
 } // namespace VulkanCookbook
 
 #endif // CREATING_MULTIPLE_GRAPHICS_PIPELINES_ON_MULTIPLE_THREADS
\ No newline at end of file
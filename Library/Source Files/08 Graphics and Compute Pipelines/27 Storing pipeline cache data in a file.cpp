@@ -0,0 +1,109 @@
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and / or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The below copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// Chapter: 08 Graphics and Compute Pipelines
+// Recipe:  27 Storing pipeline cache data in a file
+
+#include <chrono>
+#include "01 Instance and Devices/12 Getting features and properties of a physical device.h"
+#include "08 Graphics and Compute Pipelines/15 Retrieving data from a pipeline cache.h"
+#include "08 Graphics and Compute Pipelines/27 Storing pipeline cache data in a file.h"
+#include "Tools.h"
+
+namespace VulkanCookbook {
+
+  bool IsPipelineCacheDataCompatible( VkPhysicalDevice                   physical_device,
+                                      std::vector<unsigned char> const & cache_data ) {
+    // Header layout (version one):
+    // uint32_t headerSize, uint32_t headerVersion, uint32_t vendorID, uint32_t deviceID, uint8_t pipelineCacheUUID[VK_UUID_SIZE]
+    size_t const minimal_header_size = 4 * sizeof( uint32_t ) + VK_UUID_SIZE;
+    if( cache_data.size() < minimal_header_size ) {
+      return false;
+    }
+
+    uint32_t header[4];
+    std::memcpy( header, cache_data.data(), sizeof( header ) );
+    uint32_t header_size = header[0];
+    uint32_t header_version = header[1];
+    uint32_t vendor_id = header[2];
+    uint32_t device_id = header[3];
+
+    if( (header_size < minimal_header_size) ||
+        (header_size > cache_data.size()) ||
+        (VK_PIPELINE_CACHE_HEADER_VERSION_ONE != header_version) ) {
+      return false;
+    }
+
+    VkPhysicalDeviceFeatures device_features;
+    VkPhysicalDeviceProperties device_properties;
+    GetFeaturesAndPropertiesOfPhysicalDevice( physical_device, device_features, device_properties );
+
+    if( (device_properties.vendorID != vendor_id) ||
+        (device_properties.deviceID != device_id) ||
+        (0 != std::memcmp( device_properties.pipelineCacheUUID, cache_data.data() + sizeof( header ), VK_UUID_SIZE )) ) {
+      return false;
+    }
+    return true;
+  }
+
+  bool LoadPipelineCacheDataFromFile( VkPhysicalDevice             physical_device,
+                                      std::string const          & filename,
+                                      std::vector<unsigned char> & cache_data,
+                                      PipelineCacheStatistics    & statistics ) {
+    auto load_start = std::chrono::high_resolution_clock::now();
+
+    bool loaded = GetBinaryFileContents( filename, cache_data );
+    statistics.StaleDataDropped = false;
+    if( loaded &&
+        !IsPipelineCacheDataCompatible( physical_device, cache_data ) ) {
+      // Cache was created with a different device or driver (e.g. after a driver upgrade)
+      std::cout << "Pipeline cache data stored in the '" << filename << "' file is not compatible with the current device. It will be ignored." << std::endl;
+      cache_data.clear();
+      statistics.StaleDataDropped = true;
+      loaded = false;
+    }
+
+    statistics.LoadedDataSize = cache_data.size();
+    statistics.LoadTime = std::chrono::duration<float>( std::chrono::high_resolution_clock::now() - load_start ).count();
+    return loaded;
+  }
+
+  bool SavePipelineCacheDataToFile( VkDevice                  logical_device,
+                                    VkPipelineCache           pipeline_cache,
+                                    std::string const       & filename,
+                                    PipelineCacheStatistics & statistics ) {
+    std::vector<unsigned char> cache_data;
+    if( !RetrieveDataFromPipelineCache( logical_device, pipeline_cache, cache_data ) ) {
+      return false;
+    }
+
+    if( !SaveBinaryFile( filename, cache_data ) ) {
+      return false;
+    }
+    statistics.SavedDataSize = cache_data.size();
+    return true;
+  }
+
+} // namespace VulkanCookbook
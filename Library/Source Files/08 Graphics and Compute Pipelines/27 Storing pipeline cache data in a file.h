@@ -0,0 +1,68 @@
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and / or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The below copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// Chapter: 08 Graphics and Compute Pipelines
+// Recipe:  27 Storing pipeline cache data in a file
+
+#ifndef STORING_PIPELINE_CACHE_DATA_IN_A_FILE
+#define STORING_PIPELINE_CACHE_DATA_IN_A_FILE
+
+#include "Common.h"
+
+namespace VulkanCookbook {
+
+  // Implementations don't report cache hits. All pipelines created with a cache which didn't grow
+  // are counted as hits and all pipelines created with a cache which grew are counted as misses,
+  // so the hit count is only an estimate.
+
+  struct PipelineCacheStatistics {
+    float     LoadTime;
+    bool      StaleDataDropped;
+    size_t    LoadedDataSize;
+    size_t    SavedDataSize;
+    float     CreationTime;
+    uint32_t  PipelineCount;
+    uint32_t  EstimatedCacheHitCount;
+  };
+
+  // Pipeline cache data starts with a header identifying the implementation which created it.
+  // Data created by a different vendor, device or driver version (pipeline cache UUID) is useless.
+
+  bool IsPipelineCacheDataCompatible( VkPhysicalDevice                   physical_device,
+                                      std::vector<unsigned char> const & cache_data );
+
+  bool LoadPipelineCacheDataFromFile( VkPhysicalDevice             physical_device,
+                                      std::string const          & filename,
+                                      std::vector<unsigned char> & cache_data,
+                                      PipelineCacheStatistics    & statistics );
+
+  bool SavePipelineCacheDataToFile( VkDevice                  logical_device,
+                                    VkPipelineCache           pipeline_cache,
+                                    std::string const       & filename,
+                                    PipelineCacheStatistics & statistics );
+
+} // namespace VulkanCookbook
+
+#endif // STORING_PIPELINE_CACHE_DATA_IN_A_FILE
@@ -0,0 +1,184 @@
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and / or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The below copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// Chapter: 08 Graphics and Compute Pipelines
+// Recipe:  28 Caching descriptor set layouts and pipeline layouts
+
+#include <algorithm>
+#include <cstring>
+#include "05 Descriptor Sets/10 Creating a descriptor set layout.h"
+#include "08 Graphics and Compute Pipelines/12 Creating a pipeline layout.h"
+#include "08 Graphics and Compute Pipelines/28 Caching descriptor set layouts and pipeline layouts.h"
+
+namespace VulkanCookbook {
+
+  namespace {
+
+    // Non-dispatchable handles are pointers or 64-bit integers, depending on a platform
+    template<typename VkType>
+    uint64_t HandleToKey( VkType handle ) {
+      uint64_t value = 0;
+      std::memcpy( &value, &handle, sizeof( handle ) );
+      return value;
+    }
+
+  } // namespace
+
+  LayoutCache::LayoutCache() :
+    LogicalDevice( VK_NULL_HANDLE ),
+    Statistics() {
+  }
+
+  LayoutCache::~LayoutCache() {
+    Destroy();
+  }
+
+  void LayoutCache::Initialize( VkDevice logical_device ) {
+    Destroy();
+
+    std::lock_guard<std::mutex> lock( Mutex );
+    LogicalDevice = logical_device;
+    Statistics = {};
+  }
+
+  void LayoutCache::Destroy() {
+    std::lock_guard<std::mutex> lock( Mutex );
+    // Layouts still referenced by their users are destroyed when the last reference is released
+    PipelineLayouts.clear();
+    DescriptorSetLayouts.clear();
+    LogicalDevice = VK_NULL_HANDLE;
+  }
+
+  bool LayoutCache::GetDescriptorSetLayout( std::vector<VkDescriptorSetLayoutBinding> const    & bindings,
+                                            std::shared_ptr<VkDestroyer(VkDescriptorSetLayout)> & descriptor_set_layout ) {
+    std::vector<VkDescriptorSetLayoutBinding const *> sorted_bindings;
+    for( auto & binding : bindings ) {
+      sorted_bindings.push_back( &binding );
+    }
+    std::sort( sorted_bindings.begin(), sorted_bindings.end(), []( VkDescriptorSetLayoutBinding const * left, VkDescriptorSetLayoutBinding const * right ) {
+      return left->binding < right->binding;
+    } );
+
+    std::vector<uint64_t> key;
+    key.reserve( 4 * bindings.size() );
+    for( auto binding : sorted_bindings ) {
+      key.push_back( binding->binding );
+      key.push_back( static_cast<uint64_t>(binding->descriptorType) );
+      key.push_back( binding->descriptorCount );
+      key.push_back( binding->stageFlags );
+
+      bool sampler_type = (VK_DESCRIPTOR_TYPE_SAMPLER == binding->descriptorType) ||
+                          (VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER == binding->descriptorType);
+      if( sampler_type &&
+          (nullptr != binding->pImmutableSamplers) ) {
+        key.push_back( binding->descriptorCount );
+        for( uint32_t i = 0; i < binding->descriptorCount; ++i ) {
+          key.push_back( HandleToKey( binding->pImmutableSamplers[i] ) );
+        }
+      } else {
+        key.push_back( 0 );
+      }
+    }
+
+    std::lock_guard<std::mutex> lock( Mutex );
+    auto cached = DescriptorSetLayouts.find( key );
+    if( DescriptorSetLayouts.end() != cached ) {
+      ++Statistics.DescriptorSetLayoutHits;
+      descriptor_set_layout = cached->second;
+      return true;
+    }
+
+    // Layouts are created while the lock is held, so concurrent requests for the same layout create only one object
+    ++Statistics.DescriptorSetLayoutMisses;
+    std::shared_ptr<VkDestroyer(VkDescriptorSetLayout)> new_layout( new VkDestroyer(VkDescriptorSetLayout)() );
+    InitVkDestroyer( LogicalDevice, *new_layout );
+    if( !CreateDescriptorSetLayout( LogicalDevice, bindings, **new_layout ) ) {
+      return false;
+    }
+    DescriptorSetLayouts.emplace( std::move( key ), new_layout );
+    Statistics.DescriptorSetLayoutCount = static_cast<uint32_t>(DescriptorSetLayouts.size());
+    descriptor_set_layout = new_layout;
+    return true;
+  }
+
+  bool LayoutCache::GetPipelineLayout( std::vector<VkDescriptorSetLayout> const       & descriptor_set_layouts,
+                                       std::vector<VkPushConstantRange> const         & push_constant_ranges,
+                                       std::shared_ptr<VkDestroyer(VkPipelineLayout)> & pipeline_layout ) {
+    std::vector<uint64_t> key;
+    key.reserve( 1 + descriptor_set_layouts.size() + 3 * push_constant_ranges.size() );
+    key.push_back( descriptor_set_layouts.size() );
+    for( auto & descriptor_set_layout : descriptor_set_layouts ) {
+      key.push_back( HandleToKey( descriptor_set_layout ) );
+    }
+    for( auto & push_constant_range : push_constant_ranges ) {
+      key.push_back( push_constant_range.stageFlags );
+      key.push_back( push_constant_range.offset );
+      key.push_back( push_constant_range.size );
+    }
+
+    std::lock_guard<std::mutex> lock( Mutex );
+    auto cached = PipelineLayouts.find( key );
+    if( PipelineLayouts.end() != cached ) {
+      ++Statistics.PipelineLayoutHits;
+      pipeline_layout = cached->second;
+      return true;
+    }
+
+    ++Statistics.PipelineLayoutMisses;
+    std::shared_ptr<VkDestroyer(VkPipelineLayout)> new_layout( new VkDestroyer(VkPipelineLayout)() );
+    InitVkDestroyer( LogicalDevice, *new_layout );
+    if( !CreatePipelineLayout( LogicalDevice, descriptor_set_layouts, push_constant_ranges, **new_layout ) ) {
+      return false;
+    }
+    PipelineLayouts.emplace( std::move( key ), new_layout );
+    Statistics.PipelineLayoutCount = static_cast<uint32_t>(PipelineLayouts.size());
+    pipeline_layout = new_layout;
+    return true;
+  }
+
+  void LayoutCache::ResetStatistics() {
+    std::lock_guard<std::mutex> lock( Mutex );
+    Statistics.DescriptorSetLayoutHits = 0;
+    Statistics.DescriptorSetLayoutMisses = 0;
+    Statistics.PipelineLayoutHits = 0;
+    Statistics.PipelineLayoutMisses = 0;
+  }
+
+  LayoutCacheStatistics LayoutCache::GetStatistics() const {
+    std::lock_guard<std::mutex> lock( Mutex );
+    return Statistics;
+  }
+
+  size_t LayoutCache::KeyHash::operator()( std::vector<uint64_t> const & key ) const {
+    // 64-bit FNV-1a over all words of a key
+    uint64_t hash = 14695981039346656037ULL;
+    for( auto word : key ) {
+      hash ^= word;
+      hash *= 1099511628211ULL;
+    }
+    return static_cast<size_t>(hash);
+  }
+
+} // namespace VulkanCookbook
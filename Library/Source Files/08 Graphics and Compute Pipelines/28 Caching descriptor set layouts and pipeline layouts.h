@@ -0,0 +1,89 @@
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and / or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The below copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// Chapter: 08 Graphics and Compute Pipelines
+// Recipe:  28 Caching descriptor set layouts and pipeline layouts
+
+#ifndef CACHING_DESCRIPTOR_SET_LAYOUTS_AND_PIPELINE_LAYOUTS
+#define CACHING_DESCRIPTOR_SET_LAYOUTS_AND_PIPELINE_LAYOUTS
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include "Common.h"
+
+namespace VulkanCookbook {
+
+  struct LayoutCacheStatistics {
+    uint64_t  DescriptorSetLayoutHits;
+    uint64_t  DescriptorSetLayoutMisses;
+    uint32_t  DescriptorSetLayoutCount;
+    uint64_t  PipelineLayoutHits;
+    uint64_t  PipelineLayoutMisses;
+    uint32_t  PipelineLayoutCount;
+  };
+
+  // Descriptor set layouts are cached by their bindings (including immutable samplers), pipeline
+  // layouts by their descriptor set layouts and push constant ranges. Equal requests return the
+  // same, shared handle, so pipelines created with them remain layout-compatible. Order of bindings
+  // doesn't matter, order of push constant ranges does. Pipeline layouts should be created from set
+  // layouts acquired from the same cache, so their handles can't be destroyed and reused.
+  // All functions may be called from multiple threads at the same time.
+
+  class LayoutCache {
+  public:
+    LayoutCache();
+    ~LayoutCache();
+
+    void  Initialize( VkDevice logical_device );
+    void  Destroy();
+    bool  GetDescriptorSetLayout( std::vector<VkDescriptorSetLayoutBinding> const    & bindings,
+                                  std::shared_ptr<VkDestroyer(VkDescriptorSetLayout)> & descriptor_set_layout );
+    bool  GetPipelineLayout( std::vector<VkDescriptorSetLayout> const       & descriptor_set_layouts,
+                             std::vector<VkPushConstantRange> const         & push_constant_ranges,
+                             std::shared_ptr<VkDestroyer(VkPipelineLayout)> & pipeline_layout );
+    void  ResetStatistics();
+
+    LayoutCacheStatistics GetStatistics() const;
+
+    LayoutCache( LayoutCache const & ) = delete;
+    LayoutCache& operator=( LayoutCache const & ) = delete;
+
+  private:
+    // Key is a flat sequence of all parameters defining a layout
+    struct KeyHash {
+      size_t operator()( std::vector<uint64_t> const & key ) const;
+    };
+
+    VkDevice                                                                                          LogicalDevice;
+    std::unordered_map<std::vector<uint64_t>, std::shared_ptr<VkDestroyer(VkDescriptorSetLayout)>, KeyHash>  DescriptorSetLayouts;
+    std::unordered_map<std::vector<uint64_t>, std::shared_ptr<VkDestroyer(VkPipelineLayout)>, KeyHash>       PipelineLayouts;
+    LayoutCacheStatistics                                                                             Statistics;
+    mutable std::mutex                                                                                Mutex;
+  };
+
+} // namespace VulkanCookbook
+
+#endif // CACHING_DESCRIPTOR_SET_LAYOUTS_AND_PIPELINE_LAYOUTS
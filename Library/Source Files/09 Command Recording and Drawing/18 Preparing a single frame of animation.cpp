@@ -29,10 +29,77 @@
 #include "02 Image Presentation/15 Acquiring a swapchain image.h"
 #include "02 Image Presentation/16 Presenting an image.h"
 #include "06 Render Passes and Framebuffers/05 Creating a framebuffer.h"
+#include "06 Render Passes and Framebuffers/13 Caching framebuffers.h"
 #include "09 Command Recording and Drawing/18 Preparing a single frame of animation.h"
 
 namespace VulkanCookbook {
 
+  namespace {
+
+    bool PrepareFrame( DeviceDispatch const                                          & dispatch,
+                       VkDevice                                                        logical_device,
+                       VkQueue                                                         graphics_queue,
+                       VkQueue                                                         present_queue,
+                       VkSwapchainKHR                                                  swapchain,
+                       std::vector<VkImageView> const                                & swapchain_image_views,
+                       VkImageView                                                     depth_attachment,
+                       std::vector<WaitSemaphoreInfo> const                          & wait_infos,
+                       VkSemaphore                                                     image_acquired_semaphore,
+                       VkSemaphore                                                     ready_to_present_semaphore,
+                       VkFence                                                         finished_drawing_fence,
+                       std::function<bool(VkCommandBuffer, uint32_t, VkFramebuffer)>   record_command_buffer,
+                       VkCommandBuffer                                                 command_buffer,
+                       uint32_t                                                        frame_index,
+                       std::function<bool(VkImageView const *, uint32_t, VkFramebuffer &)> get_framebuffer ) {
+      // Without a swapchain (in a headless mode) frames are rendered into offscreen images, so there is nothing
+      // to acquire, wait for or present. Image is selected by the index of frame resources, so it is used
+      // by a single frame in flight - the one which waited on the frame's fence
+      bool offscreen = (VK_NULL_HANDLE == swapchain);
+
+      uint32_t image_index;
+      if( offscreen ) {
+        image_index = frame_index % static_cast<uint32_t>(swapchain_image_views.size());
+      } else if( !AcquireSwapchainImage( dispatch, logical_device, swapchain, image_acquired_semaphore, VK_NULL_HANDLE, image_index ) ) {
+        return false;
+      }
+
+      // Attachments are gathered on the stack, so no memory is allocated when a framebuffer is found in a cache
+      VkImageView attachments[] = { swapchain_image_views[image_index], depth_attachment };
+      uint32_t attachments_count = (VK_NULL_HANDLE != depth_attachment) ? 2 : 1;
+      VkFramebuffer framebuffer;
+      if( !get_framebuffer( attachments, attachments_count, framebuffer ) ) {
+        return false;
+      }
+
+      if( !record_command_buffer( command_buffer, image_index, framebuffer ) ) {
+        return false;
+      }
+
+      if( offscreen ) {
+        return SubmitCommandBuffersToQueue( dispatch, graphics_queue, wait_infos, { command_buffer }, {}, finished_drawing_fence );
+      }
+
+      std::vector<WaitSemaphoreInfo> wait_semaphore_infos = wait_infos;
+      wait_semaphore_infos.push_back( {
+        image_acquired_semaphore,                     // VkSemaphore            Semaphore
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT // VkPipelineStageFlags   WaitingStage
+      } );
+      if( !SubmitCommandBuffersToQueue( dispatch, graphics_queue, wait_semaphore_infos, { command_buffer }, { ready_to_present_semaphore }, finished_drawing_fence ) ) {
+        return false;
+      }
+
+      PresentInfo present_info = {
+        swapchain,                                    // VkSwapchainKHR         Swapchain
+        image_index                                   // uint32_t               ImageIndex
+      };
+      if( !PresentImage( dispatch, present_queue, { ready_to_present_semaphore }, { present_info } ) ) {
+        return false;
+      }
+      return true;
+    }
+
+  }
+
   bool PrepareSingleFrameOfAnimation( VkDevice                                                        logical_device,
                                       VkQueue                                                         graphics_queue,
                                       VkQueue                                                         present_queue,
@@ -46,42 +113,126 @@ namespace VulkanCookbook {
                                       VkFence                                                         finished_drawing_fence,
                                       std::function<bool(VkCommandBuffer, uint32_t, VkFramebuffer)>   record_command_buffer,
                                       VkCommandBuffer                                                 command_buffer,
+                                      uint32_t                                                        frame_index,
                                       VkRenderPass                                                    render_pass,
                                       VkDestroyer(VkFramebuffer)                                    & framebuffer ) {
-    uint32_t image_index;
-    if( !AcquireSwapchainImage( logical_device, swapchain, image_acquired_semaphore, VK_NULL_HANDLE, image_index ) ) {
-      return false;
-    }
-
-    std::vector<VkImageView> attachments = { swapchain_image_views[image_index] };
-    if( VK_NULL_HANDLE != depth_attachment ) {
-      attachments.push_back( depth_attachment );
-    }
-    if( !CreateFramebuffer( logical_device, render_pass, attachments, swapchain_size.width, swapchain_size.height, 1, *framebuffer ) ) {
-      return false;
-    }
+    auto create_framebuffer = [&]( VkImageView const * attachments, uint32_t attachments_count, VkFramebuffer & current_framebuffer ) {
+      if( !CreateFramebuffer( logical_device, render_pass, { attachments, attachments + attachments_count }, swapchain_size.width, swapchain_size.height, 1, *framebuffer ) ) {
+        return false;
+      }
+      current_framebuffer = *framebuffer;
+      return true;
+    };
 
-    if( !record_command_buffer( command_buffer, image_index, *framebuffer ) ) {
-      return false;
-    }
+    return PrepareFrame( DefaultDeviceDispatch, logical_device, graphics_queue, present_queue, swapchain, swapchain_image_views, depth_attachment, wait_infos,
+      image_acquired_semaphore, ready_to_present_semaphore, finished_drawing_fence, record_command_buffer, command_buffer, frame_index, create_framebuffer );
+  }
 
-    std::vector<WaitSemaphoreInfo> wait_semaphore_infos = wait_infos;
-    wait_semaphore_infos.push_back( {
-      image_acquired_semaphore,                     // VkSemaphore            Semaphore
-      VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT // VkPipelineStageFlags   WaitingStage
-    } );
-    if( !SubmitCommandBuffersToQueue( graphics_queue, wait_semaphore_infos, { command_buffer }, { ready_to_present_semaphore }, finished_drawing_fence ) ) {
-      return false;
-    }
+  bool PrepareSingleFrameOfAnimation( VkDevice                                                        logical_device,
+                                      VkQueue                                                         graphics_queue,
+                                      VkQueue                                                         present_queue,
+                                      VkSwapchainKHR                                                  swapchain,
+                                      VkExtent2D                                                      swapchain_size,
+                                      std::vector<VkImageView> const                                & swapchain_image_views,
+                                      VkImageView                                                     depth_attachment,
+                                      std::vector<WaitSemaphoreInfo> const                          & wait_infos,
+                                      VkSemaphore                                                     image_acquired_semaphore,
+                                      VkSemaphore                                                     ready_to_present_semaphore,
+                                      VkFence                                                         finished_drawing_fence,
+                                      std::function<bool(VkCommandBuffer, uint32_t, VkFramebuffer)>   record_command_buffer,
+                                      VkCommandBuffer                                                 command_buffer,
+                                      uint32_t                                                        frame_index,
+                                      VkRenderPass                                                    render_pass,
+                                      FramebufferCache                                              & framebuffer_cache ) {
+    return PrepareSingleFrameOfAnimation( DefaultDeviceDispatch, logical_device, graphics_queue, present_queue, swapchain, swapchain_size, swapchain_image_views,
+      depth_attachment, wait_infos, image_acquired_semaphore, ready_to_present_semaphore, finished_drawing_fence, std::move( record_command_buffer ), command_buffer,
+      frame_index, render_pass, framebuffer_cache );
+  }
 
-    PresentInfo present_info = {
-      swapchain,                                    // VkSwapchainKHR         Swapchain
-      image_index                                   // uint32_t               ImageIndex
+  bool PrepareSingleFrameOfAnimation( DeviceDispatch const                                          & dispatch,
+                                      VkDevice                                                        logical_device,
+                                      VkQueue                                                         graphics_queue,
+                                      VkQueue                                                         present_queue,
+                                      VkSwapchainKHR                                                  swapchain,
+                                      VkExtent2D                                                      swapchain_size,
+                                      std::vector<VkImageView> const                                & swapchain_image_views,
+                                      VkImageView                                                     depth_attachment,
+                                      std::vector<WaitSemaphoreInfo> const                          & wait_infos,
+                                      VkSemaphore                                                     image_acquired_semaphore,
+                                      VkSemaphore                                                     ready_to_present_semaphore,
+                                      VkFence                                                         finished_drawing_fence,
+                                      std::function<bool(VkCommandBuffer, uint32_t, VkFramebuffer)>   record_command_buffer,
+                                      VkCommandBuffer                                                 command_buffer,
+                                      uint32_t                                                        frame_index,
+                                      VkRenderPass                                                    render_pass,
+                                      FramebufferCache                                              & framebuffer_cache ) {
+    auto get_cached_framebuffer = [&]( VkImageView const * attachments, uint32_t attachments_count, VkFramebuffer & current_framebuffer ) {
+      return framebuffer_cache.GetFramebuffer( logical_device, render_pass, attachments, attachments_count, swapchain_size.width, swapchain_size.height, 1, current_framebuffer );
     };
-    if( !PresentImage( present_queue, { ready_to_present_semaphore }, { present_info } ) ) {
-      return false;
-    }
-    return true;
+
+    return PrepareFrame( dispatch, logical_device, graphics_queue, present_queue, swapchain, swapchain_image_views, depth_attachment, wait_infos,
+      image_acquired_semaphore, ready_to_present_semaphore, finished_drawing_fence, record_command_buffer, command_buffer, frame_index, get_cached_framebuffer );
+  }
+
+  bool PrepareSingleFrameOfAnimation( VkDevice                                                        logical_device,
+                                      VkQueue                                                         graphics_queue,
+                                      VkQueue                                                         present_queue,
+                                      VkSwapchainKHR                                                  swapchain,
+                                      VkExtent2D                                                      swapchain_size,
+                                      std::vector<VkImageView> const                                & swapchain_image_views,
+                                      VkImageView                                                     depth_attachment,
+                                      std::vector<WaitSemaphoreInfo> const                          & wait_infos,
+                                      VkSemaphore                                                     image_acquired_semaphore,
+                                      VkSemaphore                                                     ready_to_present_semaphore,
+                                      VkFence                                                         finished_drawing_fence,
+                                      std::function<bool(VkCommandBuffer, uint32_t, VkFramebuffer)>   record_command_buffer,
+                                      VkCommandBuffer                                                 command_buffer,
+                                      VkRenderPass                                                    render_pass,
+                                      VkDestroyer(VkFramebuffer)                                    & framebuffer ) {
+    return PrepareSingleFrameOfAnimation( logical_device, graphics_queue, present_queue, swapchain, swapchain_size, swapchain_image_views, depth_attachment,
+      wait_infos, image_acquired_semaphore, ready_to_present_semaphore, finished_drawing_fence, std::move( record_command_buffer ), command_buffer, 0,
+      render_pass, framebuffer );
+  }
+
+  bool PrepareSingleFrameOfAnimation( VkDevice                                                        logical_device,
+                                      VkQueue                                                         graphics_queue,
+                                      VkQueue                                                         present_queue,
+                                      VkSwapchainKHR                                                  swapchain,
+                                      VkExtent2D                                                      swapchain_size,
+                                      std::vector<VkImageView> const                                & swapchain_image_views,
+                                      VkImageView                                                     depth_attachment,
+                                      std::vector<WaitSemaphoreInfo> const                          & wait_infos,
+                                      VkSemaphore                                                     image_acquired_semaphore,
+                                      VkSemaphore                                                     ready_to_present_semaphore,
+                                      VkFence                                                         finished_drawing_fence,
+                                      std::function<bool(VkCommandBuffer, uint32_t, VkFramebuffer)>   record_command_buffer,
+                                      VkCommandBuffer                                                 command_buffer,
+                                      VkRenderPass                                                    render_pass,
+                                      FramebufferCache                                              & framebuffer_cache ) {
+    return PrepareSingleFrameOfAnimation( DefaultDeviceDispatch, logical_device, graphics_queue, present_queue, swapchain, swapchain_size, swapchain_image_views,
+      depth_attachment, wait_infos, image_acquired_semaphore, ready_to_present_semaphore, finished_drawing_fence, std::move( record_command_buffer ), command_buffer,
+      0, render_pass, framebuffer_cache );
+  }
+
+  bool PrepareSingleFrameOfAnimation( DeviceDispatch const                                          & dispatch,
+                                      VkDevice                                                        logical_device,
+                                      VkQueue                                                         graphics_queue,
+                                      VkQueue                                                         present_queue,
+                                      VkSwapchainKHR                                                  swapchain,
+                                      VkExtent2D                                                      swapchain_size,
+                                      std::vector<VkImageView> const                                & swapchain_image_views,
+                                      VkImageView                                                     depth_attachment,
+                                      std::vector<WaitSemaphoreInfo> const                          & wait_infos,
+                                      VkSemaphore                                                     image_acquired_semaphore,
+                                      VkSemaphore                                                     ready_to_present_semaphore,
+                                      VkFence                                                         finished_drawing_fence,
+                                      std::function<bool(VkCommandBuffer, uint32_t, VkFramebuffer)>   record_command_buffer,
+                                      VkCommandBuffer                                                 command_buffer,
+                                      VkRenderPass                                                    render_pass,
+                                      FramebufferCache                                              & framebuffer_cache ) {
+    return PrepareSingleFrameOfAnimation( dispatch, logical_device, graphics_queue, present_queue, swapchain, swapchain_size, swapchain_image_views,
+      depth_attachment, wait_infos, image_acquired_semaphore, ready_to_present_semaphore, finished_drawing_fence, std::move( record_command_buffer ), command_buffer,
+      0, render_pass, framebuffer_cache );
   }
 
 } // namespace VulkanCookbook
@@ -30,6 +30,7 @@
 #define PREPARING_A_SINGLE_FRAME_OF_ANIMATION
 
 #include "03 Command Buffers and Synchronization/11 Submitting command buffers to the queue.h"
+#include "06 Render Passes and Framebuffers/13 Caching framebuffers.h"
 #include "Common.h"
 
 namespace VulkanCookbook {
@@ -50,6 +51,96 @@ namespace VulkanCookbook {
                                       VkRenderPass                                                    render_pass,
                                       VkDestroyer(VkFramebuffer)                                    & framebuffer );
 
+  bool PrepareSingleFrameOfAnimation( VkDevice                                                        logical_device,
+                                      VkQueue                                                         graphics_queue,
+                                      VkQueue                                                         present_queue,
+                                      VkSwapchainKHR                                                  swapchain,
+                                      VkExtent2D                                                      swapchain_size,
+                                      std::vector<VkImageView> const                                & swapchain_image_views,
+                                      VkImageView                                                     depth_attachment,
+                                      std::vector<WaitSemaphoreInfo> const                          & wait_infos,
+                                      VkSemaphore                                                     image_acquired_semaphore,
+                                      VkSemaphore                                                     ready_to_present_semaphore,
+                                      VkFence                                                         finished_drawing_fence,
+                                      std::function<bool(VkCommandBuffer, uint32_t, VkFramebuffer)>   record_command_buffer,
+                                      VkCommandBuffer                                                 command_buffer,
+                                      VkRenderPass                                                    render_pass,
+                                      FramebufferCache                                              & framebuffer_cache );
+
+  // Functions of a logical device are called through its dispatch table
+
+  bool PrepareSingleFrameOfAnimation( DeviceDispatch const                                          & dispatch,
+                                      VkDevice                                                        logical_device,
+                                      VkQueue                                                         graphics_queue,
+                                      VkQueue                                                         present_queue,
+                                      VkSwapchainKHR                                                  swapchain,
+                                      VkExtent2D                                                      swapchain_size,
+                                      std::vector<VkImageView> const                                & swapchain_image_views,
+                                      VkImageView                                                     depth_attachment,
+                                      std::vector<WaitSemaphoreInfo> const                          & wait_infos,
+                                      VkSemaphore                                                     image_acquired_semaphore,
+                                      VkSemaphore                                                     ready_to_present_semaphore,
+                                      VkFence                                                         finished_drawing_fence,
+                                      std::function<bool(VkCommandBuffer, uint32_t, VkFramebuffer)>   record_command_buffer,
+                                      VkCommandBuffer                                                 command_buffer,
+                                      VkRenderPass                                                    render_pass,
+                                      FramebufferCache                                              & framebuffer_cache );
+
+  // Index of frame resources selects an offscreen image when there is no swapchain (in a headless mode);
+  // overloads without it always render into the first offscreen image
+
+  bool PrepareSingleFrameOfAnimation( VkDevice                                                        logical_device,
+                                      VkQueue                                                         graphics_queue,
+                                      VkQueue                                                         present_queue,
+                                      VkSwapchainKHR                                                  swapchain,
+                                      VkExtent2D                                                      swapchain_size,
+                                      std::vector<VkImageView> const                                & swapchain_image_views,
+                                      VkImageView                                                     depth_attachment,
+                                      std::vector<WaitSemaphoreInfo> const                          & wait_infos,
+                                      VkSemaphore                                                     image_acquired_semaphore,
+                                      VkSemaphore                                                     ready_to_present_semaphore,
+                                      VkFence                                                         finished_drawing_fence,
+                                      std::function<bool(VkCommandBuffer, uint32_t, VkFramebuffer)>   record_command_buffer,
+                                      VkCommandBuffer                                                 command_buffer,
+                                      uint32_t                                                        frame_index,
+                                      VkRenderPass                                                    render_pass,
+                                      VkDestroyer(VkFramebuffer)                                    & framebuffer );
+
+  bool PrepareSingleFrameOfAnimation( VkDevice                                                        logical_device,
+                                      VkQueue                                                         graphics_queue,
+                                      VkQueue                                                         present_queue,
+                                      VkSwapchainKHR                                                  swapchain,
+                                      VkExtent2D                                                      swapchain_size,
+                                      std::vector<VkImageView> const                                & swapchain_image_views,
+                                      VkImageView                                                     depth_attachment,
+                                      std::vector<WaitSemaphoreInfo> const                          & wait_infos,
+                                      VkSemaphore                                                     image_acquired_semaphore,
+                                      VkSemaphore                                                     ready_to_present_semaphore,
+                                      VkFence                                                         finished_drawing_fence,
+                                      std::function<bool(VkCommandBuffer, uint32_t, VkFramebuffer)>   record_command_buffer,
+                                      VkCommandBuffer                                                 command_buffer,
+                                      uint32_t                                                        frame_index,
+                                      VkRenderPass                                                    render_pass,
+                                      FramebufferCache                                              & framebuffer_cache );
+
+  bool PrepareSingleFrameOfAnimation( DeviceDispatch const                                          & dispatch,
+                                      VkDevice                                                        logical_device,
+                                      VkQueue                                                         graphics_queue,
+                                      VkQueue                                                         present_queue,
+                                      VkSwapchainKHR                                                  swapchain,
+                                      VkExtent2D                                                      swapchain_size,
+                                      std::vector<VkImageView> const                                & swapchain_image_views,
+                                      VkImageView                                                     depth_attachment,
+                                      std::vector<WaitSemaphoreInfo> const                          & wait_infos,
+                                      VkSemaphore                                                     image_acquired_semaphore,
+                                      VkSemaphore                                                     ready_to_present_semaphore,
+                                      VkFence                                                         finished_drawing_fence,
+                                      std::function<bool(VkCommandBuffer, uint32_t, VkFramebuffer)>   record_command_buffer,
+                                      VkCommandBuffer                                                 command_buffer,
+                                      uint32_t                                                        frame_index,
+                                      VkRenderPass                                                    render_pass,
+                                      FramebufferCache                                              & framebuffer_cache );
+
 } // namespace VulkanCookbook
 
 #endif // PREPARING_A_SINGLE_FRAME_OF_ANIMATION
\ No newline at end of file
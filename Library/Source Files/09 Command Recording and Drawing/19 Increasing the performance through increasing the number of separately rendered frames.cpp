@@ -31,6 +31,7 @@
 #include "06 Render Passes and Framebuffers/11 Destroying a framebuffer.h"
 #include "09 Command Recording and Drawing/18 Preparing a single frame of animation.h"
 #include "09 Command Recording and Drawing/19 Increasing the performance through increasing the number of separately rendered frames.h"
+#include "09 Command Recording and Drawing/20 Pacing frames rendered in parallel.h"
 
 namespace VulkanCookbook {
 
@@ -58,7 +59,7 @@ namespace VulkanCookbook {
 
     if( !PrepareSingleFrameOfAnimation( logical_device, graphics_queue, present_queue, swapchain, swapchain_size, swapchain_image_views,
       *current_frame.DepthAttachment, wait_infos, *current_frame.ImageAcquiredSemaphore, *current_frame.ReadyToPresentSemaphore,
-      *current_frame.DrawingFinishedFence, record_command_buffer, current_frame.CommandBuffer, render_pass, current_frame.Framebuffer ) ) {
+      *current_frame.DrawingFinishedFence, record_command_buffer, current_frame.CommandBuffer, frame_index, render_pass, current_frame.Framebuffer ) ) {
       return false;
     }
 
@@ -66,4 +67,64 @@ namespace VulkanCookbook {
     return true;
   }
 
+  bool IncreasePerformanceThroughIncreasingTheNumberOfSeparatelyRenderedFrames( VkDevice                                                        logical_device,
+                                                                                VkQueue                                                         graphics_queue,
+                                                                                VkQueue                                                         present_queue,
+                                                                                VkSwapchainKHR                                                  swapchain,
+                                                                                VkExtent2D                                                      swapchain_size,
+                                                                                std::vector<VkImageView> const                                & swapchain_image_views,
+                                                                                VkRenderPass                                                    render_pass,
+                                                                                std::vector<WaitSemaphoreInfo> const                          & wait_infos,
+                                                                                std::function<bool(VkCommandBuffer, uint32_t, VkFramebuffer)>   record_command_buffer,
+                                                                                std::vector<FrameResources>                                   & frame_resources,
+                                                                                FramebufferCache                                              & framebuffer_cache,
+                                                                                FramePacer                                                    & frame_pacer,
+                                                                                CommandPoolRing                                               & command_pool_ring,
+                                                                                DescriptorAllocator                                           & transient_descriptor_sets ) {
+    return IncreasePerformanceThroughIncreasingTheNumberOfSeparatelyRenderedFrames( DefaultDeviceDispatch, logical_device, graphics_queue, present_queue, swapchain,
+      swapchain_size, swapchain_image_views, render_pass, wait_infos, std::move( record_command_buffer ), frame_resources, framebuffer_cache, frame_pacer, command_pool_ring,
+      transient_descriptor_sets );
+  }
+
+  bool IncreasePerformanceThroughIncreasingTheNumberOfSeparatelyRenderedFrames( DeviceDispatch const                                          & dispatch,
+                                                                                VkDevice                                                        logical_device,
+                                                                                VkQueue                                                         graphics_queue,
+                                                                                VkQueue                                                         present_queue,
+                                                                                VkSwapchainKHR                                                  swapchain,
+                                                                                VkExtent2D                                                      swapchain_size,
+                                                                                std::vector<VkImageView> const                                & swapchain_image_views,
+                                                                                VkRenderPass                                                    render_pass,
+                                                                                std::vector<WaitSemaphoreInfo> const                          & wait_infos,
+                                                                                std::function<bool(VkCommandBuffer, uint32_t, VkFramebuffer)>   record_command_buffer,
+                                                                                std::vector<FrameResources>                                   & frame_resources,
+                                                                                FramebufferCache                                              & framebuffer_cache,
+                                                                                FramePacer                                                    & frame_pacer,
+                                                                                CommandPoolRing                                               & command_pool_ring,
+                                                                                DescriptorAllocator                                           & transient_descriptor_sets ) {
+    if( !frame_pacer.WaitForFrame( dispatch, logical_device, frame_resources ) ) {
+      return false;
+    }
+    uint32_t frame_index = frame_pacer.GetFrameIndex();
+    FrameResources & current_frame = frame_resources[frame_index];
+
+    if( !command_pool_ring.Reset( dispatch, frame_index ) ) {
+      return false;
+    }
+    if( !transient_descriptor_sets.BeginFrame( frame_index ) ) {
+      return false;
+    }
+    VkCommandBuffer command_buffer;
+    if( !command_pool_ring.AllocateCommandBuffer( 0, frame_index, VK_COMMAND_BUFFER_LEVEL_PRIMARY, command_buffer ) ) {
+      return false;
+    }
+
+    if( !PrepareSingleFrameOfAnimation( dispatch, logical_device, graphics_queue, present_queue, swapchain, swapchain_size, swapchain_image_views,
+      *current_frame.DepthAttachment, wait_infos, *current_frame.ImageAcquiredSemaphore, *current_frame.ReadyToPresentSemaphore,
+      *current_frame.DrawingFinishedFence, record_command_buffer, command_buffer, frame_index, render_pass, framebuffer_cache ) ) {
+      return false;
+    }
+
+    return true;
+  }
+
 } // namespace VulkanCookbook
@@ -30,10 +30,15 @@
 #define INCREASING_THE_PERFORMANCE_THROUGH_INCREASING_THE_NUMBER_OF_SEPARATELY_RENDERED_FRAMES
 
 #include "03 Command Buffers and Synchronization/11 Submitting command buffers to the queue.h"
+#include "03 Command Buffers and Synchronization/20 Using a ring of command pools.h"
+#include "05 Descriptor Sets/21 Allocating transient descriptor sets from growable pool chains.h"
+#include "06 Render Passes and Framebuffers/13 Caching framebuffers.h"
 #include "Common.h"
 
 namespace VulkanCookbook {
 
+  class FramePacer;
+
   struct FrameResources {
     VkCommandBuffer             CommandBuffer;
     VkDestroyer(VkSemaphore)    ImageAcquiredSemaphore;
@@ -42,12 +47,12 @@ namespace VulkanCookbook {
     VkDestroyer(VkImageView)    DepthAttachment;
     VkDestroyer(VkFramebuffer)  Framebuffer;
 
-    FrameResources( VkCommandBuffer            & command_buffer,
-                    VkDestroyer(VkSemaphore)   & image_acquired_semaphore,
-                    VkDestroyer(VkSemaphore)   & ready_to_present_semaphore,
-                    VkDestroyer(VkFence)       & drawing_finished_fence,
-                    VkDestroyer(VkImageView)   & depth_attachment,
-                    VkDestroyer(VkFramebuffer) & framebuffer ) :
+    FrameResources( VkCommandBuffer             & command_buffer,
+                    VkDestroyer(VkSemaphore)   && image_acquired_semaphore,
+                    VkDestroyer(VkSemaphore)   && ready_to_present_semaphore,
+                    VkDestroyer(VkFence)       && drawing_finished_fence,
+                    VkDestroyer(VkImageView)   && depth_attachment,
+                    VkDestroyer(VkFramebuffer) && framebuffer ) :
       CommandBuffer( command_buffer ),
       ImageAcquiredSemaphore( std::move( image_acquired_semaphore ) ),
       ReadyToPresentSemaphore( std::move( ready_to_present_semaphore ) ),
@@ -90,6 +95,44 @@ namespace VulkanCookbook {
                                                                                 std::function<bool(VkCommandBuffer, uint32_t, VkFramebuffer)>   record_command_buffer,
                                                                                 std::vector<FrameResources>                                   & frame_resources );
 
+  // Framebuffers are taken from a cache instead of being recreated for every frame
+  // and frame pacer selects frame resources and measures how long CPU waits for GPU.
+  // Command buffers come from a ring of command pools and transient descriptor sets from
+  // per-frame descriptor pools - both are reset all at once after the frame's fence is signaled
+
+  bool IncreasePerformanceThroughIncreasingTheNumberOfSeparatelyRenderedFrames( VkDevice                                                        logical_device,
+                                                                                VkQueue                                                         graphics_queue,
+                                                                                VkQueue                                                         present_queue,
+                                                                                VkSwapchainKHR                                                  swapchain,
+                                                                                VkExtent2D                                                      swapchain_size,
+                                                                                std::vector<VkImageView> const                                & swapchain_image_views,
+                                                                                VkRenderPass                                                    render_pass,
+                                                                                std::vector<WaitSemaphoreInfo> const                          & wait_infos,
+                                                                                std::function<bool(VkCommandBuffer, uint32_t, VkFramebuffer)>   record_command_buffer,
+                                                                                std::vector<FrameResources>                                   & frame_resources,
+                                                                                FramebufferCache                                              & framebuffer_cache,
+                                                                                FramePacer                                                    & frame_pacer,
+                                                                                CommandPoolRing                                               & command_pool_ring,
+                                                                                DescriptorAllocator                                           & transient_descriptor_sets );
+
+  // All functions called for every frame go through the dispatch table of a logical device
+
+  bool IncreasePerformanceThroughIncreasingTheNumberOfSeparatelyRenderedFrames( DeviceDispatch const                                          & dispatch,
+                                                                                VkDevice                                                        logical_device,
+                                                                                VkQueue                                                         graphics_queue,
+                                                                                VkQueue                                                         present_queue,
+                                                                                VkSwapchainKHR                                                  swapchain,
+                                                                                VkExtent2D                                                      swapchain_size,
+                                                                                std::vector<VkImageView> const                                & swapchain_image_views,
+                                                                                VkRenderPass                                                    render_pass,
+                                                                                std::vector<WaitSemaphoreInfo> const                          & wait_infos,
+                                                                                std::function<bool(VkCommandBuffer, uint32_t, VkFramebuffer)>   record_command_buffer,
+                                                                                std::vector<FrameResources>                                   & frame_resources,
+                                                                                FramebufferCache                                              & framebuffer_cache,
+                                                                                FramePacer                                                    & frame_pacer,
+                                                                                CommandPoolRing                                               & command_pool_ring,
+                                                                                DescriptorAllocator                                           & transient_descriptor_sets );
+
 } // namespace VulkanCookbook
 
 #endif // INCREASING_THE_PERFORMANCE_THROUGH_INCREASING_THE_NUMBER_OF_SEPARATELY_RENDERED_FRAMES
\ No newline at end of file
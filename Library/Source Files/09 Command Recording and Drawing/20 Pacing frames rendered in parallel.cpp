@@ -0,0 +1,124 @@
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and / or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The below copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// Chapter: 09 Command Recording and Drawing
+// Recipe:  20 Pacing frames rendered in parallel
+
+#include "03 Command Buffers and Synchronization/09 Waiting for fences.h"
+#include "03 Command Buffers and Synchronization/10 Resetting fences.h"
+#include "09 Command Recording and Drawing/20 Pacing frames rendered in parallel.h"
+
+namespace VulkanCookbook {
+
+  FramePacer::FramePacer() :
+    NextFrameNumber( 0 ),
+    FrameNumber( 0 ),
+    FrameIndex( 0 ),
+    PreviousFrameStart(),
+    MeasuredFrames( 0 ),
+    TotalFrameTime( 0.0 ),
+    TotalFenceWaitTime( 0.0 ),
+    DeferredDestruction() {
+  }
+
+  bool FramePacer::WaitForFrame( VkDevice                      logical_device,
+                                 std::vector<FrameResources> & frame_resources ) {
+    return WaitForFrame( DefaultDeviceDispatch, logical_device, frame_resources );
+  }
+
+  bool FramePacer::WaitForFrame( DeviceDispatch const        & dispatch,
+                                 VkDevice                      logical_device,
+                                 std::vector<FrameResources> & frame_resources ) {
+    if( frame_resources.empty() ) {
+      std::cout << "No frame resources provided." << std::endl;
+      return false;
+    }
+
+    auto frame_start = std::chrono::high_resolution_clock::now();
+
+    uint32_t frame_index = static_cast<uint32_t>(NextFrameNumber % frame_resources.size());
+    FrameResources & current_frame = frame_resources[frame_index];
+
+    if( !WaitForFences( dispatch, logical_device, { *current_frame.DrawingFinishedFence }, false, 2000000000 ) ) {
+      return false;
+    }
+    if( !ResetFences( dispatch, logical_device, { *current_frame.DrawingFinishedFence } ) ) {
+      return false;
+    }
+
+    auto wait_end = std::chrono::high_resolution_clock::now();
+    if( 0 < NextFrameNumber ) {
+      TotalFrameTime += std::chrono::duration<double>( frame_start - PreviousFrameStart ).count();
+      TotalFenceWaitTime += std::chrono::duration<double>( wait_end - frame_start ).count();
+      ++MeasuredFrames;
+    }
+    PreviousFrameStart = frame_start;
+
+    // The fence informs that a frame submitted frame_resources.size() frames earlier is finished;
+    // fences of all frames before it were already waited on
+    uint64_t finished_frames_count = (NextFrameNumber >= frame_resources.size()) ? NextFrameNumber - frame_resources.size() + 1 : 0;
+    DeferredDestruction.BeginFrame( NextFrameNumber, finished_frames_count );
+
+    FrameIndex = frame_index;
+    FrameNumber = NextFrameNumber++;
+    return true;
+  }
+
+  uint32_t FramePacer::GetFrameIndex() const {
+    return FrameIndex;
+  }
+
+  uint64_t FramePacer::GetFrameNumber() const {
+    return FrameNumber;
+  }
+
+  bool FramePacer::IsPacingFrames() const {
+    return 0 < NextFrameNumber;
+  }
+
+  void FramePacer::ResetStatistics() {
+    MeasuredFrames = 0;
+    TotalFrameTime = 0.0;
+    TotalFenceWaitTime = 0.0;
+  }
+
+  DeferredDestructionQueue & FramePacer::GetDeferredDestructionQueue() {
+    return DeferredDestruction;
+  }
+
+  FramePacingStatistics FramePacer::GetStatistics() const {
+    FramePacingStatistics statistics = {};
+    statistics.FrameCount = MeasuredFrames;
+    if( (0 < MeasuredFrames) &&
+        (0.0 < TotalFrameTime) ) {
+      statistics.AverageFrameTime = static_cast<float>(TotalFrameTime / MeasuredFrames);
+      statistics.AverageFenceWaitTime = static_cast<float>(TotalFenceWaitTime / MeasuredFrames);
+      // Fence wait of the current frame falls into the previous frame's time span, so clamp the ratio
+      statistics.CpuGpuOverlap = static_cast<float>(1.0 - std::min( 1.0, TotalFenceWaitTime / TotalFrameTime ));
+    }
+    return statistics;
+  }
+
+} // namespace VulkanCookbook
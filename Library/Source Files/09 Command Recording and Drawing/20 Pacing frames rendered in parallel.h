@@ -0,0 +1,82 @@
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and / or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The below copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// Chapter: 09 Command Recording and Drawing
+// Recipe:  20 Pacing frames rendered in parallel
+
+#ifndef PACING_FRAMES_RENDERED_IN_PARALLEL
+#define PACING_FRAMES_RENDERED_IN_PARALLEL
+
+#include <algorithm>
+#include <chrono>
+#include "03 Command Buffers and Synchronization/21 Deferring destruction of objects used by frames in flight.h"
+#include "09 Command Recording and Drawing/19 Increasing the performance through increasing the number of separately rendered frames.h"
+
+namespace VulkanCookbook {
+
+  struct FramePacingStatistics {
+    uint64_t  FrameCount;
+    float     AverageFrameTime;
+    float     AverageFenceWaitTime;
+    float     CpuGpuOverlap;
+  };
+
+  // Selects resources of the next frame in flight and waits only for that frame's fence.
+  // Time spent blocked on the fence is measured against the whole frame time - the rest
+  // of the frame is the time in which CPU work overlapped with GPU processing.
+  // Objects retired through the pacer's deferred destruction queue are destroyed after
+  // all frames which could use them are finished.
+
+  class FramePacer {
+  public:
+    FramePacer();
+
+    bool      WaitForFrame( VkDevice                      logical_device,
+                            std::vector<FrameResources> & frame_resources );
+    bool      WaitForFrame( DeviceDispatch const        & dispatch,
+                            VkDevice                      logical_device,
+                            std::vector<FrameResources> & frame_resources );
+    uint32_t  GetFrameIndex() const;
+    uint64_t  GetFrameNumber() const;
+    bool      IsPacingFrames() const;
+    void      ResetStatistics();
+
+    DeferredDestructionQueue & GetDeferredDestructionQueue();
+    FramePacingStatistics      GetStatistics() const;
+
+  private:
+    uint64_t                                        NextFrameNumber;
+    uint64_t                                        FrameNumber;
+    uint32_t                                        FrameIndex;
+    std::chrono::high_resolution_clock::time_point  PreviousFrameStart;
+    uint64_t                                        MeasuredFrames;
+    double                                          TotalFrameTime;
+    double                                          TotalFenceWaitTime;
+    DeferredDestructionQueue                        DeferredDestruction;
+  };
+
+} // namespace VulkanCookbook
+
+#endif // PACING_FRAMES_RENDERED_IN_PARALLEL
@@ -0,0 +1,241 @@
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and / or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The below copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// Chapter: 09 Command Recording and Drawing
+// Recipe:  21 Recording command buffers on a persistent pool of threads
+
+#include "09 Command Recording and Drawing/21 Recording command buffers on a persistent pool of threads.h"
+
+namespace VulkanCookbook {
+
+  Latch::Latch( uint32_t count ) :
+    Count( count ) {
+  }
+
+  void Latch::CountDown() {
+    std::lock_guard<std::mutex> lock( Mutex );
+    if( (0 < Count) &&
+        (0 == --Count) ) {
+      Condition.notify_all();
+    }
+  }
+
+  void Latch::Wait() {
+    std::unique_lock<std::mutex> lock( Mutex );
+    Condition.wait( lock, [this]() { return 0 == Count; } );
+  }
+
+  ThreadPool::ThreadPool() :
+    FrameIndex( 0 ),
+    PendingTasks( 0 ),
+    Stop( false ),
+    NextWorker( 0 ) {
+  }
+
+  ThreadPool::~ThreadPool() {
+    Destroy();
+  }
+
+  bool ThreadPool::Initialize( VkDevice  logical_device,
+                               uint32_t  queue_family_index,
+                               uint32_t  threads_count,
+                               uint32_t  frames_count ) {
+    Destroy();
+
+    if( 0 == threads_count ) {
+      std::cout << "Thread pool must contain at least one thread." << std::endl;
+      return false;
+    }
+
+    if( !CommandPools.Initialize( logical_device, queue_family_index, threads_count, frames_count ) ) {
+      return false;
+    }
+    FrameIndex = 0;
+
+    for( uint32_t i = 0; i < threads_count; ++i ) {
+      Workers.emplace_back( new Worker() );
+    }
+
+    Stop = false;
+    for( uint32_t i = 0; i < threads_count; ++i ) {
+      Workers[i]->Thread = std::thread( &ThreadPool::Run, this, i );
+    }
+    return true;
+  }
+
+  void ThreadPool::Destroy() {
+    {
+      std::lock_guard<std::mutex> lock( Mutex );
+      Stop = true;
+    }
+    Condition.notify_all();
+
+    for( auto & worker : Workers ) {
+      if( worker->Thread.joinable() ) {
+        worker->Thread.join();
+      }
+    }
+    Workers.clear();
+    CommandPools.Destroy();
+  }
+
+  uint32_t ThreadPool::GetThreadsCount() const {
+    return static_cast<uint32_t>(Workers.size());
+  }
+
+  bool ThreadPool::IsWorkerThread() const {
+    for( auto & worker : Workers ) {
+      if( std::this_thread::get_id() == worker->Thread.get_id() ) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void ThreadPool::Execute( std::function<void( uint32_t )> task ) {
+    if( Workers.empty() ) {
+      // No workers - execute the task on the calling thread
+      task( 0 );
+      return;
+    }
+
+    // The counter is increased before the task is published - otherwise a worker could take the task
+    // and decrease the counter first, so the counter would wrap around
+    {
+      std::lock_guard<std::mutex> lock( Mutex );
+      ++PendingTasks;
+    }
+    uint32_t worker_index = NextWorker++ % static_cast<uint32_t>(Workers.size());
+    {
+      std::lock_guard<std::mutex> lock( Workers[worker_index]->TasksMutex );
+      Workers[worker_index]->Tasks.push_back( std::move( task ) );
+    }
+    Condition.notify_one();
+  }
+
+  bool ThreadPool::AcquireCommandBuffer( uint32_t          thread_index,
+                                         VkCommandBuffer & command_buffer ) {
+    // Called only from a worker's own thread, so its command pool is never accessed concurrently
+    return CommandPools.AllocateCommandBuffer( thread_index, FrameIndex, VK_COMMAND_BUFFER_LEVEL_PRIMARY, command_buffer );
+  }
+
+  bool ThreadPool::BeginFrame( uint32_t frame_index ) {
+    // Must be called when no recording task is executed and the frame's previous command buffers are no longer processed by a device
+    if( !CommandPools.Reset( frame_index ) ) {
+      return false;
+    }
+    FrameIndex = frame_index;
+    return true;
+  }
+
+  bool ThreadPool::TakeTask( uint32_t                          thread_index,
+                             std::function<void( uint32_t )> & task ) {
+    size_t workers_count = Workers.size();
+    for( size_t i = 0; i < workers_count; ++i ) {
+      Worker & worker = *Workers[(thread_index + i) % workers_count];
+      std::lock_guard<std::mutex> lock( worker.TasksMutex );
+      if( worker.Tasks.empty() ) {
+        continue;
+      }
+      // Own tasks are taken from the front, tasks of other workers are stolen from the back
+      if( 0 == i ) {
+        task = std::move( worker.Tasks.front() );
+        worker.Tasks.pop_front();
+      } else {
+        task = std::move( worker.Tasks.back() );
+        worker.Tasks.pop_back();
+      }
+      return true;
+    }
+    return false;
+  }
+
+  void ThreadPool::Run( uint32_t thread_index ) {
+    while( true ) {
+      std::function<void( uint32_t )> task;
+      if( TakeTask( thread_index, task ) ) {
+        {
+          std::lock_guard<std::mutex> lock( Mutex );
+          --PendingTasks;
+        }
+        task( thread_index );
+        continue;
+      }
+
+      std::unique_lock<std::mutex> lock( Mutex );
+      Condition.wait( lock, [this]() { return Stop || (0 < PendingTasks); } );
+      if( Stop &&
+          (0 == PendingTasks) ) {
+        return;
+      }
+    }
+  }
+
+  bool RecordCommandBuffersOnMultipleThreads( ThreadPool                                                & thread_pool,
+                                              std::vector<std::function<bool( VkCommandBuffer )>> const & recording_functions,
+                                              VkQueue                                                     queue,
+                                              std::vector<WaitSemaphoreInfo>                              wait_semaphore_infos,
+                                              std::vector<VkSemaphore>                                    signal_semaphores,
+                                              VkFence                                                     fence ) {
+    if( 0 == thread_pool.GetThreadsCount() ) {
+      std::cout << "Thread pool is not initialized." << std::endl;
+      return false;
+    }
+    if( thread_pool.IsWorkerThread() ) {
+      std::cout << "Command buffers can't be recorded on a thread pool from one of its own tasks." << std::endl;
+      return false;
+    }
+
+    std::vector<VkCommandBuffer> command_buffers( recording_functions.size(), VK_NULL_HANDLE );
+    std::vector<char> results( recording_functions.size(), 0 );
+    Latch latch( static_cast<uint32_t>(recording_functions.size()) );
+
+    for( size_t i = 0; i < recording_functions.size(); ++i ) {
+      thread_pool.Execute( [&, i]( uint32_t thread_index ) {
+        VkCommandBuffer command_buffer;
+        if( thread_pool.AcquireCommandBuffer( thread_index, command_buffer ) &&
+            recording_functions[i]( command_buffer ) ) {
+          command_buffers[i] = command_buffer;
+          results[i] = 1;
+        }
+        latch.CountDown();
+      } );
+    }
+    latch.Wait();
+
+    for( size_t i = 0; i < results.size(); ++i ) {
+      if( !results[i] ) {
+        std::cout << "Could not record command buffer number " << i << " on a thread pool." << std::endl;
+        return false;
+      }
+    }
+
+    if( !SubmitCommandBuffersToQueue( queue, wait_semaphore_infos, command_buffers, signal_semaphores, fence ) ) {
+      return false;
+    }
+    return true;
+  }
+
+} // namespace VulkanCookbook
@@ -0,0 +1,117 @@
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and / or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The below copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// Chapter: 09 Command Recording and Drawing
+// Recipe:  21 Recording command buffers on a persistent pool of threads
+
+#ifndef RECORDING_COMMAND_BUFFERS_ON_A_PERSISTENT_POOL_OF_THREADS
+#define RECORDING_COMMAND_BUFFERS_ON_A_PERSISTENT_POOL_OF_THREADS
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include "03 Command Buffers and Synchronization/20 Using a ring of command pools.h"
+#include "09 Command Recording and Drawing/17 Recording command buffers on multiple threads.h"
+
+namespace VulkanCookbook {
+
+  // Lets one thread wait until a given number of tasks signal their completion.
+  // Wait() must not be called from a task of a thread pool - a waiting worker doesn't execute
+  // other tasks, so the tasks counting the latch down may never run.
+
+  class Latch {
+  public:
+    explicit Latch( uint32_t count );
+
+    void  CountDown();
+    void  Wait();
+
+  private:
+    std::mutex               Mutex;
+    std::condition_variable  Condition;
+    uint32_t                 Count;
+  };
+
+  // Long-lived worker threads created once and reused for every frame.
+  // Each worker has its own queue of tasks and steals tasks from other workers when its own
+  // queue is empty. Each worker also owns a command pool for each frame in flight, so command
+  // buffers can be allocated and recorded on all workers at the same time without any additional
+  // synchronization. Functions which wait for their tasks check IsWorkerThread() so they are not
+  // called from a task of the same pool.
+
+  class ThreadPool {
+  public:
+    ThreadPool();
+    ~ThreadPool();
+
+    bool      Initialize( VkDevice  logical_device,
+                          uint32_t  queue_family_index,
+                          uint32_t  threads_count,
+                          uint32_t  frames_count );
+    void      Destroy();
+    uint32_t  GetThreadsCount() const;
+    bool      IsWorkerThread() const;
+    void      Execute( std::function<void( uint32_t )> task );
+    bool      AcquireCommandBuffer( uint32_t          thread_index,
+                                    VkCommandBuffer & command_buffer );
+    bool      BeginFrame( uint32_t frame_index );
+
+  private:
+    struct Worker {
+      std::thread                                    Thread;
+      std::mutex                                     TasksMutex;
+      std::deque<std::function<void( uint32_t )>>    Tasks;
+    };
+
+    bool  TakeTask( uint32_t                          thread_index,
+                    std::function<void( uint32_t )> & task );
+    void  Run( uint32_t thread_index );
+
+    CommandPoolRing                                  CommandPools;
+    uint32_t                                         FrameIndex;
+    std::vector<std::unique_ptr<Worker>>             Workers;
+    std::mutex                                       Mutex;
+    std::condition_variable                          Condition;
+    uint32_t                                         PendingTasks;
+    bool                                             Stop;
+    std::atomic<uint32_t>                            NextWorker;
+  };
+
+  // Each recording function receives a command buffer allocated from the command pool of the
+  // worker that executes it, for the frame selected with the thread pool's BeginFrame() function.
+  // Command buffers stay valid until the same frame is started again, which must not happen before
+  // the fence signals that their processing has finished.
+
+  bool RecordCommandBuffersOnMultipleThreads( ThreadPool                                                & thread_pool,
+                                              std::vector<std::function<bool( VkCommandBuffer )>> const & recording_functions,
+                                              VkQueue                                                     queue,
+                                              std::vector<WaitSemaphoreInfo>                              wait_semaphore_infos,
+                                              std::vector<VkSemaphore>                                    signal_semaphores,
+                                              VkFence                                                     fence );
+
+} // namespace VulkanCookbook
+
+#endif // RECORDING_COMMAND_BUFFERS_ON_A_PERSISTENT_POOL_OF_THREADS
@@ -26,6 +26,7 @@
 // Chapter: 10 Helper Recipes
 // Recipe:  07 Loading a 3D model from an OBJ file
 
+#include <unordered_map>
 #include "10 Helper Recipes/07 Loading a 3D model from an OBJ file.h"
 #define TINYOBJLOADER_IMPLEMENTATION
 #include "tiny_obj_loader.h"
@@ -34,7 +35,9 @@ namespace VulkanCookbook {
 
   namespace {
 
-    void GenerateTangentSpaceVectors( Mesh & mesh );
+    void GenerateTangentSpaceVectors( Mesh       & mesh,
+                                      size_t       stride,
+                                      ThreadPool * thread_pool );
 
   }
 
@@ -44,7 +47,8 @@ namespace VulkanCookbook {
                                bool         generate_tangent_space_vectors,
                                bool         unify,
                                Mesh       & mesh,
-                               uint32_t   * vertex_stride ) {
+                               uint32_t   * vertex_stride,
+                               ThreadPool * thread_pool ) {
     // Load model
     tinyobj::attrib_t                attribs;
     std::vector<tinyobj::shape_t>    shapes;
@@ -147,7 +151,7 @@ namespace VulkanCookbook {
     }
 
     if( generate_tangent_space_vectors ) {
-      GenerateTangentSpaceVectors( mesh );
+      GenerateTangentSpaceVectors( mesh, stride, thread_pool );
     }
 
     if( unify ) {
@@ -170,8 +174,71 @@ namespace VulkanCookbook {
     return true;
   }
 
+  size_t VertexHash::operator() ( uint32_t vertex ) const {
+    uint32_t const * bits = reinterpret_cast<uint32_t const *>( &Data[vertex * Stride] );
+    size_t hash = 2166136261u;
+    for( size_t i = 0; i < KeySize; ++i ) {
+      hash = (hash ^ bits[i]) * 16777619u;
+    }
+    return hash;
+  }
+
+  bool VertexEqual::operator() ( uint32_t left,
+                                 uint32_t right ) const {
+    return 0 == std::memcmp( &Data[left * Stride], &Data[right * Stride], KeySize * sizeof( float ) );
+  }
+
   namespace {
 
+    // Splits the [0, count) range into contiguous ranges processed on the threads of the thread pool
+    // or, when it isn't provided, on temporary threads created for all available cores
+
+    void ParallelFor( ThreadPool                                    * thread_pool,
+                      size_t                                          count,
+                      std::function<void( size_t, size_t )> const & function ) {
+      size_t const min_items_per_thread = 4096;
+      // Waiting for the pool on one of its own workers could block it, so temporary threads are used then
+      bool use_thread_pool = (nullptr != thread_pool) && (0 < thread_pool->GetThreadsCount()) && !thread_pool->IsWorkerThread();
+      size_t threads_count = use_thread_pool ? thread_pool->GetThreadsCount() : std::thread::hardware_concurrency();
+      if( threads_count > count / min_items_per_thread ) {
+        threads_count = count / min_items_per_thread;
+      }
+      if( threads_count < 1 ) {
+        threads_count = 1;
+      }
+      size_t const range = (count + threads_count - 1) / threads_count;
+
+      if( use_thread_pool &&
+          (1 < threads_count) ) {
+        Latch latch( static_cast<uint32_t>(threads_count) );
+        for( size_t i = 0; i < threads_count; ++i ) {
+          thread_pool->Execute( [&, i]( uint32_t ) {
+            size_t begin = i * range;
+            size_t end = begin + range < count ? begin + range : count;
+            if( begin < end ) {
+              function( begin, end );
+            }
+            latch.CountDown();
+          } );
+        }
+        latch.Wait();
+        return;
+      }
+
+      std::vector<std::thread> threads;
+      for( size_t i = 1; i < threads_count; ++i ) {
+        size_t begin = i * range;
+        size_t end = begin + range < count ? begin + range : count;
+        if( begin < end ) {
+          threads.emplace_back( function, begin, end );
+        }
+      }
+      function( 0, range < count ? range : count );
+      for( auto & thread : threads ) {
+        thread.join();
+      }
+    }
+
     // Based on:
     // Lengyel, Eric. "Computing Tangent Space Basis Vectors for an Arbitrary Mesh". Terathon Software 3D Graphics Library, 2001.
     // http://www.terathon.com/code/tangent.html
@@ -183,7 +250,14 @@ namespace VulkanCookbook {
                                        float         * bitangent_data ) {
       // Gram-Schmidt orthogonalize
       Vector3 const normal = { normal_data[0], normal_data[1], normal_data[2] };
-      Vector3 const tangent = Normalize( face_tangent - normal * Dot( normal, face_tangent ) );
+      Vector3 tangent = face_tangent - normal * Dot( normal, face_tangent );
+
+      // Degenerate texture coordinates - any vector perpendicular to the normal is valid
+      if( Dot( tangent, tangent ) <= 0.0f ) {
+        Vector3 const axis = std::abs( normal[0] ) < 0.9f ? Vector3{ 1.0f, 0.0f, 0.0f } : Vector3{ 0.0f, 1.0f, 0.0f };
+        tangent = Cross( axis, normal );
+      }
+      tangent = Normalize( tangent );
 
       // Calculate handedness
       float handedness = (Dot( Cross( normal, tangent ), face_bitangent ) < 0.0f) ? -1.0f : 1.0f;
@@ -199,46 +273,88 @@ namespace VulkanCookbook {
       bitangent_data[2] = bitangent[2];
     }
 
-    void GenerateTangentSpaceVectors( Mesh & mesh ) {
+    // Vertex data consists of a position, normal vector and texture coordinates followed by the tangent and
+    // bitangent vectors; the stride (in floats) comes from the data loaded for a model
+
+    void GenerateTangentSpaceVectors( Mesh       & mesh,
+                                      size_t       stride,
+                                      ThreadPool * thread_pool ) {
       size_t const normal_offset = 3;
-      size_t const texcoord_offset = 6;
-      size_t const tangent_offset = 8;
-      size_t const bitangent_offset = 11;
-      size_t const stride = bitangent_offset + 3;
+      size_t const texcoord_offset = normal_offset + 3;
+      size_t const tangent_offset = texcoord_offset + 2;
+      size_t const bitangent_offset = tangent_offset + 3;
+      if( stride < bitangent_offset + 3 ) {
+        return;
+      }
 
       for( auto & part : mesh.Parts ) {
-        for( size_t i = 0; i < mesh.Data.size(); i += stride * 3 ) {
-          size_t i1 = i;
-          size_t i2 = i1 + stride;
-          size_t i3 = i2 + stride;
-          Vector3 const v1 = { mesh.Data[i1], mesh.Data[i1 + 1], mesh.Data[i1 + 2] };
-          Vector3 const v2 = { mesh.Data[i2], mesh.Data[i2 + 1], mesh.Data[i2 + 2] };
-          Vector3 const v3 = { mesh.Data[i3], mesh.Data[i3 + 1], mesh.Data[i3 + 2] };
-
-          std::array<float, 2> const w1 = { mesh.Data[i1 + texcoord_offset], mesh.Data[i1 + texcoord_offset + 1] };
-          std::array<float, 2> const w2 = { mesh.Data[i2 + texcoord_offset], mesh.Data[i2 + texcoord_offset + 1] };
-          std::array<float, 2> const w3 = { mesh.Data[i3 + texcoord_offset], mesh.Data[i3 + texcoord_offset + 1] };
-
-          float x1 = v2[0] - v1[0];
-          float x2 = v3[0] - v1[0];
-          float y1 = v2[1] - v1[1];
-          float y2 = v3[1] - v1[1];
-          float z1 = v2[2] - v1[2];
-          float z2 = v3[2] - v1[2];
-
-          float s1 = w2[0] - w1[0];
-          float s2 = w3[0] - w1[0];
-          float t1 = w2[1] - w1[1];
-          float t2 = w3[1] - w1[1];
-
-          float r = 1.0f / (s1 * t2 - s2 * t1);
-          Vector3 face_tangent = { (t2 * x1 - t1 * x2) * r, (t2 * y1 - t1 * y2) * r, (t2 * z1 - t1 * z2) * r };
-          Vector3 face_bitangent = { (s1 * x2 - s2 * x1) * r, (s1 * y2 - s2 * y1) * r, (s1 * z2 - s2 * z1) * r };
-
-          CalculateTangentAndBitangent( &mesh.Data[i1 + normal_offset], face_tangent, face_bitangent, &mesh.Data[i1 + tangent_offset], &mesh.Data[i1 + bitangent_offset] );
-          CalculateTangentAndBitangent( &mesh.Data[i2 + normal_offset], face_tangent, face_bitangent, &mesh.Data[i2 + tangent_offset], &mesh.Data[i2 + bitangent_offset] );
-          CalculateTangentAndBitangent( &mesh.Data[i3 + normal_offset], face_tangent, face_bitangent, &mesh.Data[i3 + tangent_offset], &mesh.Data[i3 + bitangent_offset] );
+        size_t const triangle_count = part.VertexCount / 3;
+        size_t const vertex_count = triangle_count * 3;
+        if( 0 == vertex_count ) {
+          continue;
+        }
+        float * data = &mesh.Data[part.VertexOffset * stride];
+
+        // Tangents and bitangents of faces aren't normalized, so larger faces have more influence
+        std::vector<Vector3> face_tangents( triangle_count );
+        std::vector<Vector3> face_bitangents( triangle_count );
+
+        ParallelFor( thread_pool, triangle_count, [&]( size_t begin, size_t end ) {
+          for( size_t triangle = begin; triangle < end; ++triangle ) {
+            float const * p1 = &data[(3 * triangle + 0) * stride];
+            float const * p2 = &data[(3 * triangle + 1) * stride];
+            float const * p3 = &data[(3 * triangle + 2) * stride];
+
+            float x1 = p2[0] - p1[0];
+            float x2 = p3[0] - p1[0];
+            float y1 = p2[1] - p1[1];
+            float y2 = p3[1] - p1[1];
+            float z1 = p2[2] - p1[2];
+            float z2 = p3[2] - p1[2];
+
+            float s1 = p2[texcoord_offset] - p1[texcoord_offset];
+            float s2 = p3[texcoord_offset] - p1[texcoord_offset];
+            float t1 = p2[texcoord_offset + 1] - p1[texcoord_offset + 1];
+            float t2 = p3[texcoord_offset + 1] - p1[texcoord_offset + 1];
+
+            float denominator = s1 * t2 - s2 * t1;
+            if( 0.0f == denominator ) {
+              face_tangents[triangle] = { 0.0f, 0.0f, 0.0f };
+              face_bitangents[triangle] = { 0.0f, 0.0f, 0.0f };
+              continue;
+            }
+
+            float r = 1.0f / denominator;
+            face_tangents[triangle] = { (t2 * x1 - t1 * x2) * r, (t2 * y1 - t1 * y2) * r, (t2 * z1 - t1 * z2) * r };
+            face_bitangents[triangle] = { (s1 * x2 - s2 * x1) * r, (s1 * y2 - s2 * y1) * r, (s1 * z2 - s2 * z1) * r };
+          }
+        } );
+
+        // Accumulate vectors of all faces sharing a given vertex
+        std::vector<uint32_t> shared_vertices( vertex_count );
+        std::vector<Vector3>  tangents( vertex_count, Vector3{ 0.0f, 0.0f, 0.0f } );
+        std::vector<Vector3>  bitangents( vertex_count, Vector3{ 0.0f, 0.0f, 0.0f } );
+        {
+          // Vertices with the same position, normal vector and texture coordinates are shared by adjacent triangles;
+          // these attributes are stored in the first tangent_offset floats of each vertex
+          std::unordered_map<uint32_t, uint32_t, VertexHash, VertexEqual> first_vertices( vertex_count,
+            VertexHash{ data, stride, tangent_offset }, VertexEqual{ data, stride, tangent_offset } );
+
+          for( uint32_t vertex = 0; vertex < vertex_count; ++vertex ) {
+            uint32_t shared_vertex = first_vertices.emplace( vertex, vertex ).first->second;
+            shared_vertices[vertex] = shared_vertex;
+            tangents[shared_vertex] = tangents[shared_vertex] + face_tangents[vertex / 3];
+            bitangents[shared_vertex] = bitangents[shared_vertex] + face_bitangents[vertex / 3];
+          }
         }
+
+        ParallelFor( thread_pool, vertex_count, [&]( size_t begin, size_t end ) {
+          for( size_t vertex = begin; vertex < end; ++vertex ) {
+            float * vertex_data = &data[vertex * stride];
+            CalculateTangentAndBitangent( &vertex_data[normal_offset], tangents[shared_vertices[vertex]], bitangents[shared_vertices[vertex]],
+              &vertex_data[tangent_offset], &vertex_data[bitangent_offset] );
+          }
+        } );
       }
     }
   }
@@ -30,6 +30,7 @@
 #define LOADING_A_3D_MODEL_FROM_AN_OBJ_FILE
 
 #include "Tools.h"
+#include "09 Command Recording and Drawing/21 Recording command buffers on a persistent pool of threads.h"
 
 namespace VulkanCookbook {
 
@@ -44,13 +45,37 @@ namespace VulkanCookbook {
     std::vector<Part>   Parts;
   };
 
+  // Vertices are identified by their index in the source data and compared by their first KeySize floats,
+  // so keys stay small and the attributes are never copied into a hash table
+
+  struct VertexHash {
+    float const * Data;
+    size_t        Stride;
+    size_t        KeySize;
+
+    size_t operator() ( uint32_t vertex ) const;
+  };
+
+  struct VertexEqual {
+    float const * Data;
+    size_t        Stride;
+    size_t        KeySize;
+
+    bool operator() ( uint32_t left,
+                      uint32_t right ) const;
+  };
+
+  // Tangent space vectors are generated on the provided thread pool; when it isn't provided,
+  // temporary threads are created for the duration of the call
+
   bool Load3DModelFromObjFile( char const * filename,
                                bool         load_normals,
                                bool         load_texcoords,
                                bool         generate_tangent_space_vectors,
                                bool         unify,
                                Mesh       & mesh,
-                               uint32_t   * vertex_stride = nullptr );
+                               uint32_t   * vertex_stride = nullptr,
+                               ThreadPool * thread_pool = nullptr );
 
 } // namespace VulkanCookbook
 
@@ -0,0 +1,173 @@
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and / or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The below copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// Chapter: 10 Helper Recipes
+// Recipe:  08 Loading an indexed 3D model from an OBJ file
+
+#include <unordered_map>
+#include "10 Helper Recipes/08 Loading an indexed 3D model from an OBJ file.h"
+
+namespace VulkanCookbook {
+
+  namespace {
+
+    void OrthonormalizeTangentSpaceVectors( float * vertex_data ) {
+      size_t const normal_offset = 3;
+      size_t const tangent_offset = 8;
+      size_t const bitangent_offset = 11;
+
+      Vector3 const normal = { vertex_data[normal_offset], vertex_data[normal_offset + 1], vertex_data[normal_offset + 2] };
+      Vector3 tangent = { vertex_data[tangent_offset], vertex_data[tangent_offset + 1], vertex_data[tangent_offset + 2] };
+      Vector3 const bitangent = { vertex_data[bitangent_offset], vertex_data[bitangent_offset + 1], vertex_data[bitangent_offset + 2] };
+
+      tangent = tangent - normal * Dot( normal, tangent );
+      if( Dot( tangent, tangent ) <= 0.0f ) {
+        return;
+      }
+      tangent = Normalize( tangent );
+
+      float handedness = (Dot( Cross( normal, tangent ), bitangent ) < 0.0f) ? -1.0f : 1.0f;
+      Vector3 const new_bitangent = handedness * Cross( normal, tangent );
+
+      for( size_t i = 0; i < 3; ++i ) {
+        vertex_data[tangent_offset + i] = tangent[i];
+        vertex_data[bitangent_offset + i] = new_bitangent[i];
+      }
+    }
+
+  }
+
+  bool CreateIndexedMesh( Mesh const            & mesh,
+                          uint32_t                vertex_stride,
+                          IndexedMesh           & indexed_mesh,
+                          IndexedMeshStatistics * statistics ) {
+    size_t const stride = vertex_stride / sizeof( float );
+    if( (0 == stride) ||
+        (0 != vertex_stride % sizeof( float )) ||
+        (0 != mesh.Data.size() % stride) ) {
+      std::cout << "Provided vertex stride doesn't match the mesh data." << std::endl;
+      return false;
+    }
+
+    // Position, normal vector and texture coordinates take up to 8 floats
+    // Anything beyond them are tangent and bitangent vectors, which are accumulated
+    size_t const key_size = stride > 8 ? 8 : stride;
+    bool const tangent_space_vectors = stride > 8;
+
+    indexed_mesh = {};
+    indexed_mesh.Data.reserve( mesh.Data.size() );
+
+    std::vector<uint32_t> indices;
+    indices.reserve( mesh.Data.size() / stride );
+    uint32_t max_part_vertex_count = 0;
+
+    for( auto & part : mesh.Parts ) {
+      if( static_cast<size_t>(part.VertexOffset + part.VertexCount) * stride > mesh.Data.size() ) {
+        std::cout << "Mesh part exceeds the mesh data." << std::endl;
+        return false;
+      }
+
+      IndexedMesh::Part indexed_part = {
+        static_cast<uint32_t>(indexed_mesh.Data.size() / stride),   // uint32_t  VertexOffset
+        0,                                                          // uint32_t  VertexCount
+        static_cast<uint32_t>(indices.size()),                      // uint32_t  IndexOffset
+        part.VertexCount                                            // uint32_t  IndexCount
+      };
+
+      float const * part_data = &mesh.Data[part.VertexOffset * stride];
+      std::unordered_map<uint32_t, uint32_t, VertexHash, VertexEqual> unique_vertices( part.VertexCount,
+        VertexHash{ part_data, stride, key_size }, VertexEqual{ part_data, stride, key_size } );
+
+      for( uint32_t vertex = 0; vertex < part.VertexCount; ++vertex ) {
+        auto inserted = unique_vertices.emplace( vertex, indexed_part.VertexCount );
+        if( inserted.second ) {
+          indexed_mesh.Data.insert( indexed_mesh.Data.end(), &part_data[vertex * stride], &part_data[(vertex + 1) * stride] );
+          ++indexed_part.VertexCount;
+        } else if( tangent_space_vectors ) {
+          float * unique_data = &indexed_mesh.Data[(indexed_part.VertexOffset + inserted.first->second) * stride];
+          for( size_t i = key_size; i < stride; ++i ) {
+            unique_data[i] += part_data[vertex * stride + i];
+          }
+        }
+        indices.push_back( inserted.first->second );
+      }
+
+      if( indexed_part.VertexCount > max_part_vertex_count ) {
+        max_part_vertex_count = indexed_part.VertexCount;
+      }
+      indexed_mesh.Parts.push_back( indexed_part );
+    }
+
+    if( tangent_space_vectors ) {
+      for( size_t i = 0; i < indexed_mesh.Data.size(); i += stride ) {
+        OrthonormalizeTangentSpaceVectors( &indexed_mesh.Data[i] );
+      }
+    }
+
+    // Indices are relative to each part, so 16-bit indices are enough when every part is small
+    if( max_part_vertex_count <= 0xFFFF ) {
+      indexed_mesh.IndexType = VK_INDEX_TYPE_UINT16;
+      indexed_mesh.Indices.resize( indices.size() * sizeof( uint16_t ) );
+      uint16_t * index_data = reinterpret_cast<uint16_t *>(indexed_mesh.Indices.data());
+      for( size_t i = 0; i < indices.size(); ++i ) {
+        index_data[i] = static_cast<uint16_t>(indices[i]);
+      }
+    } else {
+      indexed_mesh.IndexType = VK_INDEX_TYPE_UINT32;
+      indexed_mesh.Indices.resize( indices.size() * sizeof( uint32_t ) );
+      std::memcpy( indexed_mesh.Indices.data(), indices.data(), indexed_mesh.Indices.size() );
+    }
+    indexed_mesh.Data.shrink_to_fit();
+
+    if( statistics ) {
+      statistics->SourceVertexCount = static_cast<uint32_t>(mesh.Data.size() / stride);
+      statistics->UniqueVertexCount = static_cast<uint32_t>(indexed_mesh.Data.size() / stride);
+      statistics->SourceDataSize = mesh.Data.size() * sizeof( float );
+      statistics->IndexedDataSize = indexed_mesh.Data.size() * sizeof( float ) + indexed_mesh.Indices.size();
+    }
+    return true;
+  }
+
+  bool Load3DModelFromObjFile( char const            * filename,
+                               bool                    load_normals,
+                               bool                    load_texcoords,
+                               bool                    generate_tangent_space_vectors,
+                               bool                    unify,
+                               IndexedMesh           & mesh,
+                               uint32_t              * vertex_stride,
+                               IndexedMeshStatistics * statistics,
+                               ThreadPool            * thread_pool ) {
+    Mesh     source_mesh;
+    uint32_t stride;
+    if( !Load3DModelFromObjFile( filename, load_normals, load_texcoords, generate_tangent_space_vectors, unify, source_mesh, &stride, thread_pool ) ) {
+      return false;
+    }
+    if( vertex_stride ) {
+      *vertex_stride = stride;
+    }
+    return CreateIndexedMesh( source_mesh, stride, mesh, statistics );
+  }
+
+} // namespace VulkanCookbook
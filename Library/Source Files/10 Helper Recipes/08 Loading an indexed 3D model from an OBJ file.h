@@ -0,0 +1,81 @@
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and / or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The below copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// Chapter: 10 Helper Recipes
+// Recipe:  08 Loading an indexed 3D model from an OBJ file
+
+#ifndef LOADING_AN_INDEXED_3D_MODEL_FROM_AN_OBJ_FILE
+#define LOADING_AN_INDEXED_3D_MODEL_FROM_AN_OBJ_FILE
+
+#include "10 Helper Recipes/07 Loading a 3D model from an OBJ file.h"
+
+namespace VulkanCookbook {
+
+  // Each part references its own range of unique vertices. Indices are relative to the
+  // part's VertexOffset, which should be provided as a vertex offset of an indexed draw.
+
+  struct IndexedMesh {
+    std::vector<float>          Data;
+    VkIndexType                 IndexType;
+    std::vector<unsigned char>  Indices;
+
+    struct Part {
+      uint32_t  VertexOffset;
+      uint32_t  VertexCount;
+      uint32_t  IndexOffset;
+      uint32_t  IndexCount;
+    };
+
+    std::vector<Part>           Parts;
+  };
+
+  struct IndexedMeshStatistics {
+    uint32_t  SourceVertexCount;
+    uint32_t  UniqueVertexCount;
+    size_t    SourceDataSize;
+    size_t    IndexedDataSize;
+  };
+
+  // Vertices with the same position, normal vector and texture coordinates are merged.
+  // Tangent space vectors of merged vertices are averaged.
+
+  bool CreateIndexedMesh( Mesh const            & mesh,
+                          uint32_t                vertex_stride,
+                          IndexedMesh           & indexed_mesh,
+                          IndexedMeshStatistics * statistics = nullptr );
+
+  bool Load3DModelFromObjFile( char const            * filename,
+                               bool                    load_normals,
+                               bool                    load_texcoords,
+                               bool                    generate_tangent_space_vectors,
+                               bool                    unify,
+                               IndexedMesh           & mesh,
+                               uint32_t              * vertex_stride = nullptr,
+                               IndexedMeshStatistics * statistics = nullptr,
+                               ThreadPool            * thread_pool = nullptr );
+
+} // namespace VulkanCookbook
+
+#endif // LOADING_AN_INDEXED_3D_MODEL_FROM_AN_OBJ_FILE
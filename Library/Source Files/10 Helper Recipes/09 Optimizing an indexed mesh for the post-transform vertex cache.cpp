@@ -0,0 +1,367 @@
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and / or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The below copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// Chapter: 10 Helper Recipes
+// Recipe:  09 Optimizing an indexed mesh for the post-transform vertex cache
+
+#include <algorithm>
+#include "10 Helper Recipes/09 Optimizing an indexed mesh for the post-transform vertex cache.h"
+
+namespace VulkanCookbook {
+
+  namespace {
+
+    uint32_t const INVALID_VERTEX = 0xFFFFFFFF;
+
+    std::vector<uint32_t> GetIndices( IndexedMesh const & mesh ) {
+      std::vector<uint32_t> indices;
+      if( VK_INDEX_TYPE_UINT16 == mesh.IndexType ) {
+        uint16_t const * index_data = reinterpret_cast<uint16_t const *>(mesh.Indices.data());
+        indices.assign( index_data, index_data + mesh.Indices.size() / sizeof( uint16_t ) );
+      } else {
+        uint32_t const * index_data = reinterpret_cast<uint32_t const *>(mesh.Indices.data());
+        indices.assign( index_data, index_data + mesh.Indices.size() / sizeof( uint32_t ) );
+      }
+      return indices;
+    }
+
+    void SetIndices( IndexedMesh                 & mesh,
+                     std::vector<uint32_t> const & indices ) {
+      if( VK_INDEX_TYPE_UINT16 == mesh.IndexType ) {
+        uint16_t * index_data = reinterpret_cast<uint16_t *>(mesh.Indices.data());
+        for( size_t i = 0; i < indices.size(); ++i ) {
+          index_data[i] = static_cast<uint16_t>(indices[i]);
+        }
+      } else {
+        std::memcpy( mesh.Indices.data(), indices.data(), indices.size() * sizeof( uint32_t ) );
+      }
+    }
+
+    // A vertex is in a FIFO cache when it was inserted during the last cache_size insertions
+
+    uint32_t CountCacheMisses( uint32_t const * indices,
+                               uint32_t         index_count,
+                               uint32_t         vertex_count,
+                               uint32_t         cache_size ) {
+      std::vector<uint32_t> cache_time( vertex_count, 0 );
+      uint32_t time = cache_size + 1;
+      uint32_t misses = 0;
+
+      for( uint32_t i = 0; i < index_count; ++i ) {
+        uint32_t vertex = indices[i];
+        if( time - cache_time[vertex] > cache_size ) {
+          cache_time[vertex] = time++;
+          ++misses;
+        }
+      }
+      return misses;
+    }
+
+    void Tipsify( uint32_t const        * indices,
+                  uint32_t                index_count,
+                  uint32_t                vertex_count,
+                  uint32_t                cache_size,
+                  std::vector<uint32_t> & output,
+                  std::vector<uint32_t> & cluster_starts ) {
+      uint32_t const triangle_count = index_count / 3;
+
+      // Triangles adjacent to each vertex
+      std::vector<uint32_t> live_triangles( vertex_count, 0 );
+      for( uint32_t i = 0; i < index_count; ++i ) {
+        ++live_triangles[indices[i]];
+      }
+      std::vector<uint32_t> adjacency_offsets( vertex_count + 1, 0 );
+      for( uint32_t vertex = 0; vertex < vertex_count; ++vertex ) {
+        adjacency_offsets[vertex + 1] = adjacency_offsets[vertex] + live_triangles[vertex];
+      }
+      std::vector<uint32_t> adjacency( index_count );
+      std::vector<uint32_t> adjacency_fill( adjacency_offsets.begin(), adjacency_offsets.end() - 1 );
+      for( uint32_t triangle = 0; triangle < triangle_count; ++triangle ) {
+        for( uint32_t k = 0; k < 3; ++k ) {
+          adjacency[adjacency_fill[indices[3 * triangle + k]]++] = triangle;
+        }
+      }
+
+      std::vector<uint32_t> cache_time( vertex_count, 0 );
+      std::vector<bool>     emitted( triangle_count, false );
+      std::vector<uint32_t> dead_end_stack;
+      std::vector<uint32_t> candidates;
+      uint32_t              time = cache_size + 1;
+      uint32_t              cursor = 0;
+      uint32_t              fanning_vertex = vertex_count > 0 ? 0 : INVALID_VERTEX;
+
+      output.clear();
+      output.reserve( triangle_count * 3 );
+      cluster_starts.assign( 1, 0 );
+
+      while( INVALID_VERTEX != fanning_vertex ) {
+        // Emit all remaining triangles around the fanning vertex
+        candidates.clear();
+        for( uint32_t a = adjacency_offsets[fanning_vertex]; a < adjacency_offsets[fanning_vertex + 1]; ++a ) {
+          uint32_t triangle = adjacency[a];
+          if( emitted[triangle] ) {
+            continue;
+          }
+          for( uint32_t k = 0; k < 3; ++k ) {
+            uint32_t vertex = indices[3 * triangle + k];
+            output.push_back( vertex );
+            dead_end_stack.push_back( vertex );
+            candidates.push_back( vertex );
+            --live_triangles[vertex];
+            if( time - cache_time[vertex] > cache_size ) {
+              cache_time[vertex] = time++;
+            }
+          }
+          emitted[triangle] = true;
+        }
+
+        // Prefer vertices which will still be in the cache after all their triangles are emitted
+        uint32_t next_vertex = INVALID_VERTEX;
+        int64_t  best_priority = -1;
+        for( auto vertex : candidates ) {
+          if( 0 < live_triangles[vertex] ) {
+            int64_t priority = 0;
+            if( time - cache_time[vertex] + 2 * live_triangles[vertex] <= cache_size ) {
+              priority = time - cache_time[vertex];
+            }
+            if( priority > best_priority ) {
+              best_priority = priority;
+              next_vertex = vertex;
+            }
+          }
+        }
+
+        // Dead end - the cache locality is lost, so a new cluster starts here
+        if( INVALID_VERTEX == next_vertex ) {
+          while( !dead_end_stack.empty() ) {
+            uint32_t vertex = dead_end_stack.back();
+            dead_end_stack.pop_back();
+            if( 0 < live_triangles[vertex] ) {
+              next_vertex = vertex;
+              break;
+            }
+          }
+          while( (INVALID_VERTEX == next_vertex) && (cursor < vertex_count) ) {
+            if( 0 < live_triangles[cursor] ) {
+              next_vertex = cursor;
+            }
+            ++cursor;
+          }
+          if( (INVALID_VERTEX != next_vertex) && (output.size() > cluster_starts.back()) ) {
+            cluster_starts.push_back( static_cast<uint32_t>(output.size()) );
+          }
+        }
+        fanning_vertex = next_vertex;
+      }
+    }
+
+    // Clusters facing away from the center of the part are drawn first,
+    // so they occlude the ones behind them
+
+    void SortClustersToReduceOverdraw( float const                 * vertex_data,
+                                       size_t                        stride,
+                                       std::vector<uint32_t>       & indices,
+                                       std::vector<uint32_t> const & cluster_starts ) {
+      struct Cluster {
+        uint32_t  Start;
+        uint32_t  End;
+        Vector3   Centroid;
+        Vector3   Normal;
+        float     Area;
+        float     SortKey;
+      };
+
+      std::vector<Cluster> clusters;
+      Vector3 part_centroid = { 0.0f, 0.0f, 0.0f };
+      float part_area = 0.0f;
+
+      for( size_t c = 0; c < cluster_starts.size(); ++c ) {
+        Cluster cluster = {
+          cluster_starts[c],
+          c + 1 < cluster_starts.size() ? cluster_starts[c + 1] : static_cast<uint32_t>(indices.size()),
+          { 0.0f, 0.0f, 0.0f },
+          { 0.0f, 0.0f, 0.0f },
+          0.0f,
+          0.0f
+        };
+
+        for( uint32_t i = cluster.Start; i < cluster.End; i += 3 ) {
+          float const * p1 = &vertex_data[indices[i + 0] * stride];
+          float const * p2 = &vertex_data[indices[i + 1] * stride];
+          float const * p3 = &vertex_data[indices[i + 2] * stride];
+          Vector3 const v1 = { p1[0], p1[1], p1[2] };
+          Vector3 const v2 = { p2[0], p2[1], p2[2] };
+          Vector3 const v3 = { p3[0], p3[1], p3[2] };
+
+          Vector3 const normal = Cross( v2 - v1, v3 - v1 );
+          float const area = 0.5f * std::sqrt( Dot( normal, normal ) );
+          cluster.Centroid = cluster.Centroid + (area / 3.0f) * (v1 + v2 + v3);
+          cluster.Normal = cluster.Normal + normal;
+          cluster.Area += area;
+        }
+
+        part_centroid = part_centroid + cluster.Centroid;
+        part_area += cluster.Area;
+        if( cluster.Area > 0.0f ) {
+          cluster.Centroid = (1.0f / cluster.Area) * cluster.Centroid;
+        }
+        clusters.push_back( cluster );
+      }
+
+      if( part_area > 0.0f ) {
+        part_centroid = (1.0f / part_area) * part_centroid;
+      }
+      for( auto & cluster : clusters ) {
+        if( Dot( cluster.Normal, cluster.Normal ) > 0.0f ) {
+          cluster.SortKey = Dot( cluster.Centroid - part_centroid, Normalize( cluster.Normal ) );
+        }
+      }
+
+      std::stable_sort( clusters.begin(), clusters.end(), []( Cluster const & left, Cluster const & right ) {
+        return left.SortKey > right.SortKey;
+      } );
+
+      std::vector<uint32_t> sorted_indices;
+      sorted_indices.reserve( indices.size() );
+      for( auto & cluster : clusters ) {
+        sorted_indices.insert( sorted_indices.end(), indices.begin() + cluster.Start, indices.begin() + cluster.End );
+      }
+      indices.swap( sorted_indices );
+    }
+
+    // Vertices are stored in the order in which they are first referenced
+
+    void ReorderVerticesForFetchLocality( float                 * vertex_data,
+                                          size_t                  stride,
+                                          uint32_t                vertex_count,
+                                          std::vector<uint32_t> & indices ) {
+      std::vector<uint32_t> remap( vertex_count, INVALID_VERTEX );
+      uint32_t next_vertex = 0;
+      for( auto & index : indices ) {
+        if( INVALID_VERTEX == remap[index] ) {
+          remap[index] = next_vertex++;
+        }
+        index = remap[index];
+      }
+      for( uint32_t vertex = 0; vertex < vertex_count; ++vertex ) {
+        if( INVALID_VERTEX == remap[vertex] ) {
+          remap[vertex] = next_vertex++;
+        }
+      }
+
+      std::vector<float> reordered_data( vertex_count * stride );
+      for( uint32_t vertex = 0; vertex < vertex_count; ++vertex ) {
+        std::memcpy( &reordered_data[remap[vertex] * stride], &vertex_data[vertex * stride], stride * sizeof( float ) );
+      }
+      std::memcpy( vertex_data, reordered_data.data(), reordered_data.size() * sizeof( float ) );
+    }
+
+  }
+
+  VertexCacheStatistics CalculateVertexCacheStatistics( IndexedMesh const & mesh,
+                                                        uint32_t            cache_size ) {
+    std::vector<uint32_t> indices = GetIndices( mesh );
+    uint32_t misses = 0;
+    uint32_t triangle_count = 0;
+    uint32_t vertex_count = 0;
+
+    for( auto & part : mesh.Parts ) {
+      if( 0 == part.IndexCount ) {
+        continue;
+      }
+      misses += CountCacheMisses( &indices[part.IndexOffset], part.IndexCount, part.VertexCount, cache_size );
+      triangle_count += part.IndexCount / 3;
+      vertex_count += part.VertexCount;
+    }
+
+    VertexCacheStatistics statistics = {
+      triangle_count > 0 ? static_cast<float>(misses) / triangle_count : 0.0f,  // float ACMR
+      vertex_count > 0 ? static_cast<float>(misses) / vertex_count : 0.0f       // float ATVR
+    };
+    return statistics;
+  }
+
+  bool OptimizeIndexedMesh( IndexedMesh                & mesh,
+                            uint32_t                     vertex_stride,
+                            uint32_t                     cache_size,
+                            bool                         reduce_overdraw,
+                            MeshOptimizationStatistics * statistics ) {
+    size_t const stride = vertex_stride / sizeof( float );
+    if( (stride < 3) ||
+        (0 != vertex_stride % sizeof( float )) ||
+        (0 == cache_size) ) {
+      std::cout << "Invalid parameters provided for the mesh optimization." << std::endl;
+      return false;
+    }
+
+    std::vector<uint32_t> indices = GetIndices( mesh );
+    for( auto & part : mesh.Parts ) {
+      if( (0 != part.IndexCount % 3) ||
+          (part.IndexOffset + part.IndexCount > indices.size()) ||
+          (static_cast<size_t>(part.VertexOffset + part.VertexCount) * stride > mesh.Data.size()) ) {
+        std::cout << "Mesh part exceeds the mesh data." << std::endl;
+        return false;
+      }
+      for( uint32_t i = part.IndexOffset; i < part.IndexOffset + part.IndexCount; ++i ) {
+        if( indices[i] >= part.VertexCount ) {
+          std::cout << "Mesh part references a vertex outside of its vertex range." << std::endl;
+          return false;
+        }
+      }
+    }
+
+    if( statistics ) {
+      statistics->Before = CalculateVertexCacheStatistics( mesh, cache_size );
+      statistics->ClusterCount = 0;
+    }
+
+    std::vector<uint32_t> part_indices;
+    std::vector<uint32_t> cluster_starts;
+    for( auto & part : mesh.Parts ) {
+      if( 0 == part.IndexCount ) {
+        continue;
+      }
+      float * part_data = &mesh.Data[part.VertexOffset * stride];
+
+      Tipsify( &indices[part.IndexOffset], part.IndexCount, part.VertexCount, cache_size, part_indices, cluster_starts );
+      if( reduce_overdraw ) {
+        SortClustersToReduceOverdraw( part_data, stride, part_indices, cluster_starts );
+      }
+      ReorderVerticesForFetchLocality( part_data, stride, part.VertexCount, part_indices );
+
+      std::copy( part_indices.begin(), part_indices.end(), indices.begin() + part.IndexOffset );
+      if( statistics ) {
+        statistics->ClusterCount += static_cast<uint32_t>(cluster_starts.size());
+      }
+    }
+    SetIndices( mesh, indices );
+
+    if( statistics ) {
+      statistics->After = CalculateVertexCacheStatistics( mesh, cache_size );
+    }
+    return true;
+  }
+
+} // namespace VulkanCookbook
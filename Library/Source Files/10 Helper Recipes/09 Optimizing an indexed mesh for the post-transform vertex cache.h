@@ -0,0 +1,69 @@
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and / or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The below copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// Chapter: 10 Helper Recipes
+// Recipe:  09 Optimizing an indexed mesh for the post-transform vertex cache
+
+#ifndef OPTIMIZING_AN_INDEXED_MESH_FOR_THE_POST_TRANSFORM_VERTEX_CACHE
+#define OPTIMIZING_AN_INDEXED_MESH_FOR_THE_POST_TRANSFORM_VERTEX_CACHE
+
+#include "10 Helper Recipes/08 Loading an indexed 3D model from an OBJ file.h"
+
+namespace VulkanCookbook {
+
+  // ACMR - average number of vertex shader invocations (cache misses) per triangle
+  // ATVR - average number of vertex shader invocations per unique vertex (1.0 is optimal)
+
+  struct VertexCacheStatistics {
+    float     ACMR;
+    float     ATVR;
+  };
+
+  struct MeshOptimizationStatistics {
+    VertexCacheStatistics Before;
+    VertexCacheStatistics After;
+    uint32_t              ClusterCount;
+  };
+
+  // Simulates a FIFO post-transform vertex cache of a given size
+
+  VertexCacheStatistics CalculateVertexCacheStatistics( IndexedMesh const & mesh,
+                                                        uint32_t            cache_size );
+
+  // Triangles of each part are reordered with the Tipsify algorithm:
+  // Sander, Nehab, Barczak. "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw". SIGGRAPH 2007.
+  // When overdraw reduction is requested, clusters of triangles are additionally sorted so that
+  // outward facing ones are drawn first. Vertices are then reordered by their first use.
+  // The result depends only on the input data.
+
+  bool OptimizeIndexedMesh( IndexedMesh                & mesh,
+                            uint32_t                     vertex_stride,
+                            uint32_t                     cache_size,
+                            bool                         reduce_overdraw,
+                            MeshOptimizationStatistics * statistics = nullptr );
+
+} // namespace VulkanCookbook
+
+#endif // OPTIMIZING_AN_INDEXED_MESH_FOR_THE_POST_TRANSFORM_VERTEX_CACHE
@@ -0,0 +1,450 @@
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and / or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The below copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// Chapter: 10 Helper Recipes
+// Recipe:  10 Caching a 3D model in a binary file
+
+#include <cstdlib>
+#include <sys/types.h>
+#include <sys/stat.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#include "10 Helper Recipes/10 Caching a 3D model in a binary file.h"
+
+namespace VulkanCookbook {
+
+  namespace {
+
+    // File layout:
+    // header, vertex attributes table, parts table, vertex data, index data
+    // Vertex and index data start at 64-byte aligned offsets
+
+    uint32_t const MESH_CACHE_VERSION = 2;
+    uint32_t const MESH_CACHE_VERTEX_CACHE_SIZE = 16;
+    size_t const   MESH_CACHE_DATA_ALIGNMENT = 64;
+    char const     MESH_CACHE_MAGIC[4] = { 'V', 'K', 'C', 'M' };
+
+    struct MeshCacheHeader {
+      char      Magic[4];
+      uint32_t  Version;
+      uint64_t  SourceSize;
+      int64_t   SourceModificationTime;
+      uint32_t  LoadFlags;
+      uint32_t  VertexStride;
+      uint32_t  AttributeCount;
+      uint32_t  PartCount;
+      uint32_t  IndexType;
+      uint32_t  Reserved;
+      uint64_t  AttributesOffset;
+      uint64_t  PartsOffset;
+      uint64_t  VertexDataOffset;
+      uint64_t  VertexDataSize;
+      uint64_t  IndexDataOffset;
+      uint64_t  IndexDataSize;
+    };
+
+    uint64_t AlignOffset( uint64_t offset ) {
+      return (offset + MESH_CACHE_DATA_ALIGNMENT - 1) & ~static_cast<uint64_t>(MESH_CACHE_DATA_ALIGNMENT - 1);
+    }
+
+    bool IsRangeInFile( uint64_t offset,
+                        uint64_t size,
+                        uint64_t file_size ) {
+      return (offset <= file_size) && (size <= file_size - offset);
+    }
+
+    std::vector<MeshVertexAttribute> GetVertexAttributes( uint32_t load_flags ) {
+      std::vector<MeshVertexAttribute> attributes;
+      uint32_t offset = 0;
+
+      // Position
+      attributes.push_back( { offset, 3 } );
+      offset += 3 * sizeof( float );
+      if( load_flags & MESH_CACHE_LOAD_NORMALS ) {
+        attributes.push_back( { offset, 3 } );
+        offset += 3 * sizeof( float );
+      }
+      if( load_flags & MESH_CACHE_LOAD_TEXCOORDS ) {
+        attributes.push_back( { offset, 2 } );
+        offset += 2 * sizeof( float );
+      }
+      // Tangent and bitangent vectors are generated only when normals and texture coordinates are loaded
+      if( (load_flags & MESH_CACHE_GENERATE_TANGENT_SPACE) &&
+          (load_flags & MESH_CACHE_LOAD_NORMALS) &&
+          (load_flags & MESH_CACHE_LOAD_TEXCOORDS) ) {
+        attributes.push_back( { offset, 3 } );
+        offset += 3 * sizeof( float );
+        attributes.push_back( { offset, 3 } );
+      }
+      return attributes;
+    }
+
+    bool CreateMeshCacheContents( IndexedMesh const          & mesh,
+                                  uint32_t                     vertex_stride,
+                                  MeshCacheKey const         & key,
+                                  std::vector<unsigned char> & contents ) {
+      std::vector<MeshVertexAttribute> attributes = GetVertexAttributes( key.LoadFlags );
+      uint32_t attributes_size = 0;
+      for( auto & attribute : attributes ) {
+        attributes_size += attribute.ComponentCount * sizeof( float );
+      }
+      if( attributes_size != vertex_stride ) {
+        std::cout << "Vertex stride doesn't match the load flags of a cached mesh." << std::endl;
+        return false;
+      }
+
+      MeshCacheHeader header = {};
+      std::memcpy( header.Magic, MESH_CACHE_MAGIC, sizeof( MESH_CACHE_MAGIC ) );
+      header.Version = MESH_CACHE_VERSION;
+      header.SourceSize = key.SourceSize;
+      header.SourceModificationTime = key.SourceModificationTime;
+      header.LoadFlags = key.LoadFlags;
+      header.VertexStride = vertex_stride;
+      header.AttributeCount = static_cast<uint32_t>(attributes.size());
+      header.PartCount = static_cast<uint32_t>(mesh.Parts.size());
+      header.IndexType = mesh.IndexType;
+      header.AttributesOffset = sizeof( header );
+      header.PartsOffset = header.AttributesOffset + attributes.size() * sizeof( MeshVertexAttribute );
+      header.VertexDataOffset = AlignOffset( header.PartsOffset + mesh.Parts.size() * sizeof( IndexedMesh::Part ) );
+      header.VertexDataSize = mesh.Data.size() * sizeof( float );
+      header.IndexDataOffset = AlignOffset( header.VertexDataOffset + header.VertexDataSize );
+      header.IndexDataSize = mesh.Indices.size();
+
+      contents.assign( static_cast<size_t>(header.IndexDataOffset + header.IndexDataSize), 0 );
+      std::memcpy( &contents[0], &header, sizeof( header ) );
+      std::memcpy( &contents[header.AttributesOffset], attributes.data(), attributes.size() * sizeof( MeshVertexAttribute ) );
+      if( !mesh.Parts.empty() ) {
+        std::memcpy( &contents[header.PartsOffset], mesh.Parts.data(), mesh.Parts.size() * sizeof( IndexedMesh::Part ) );
+      }
+      if( !mesh.Data.empty() ) {
+        std::memcpy( &contents[header.VertexDataOffset], mesh.Data.data(), header.VertexDataSize );
+      }
+      if( !mesh.Indices.empty() ) {
+        std::memcpy( &contents[header.IndexDataOffset], mesh.Indices.data(), header.IndexDataSize );
+      }
+      return true;
+    }
+
+    std::string GetMeshCacheDirectory() {
+      // Directories are created when they don't exist yet; a failure is detected when the file is saved
+#ifdef _WIN32
+      char const * local_app_data = std::getenv( "LOCALAPPDATA" );
+      std::string directory;
+      if( nullptr != local_app_data ) {
+        directory = local_app_data;
+      } else {
+        char temp_path[MAX_PATH + 1];
+        DWORD length = GetTempPathA( MAX_PATH + 1, temp_path );
+        directory = std::string( temp_path, length );
+      }
+      directory += "\\VulkanCookbook";
+      CreateDirectoryA( directory.c_str(), nullptr );
+      directory += "\\MeshCache";
+      CreateDirectoryA( directory.c_str(), nullptr );
+      return directory + "\\";
+#else
+      char const * cache_home = std::getenv( "XDG_CACHE_HOME" );
+      char const * home = std::getenv( "HOME" );
+      std::string directory;
+      if( (nullptr != cache_home) && ('\0' != cache_home[0]) ) {
+        directory = cache_home;
+      } else if( (nullptr != home) && ('\0' != home[0]) ) {
+        directory = std::string( home ) + "/.cache";
+        mkdir( directory.c_str(), 0755 );
+      } else {
+        directory = "/tmp";
+      }
+      directory += "/VulkanCookbook";
+      mkdir( directory.c_str(), 0755 );
+      directory += "/MeshCache";
+      mkdir( directory.c_str(), 0755 );
+      return directory + "/";
+#endif
+    }
+
+  }
+
+  MappedMesh::MappedMesh() :
+    MappedData( nullptr ),
+    MappedSize( 0 ),
+    VertexStride( 0 ),
+    IndexType( VK_INDEX_TYPE_UINT16 ),
+    VertexDataOffset( 0 ),
+    VertexDataSize( 0 ),
+    IndexDataOffset( 0 ),
+    IndexDataSize( 0 ) {
+  }
+
+  MappedMesh::~MappedMesh() {
+    Unmap();
+  }
+
+  bool MappedMesh::Map( std::string const  & filename,
+                        MeshCacheKey const & key ) {
+    Unmap();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA( filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+    if( INVALID_HANDLE_VALUE == file ) {
+      return false;
+    }
+    LARGE_INTEGER file_size;
+    HANDLE mapping = nullptr;
+    if( GetFileSizeEx( file, &file_size ) && (file_size.QuadPart > 0) ) {
+      mapping = CreateFileMappingA( file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr );
+    }
+    CloseHandle( file );
+    if( nullptr == mapping ) {
+      return false;
+    }
+    void * view = MapViewOfFile( mapping, FILE_MAP_COPY, 0, 0, 0 );
+    CloseHandle( mapping );
+    if( nullptr == view ) {
+      return false;
+    }
+    MappedData = static_cast<unsigned char *>(view);
+    MappedSize = static_cast<size_t>(file_size.QuadPart);
+#else
+    int file = open( filename.c_str(), O_RDONLY );
+    if( file < 0 ) {
+      return false;
+    }
+    struct stat file_status;
+    void * view = MAP_FAILED;
+    if( (0 == fstat( file, &file_status )) && (file_status.st_size > 0) ) {
+      view = mmap( nullptr, static_cast<size_t>(file_status.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0 );
+    }
+    close( file );
+    if( MAP_FAILED == view ) {
+      return false;
+    }
+    MappedData = static_cast<unsigned char *>(view);
+    MappedSize = static_cast<size_t>(file_status.st_size);
+#endif
+
+    return ReadHeader( key );
+  }
+
+  bool MappedMesh::Assign( IndexedMesh const  & mesh,
+                           uint32_t             vertex_stride,
+                           MeshCacheKey const & key ) {
+    Unmap();
+
+    if( !CreateMeshCacheContents( mesh, vertex_stride, key, OwnedData ) ) {
+      OwnedData.clear();
+      return false;
+    }
+    MappedData = OwnedData.data();
+    MappedSize = OwnedData.size();
+    return ReadHeader( key );
+  }
+
+  bool MappedMesh::ReadHeader( MeshCacheKey const & key ) {
+    // Stale or damaged files are silently rejected, so they can be recreated
+    MeshCacheHeader header;
+    if( MappedSize < sizeof( header ) ) {
+      Unmap();
+      return false;
+    }
+    std::memcpy( &header, MappedData, sizeof( header ) );
+
+    if( (0 != std::memcmp( header.Magic, MESH_CACHE_MAGIC, sizeof( MESH_CACHE_MAGIC ) )) ||
+        (MESH_CACHE_VERSION != header.Version) ||
+        (key.SourceSize != header.SourceSize) ||
+        (key.SourceModificationTime != header.SourceModificationTime) ||
+        (key.LoadFlags != header.LoadFlags) ||
+        (0 == header.VertexStride) ||
+        ((VK_INDEX_TYPE_UINT16 != header.IndexType) && (VK_INDEX_TYPE_UINT32 != header.IndexType)) ||
+        !IsRangeInFile( header.AttributesOffset, static_cast<uint64_t>(header.AttributeCount) * sizeof( MeshVertexAttribute ), MappedSize ) ||
+        !IsRangeInFile( header.PartsOffset, static_cast<uint64_t>(header.PartCount) * sizeof( IndexedMesh::Part ), MappedSize ) ||
+        !IsRangeInFile( header.VertexDataOffset, header.VertexDataSize, MappedSize ) ||
+        !IsRangeInFile( header.IndexDataOffset, header.IndexDataSize, MappedSize ) ) {
+      Unmap();
+      return false;
+    }
+
+    Attributes.resize( header.AttributeCount );
+    if( header.AttributeCount > 0 ) {
+      std::memcpy( &Attributes[0], MappedData + header.AttributesOffset, header.AttributeCount * sizeof( MeshVertexAttribute ) );
+    }
+    Parts.resize( header.PartCount );
+    if( header.PartCount > 0 ) {
+      std::memcpy( &Parts[0], MappedData + header.PartsOffset, header.PartCount * sizeof( IndexedMesh::Part ) );
+    }
+
+    uint32_t const index_size = VK_INDEX_TYPE_UINT16 == header.IndexType ? sizeof( uint16_t ) : sizeof( uint32_t );
+    for( auto & part : Parts ) {
+      if( (static_cast<uint64_t>(part.VertexOffset) + part.VertexCount) * header.VertexStride > header.VertexDataSize ||
+          (static_cast<uint64_t>(part.IndexOffset) + part.IndexCount) * index_size > header.IndexDataSize ) {
+        Unmap();
+        return false;
+      }
+    }
+
+    VertexStride = header.VertexStride;
+    IndexType = static_cast<VkIndexType>(header.IndexType);
+    VertexDataOffset = header.VertexDataOffset;
+    VertexDataSize = header.VertexDataSize;
+    IndexDataOffset = header.IndexDataOffset;
+    IndexDataSize = header.IndexDataSize;
+    return true;
+  }
+
+  void MappedMesh::Unmap() {
+    if( !OwnedData.empty() ) {
+      OwnedData.clear();
+    } else if( nullptr != MappedData ) {
+#ifdef _WIN32
+      UnmapViewOfFile( MappedData );
+#else
+      munmap( MappedData, MappedSize );
+#endif
+    }
+    MappedData = nullptr;
+    MappedSize = 0;
+    VertexStride = 0;
+    Attributes.clear();
+    Parts.clear();
+    VertexDataOffset = 0;
+    VertexDataSize = 0;
+    IndexDataOffset = 0;
+    IndexDataSize = 0;
+  }
+
+  bool MappedMesh::IsMapped() const {
+    return nullptr != MappedData;
+  }
+
+  uint32_t MappedMesh::GetVertexStride() const {
+    return VertexStride;
+  }
+
+  std::vector<MeshVertexAttribute> const & MappedMesh::GetAttributes() const {
+    return Attributes;
+  }
+
+  std::vector<IndexedMesh::Part> const & MappedMesh::GetParts() const {
+    return Parts;
+  }
+
+  VkIndexType MappedMesh::GetIndexType() const {
+    return IndexType;
+  }
+
+  void * MappedMesh::GetVertexData() const {
+    return MappedData ? MappedData + VertexDataOffset : nullptr;
+  }
+
+  VkDeviceSize MappedMesh::GetVertexDataSize() const {
+    return VertexDataSize;
+  }
+
+  void * MappedMesh::GetIndexData() const {
+    return MappedData ? MappedData + IndexDataOffset : nullptr;
+  }
+
+  VkDeviceSize MappedMesh::GetIndexDataSize() const {
+    return IndexDataSize;
+  }
+
+  std::string GetMeshCacheFilename( char const * source_filename,
+                                    uint32_t     load_flags ) {
+    // Path of the source file is flattened, so files with the same name from different directories don't collide
+    std::string name = source_filename;
+    for( auto & character : name ) {
+      if( ('/' == character) || ('\\' == character) || (':' == character) ) {
+        character = '_';
+      }
+    }
+    return GetMeshCacheDirectory() + name + "." + std::to_string( load_flags ) + ".meshcache";
+  }
+
+  bool GetMeshCacheKey( char const   * source_filename,
+                        uint32_t       load_flags,
+                        MeshCacheKey & key ) {
+    struct stat file_status;
+    if( 0 != stat( source_filename, &file_status ) ) {
+      std::cout << "Could not open the '" << source_filename << "' file." << std::endl;
+      return false;
+    }
+    key.SourceSize = static_cast<uint64_t>(file_status.st_size);
+    key.SourceModificationTime = static_cast<int64_t>(file_status.st_mtime);
+    key.LoadFlags = load_flags;
+    return true;
+  }
+
+  bool SaveMeshCacheFile( std::string const  & filename,
+                          IndexedMesh const  & mesh,
+                          uint32_t             vertex_stride,
+                          MeshCacheKey const & key ) {
+    std::vector<unsigned char> contents;
+    if( !CreateMeshCacheContents( mesh, vertex_stride, key, contents ) ) {
+      return false;
+    }
+    return SaveBinaryFile( filename, contents );
+  }
+
+  bool Load3DModelFromObjFile( char const * filename,
+                               bool         load_normals,
+                               bool         load_texcoords,
+                               bool         generate_tangent_space_vectors,
+                               bool         unify,
+                               MappedMesh & mesh,
+                               ThreadPool * thread_pool ) {
+    uint32_t load_flags = (load_normals ? MESH_CACHE_LOAD_NORMALS : 0) |
+                          (load_texcoords ? MESH_CACHE_LOAD_TEXCOORDS : 0) |
+                          (generate_tangent_space_vectors ? MESH_CACHE_GENERATE_TANGENT_SPACE : 0) |
+                          (unify ? MESH_CACHE_UNIFY : 0);
+    MeshCacheKey key;
+    if( !GetMeshCacheKey( filename, load_flags, key ) ) {
+      return false;
+    }
+
+    std::string cache_filename = GetMeshCacheFilename( filename, load_flags );
+    if( mesh.Map( cache_filename, key ) ) {
+      return true;
+    }
+
+    IndexedMesh indexed_mesh;
+    uint32_t    vertex_stride;
+    if( !Load3DModelFromObjFile( filename, load_normals, load_texcoords, generate_tangent_space_vectors, unify, indexed_mesh, &vertex_stride, nullptr, thread_pool ) ) {
+      return false;
+    }
+    if( !OptimizeIndexedMesh( indexed_mesh, vertex_stride, MESH_CACHE_VERTEX_CACHE_SIZE, true ) ) {
+      return false;
+    }
+    // The cache only speeds up subsequent loads, so when it can't be written or mapped, the converted mesh is used from memory
+    if( SaveMeshCacheFile( cache_filename, indexed_mesh, vertex_stride, key ) &&
+        mesh.Map( cache_filename, key ) ) {
+      return true;
+    }
+    std::cout << "Could not use the '" << cache_filename << "' mesh cache file, the mesh is kept in memory." << std::endl;
+    return mesh.Assign( indexed_mesh, vertex_stride, key );
+  }
+
+} // namespace VulkanCookbook
@@ -0,0 +1,129 @@
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and / or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The below copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// Chapter: 10 Helper Recipes
+// Recipe:  10 Caching a 3D model in a binary file
+
+#ifndef CACHING_A_3D_MODEL_IN_A_BINARY_FILE
+#define CACHING_A_3D_MODEL_IN_A_BINARY_FILE
+
+#include "10 Helper Recipes/09 Optimizing an indexed mesh for the post-transform vertex cache.h"
+
+namespace VulkanCookbook {
+
+  enum MeshCacheLoadFlags {
+    MESH_CACHE_LOAD_NORMALS               = 0x1,
+    MESH_CACHE_LOAD_TEXCOORDS             = 0x2,
+    MESH_CACHE_GENERATE_TANGENT_SPACE     = 0x4,
+    MESH_CACHE_UNIFY                      = 0x8
+  };
+
+  // Cached data is valid only for the same source file and the same load flags
+
+  struct MeshCacheKey {
+    uint64_t  SourceSize;
+    int64_t   SourceModificationTime;
+    uint32_t  LoadFlags;
+  };
+
+  struct MeshVertexAttribute {
+    uint32_t  Offset;
+    uint32_t  ComponentCount;
+  };
+
+  // Binary mesh file mapped into memory. Vertex and index data can be copied directly from the
+  // mapped pages (e.g. into a staging buffer). Pages are mapped copy-on-write, so the file is never modified.
+  // When a cache file can't be written, the same data is kept in memory instead.
+
+  class MappedMesh {
+  public:
+    MappedMesh();
+    ~MappedMesh();
+
+    bool                                      Map( std::string const  & filename,
+                                                   MeshCacheKey const & key );
+    bool                                      Assign( IndexedMesh const  & mesh,
+                                                    uint32_t             vertex_stride,
+                                                    MeshCacheKey const & key );
+    void                                      Unmap();
+    bool                                      IsMapped() const;
+    uint32_t                                  GetVertexStride() const;
+    std::vector<MeshVertexAttribute> const  & GetAttributes() const;
+    std::vector<IndexedMesh::Part> const    & GetParts() const;
+    VkIndexType                               GetIndexType() const;
+    void                                    * GetVertexData() const;
+    VkDeviceSize                              GetVertexDataSize() const;
+    void                                    * GetIndexData() const;
+    VkDeviceSize                              GetIndexDataSize() const;
+
+  private:
+    MappedMesh( MappedMesh const & ) = delete;
+    MappedMesh & operator=( MappedMesh const & ) = delete;
+
+    bool  ReadHeader( MeshCacheKey const & key );
+
+    std::vector<unsigned char>        OwnedData;
+    unsigned char                   * MappedData;
+    size_t                            MappedSize;
+    uint32_t                          VertexStride;
+    std::vector<MeshVertexAttribute>  Attributes;
+    std::vector<IndexedMesh::Part>    Parts;
+    VkIndexType                       IndexType;
+    VkDeviceSize                      VertexDataOffset;
+    VkDeviceSize                      VertexDataSize;
+    VkDeviceSize                      IndexDataOffset;
+    VkDeviceSize                      IndexDataSize;
+  };
+
+  // Cache files are stored in a per-user cache directory instead of next to the source files
+
+  std::string GetMeshCacheFilename( char const * source_filename,
+                                    uint32_t     load_flags );
+
+  bool GetMeshCacheKey( char const   * source_filename,
+                        uint32_t       load_flags,
+                        MeshCacheKey & key );
+
+  bool SaveMeshCacheFile( std::string const  & filename,
+                          IndexedMesh const  & mesh,
+                          uint32_t             vertex_stride,
+                          MeshCacheKey const & key );
+
+  // Mesh is loaded from the '<filename>.<flags>.meshcache' file when it matches the source file.
+  // Otherwise the OBJ file is parsed, converted into an indexed mesh optimized for the vertex cache,
+  // and stored in the cache file, which is then mapped. If the cache file can't be written,
+  // the converted mesh is used directly from memory.
+
+  bool Load3DModelFromObjFile( char const * filename,
+                               bool         load_normals,
+                               bool         load_texcoords,
+                               bool         generate_tangent_space_vectors,
+                               bool         unify,
+                               MappedMesh & mesh,
+                               ThreadPool * thread_pool = nullptr );
+
+} // namespace VulkanCookbook
+
+#endif // CACHING_A_3D_MODEL_IN_A_BINARY_FILE
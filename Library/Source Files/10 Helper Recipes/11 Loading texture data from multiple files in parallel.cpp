@@ -0,0 +1,162 @@
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and / or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The below copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// Chapter: 10 Helper Recipes
+// Recipe:  11 Loading texture data from multiple files in parallel
+
+#include <chrono>
+#include "10 Helper Recipes/11 Loading texture data from multiple files in parallel.h"
+#include "stb_image.h"
+
+namespace VulkanCookbook {
+
+  namespace {
+
+    void DecodeTextureFile( TextureDecodeRequest const & request,
+                            TextureDecodeResult        & result ) {
+      auto start_time = std::chrono::steady_clock::now();
+
+      result = {};
+      int width = 0;
+      int height = 0;
+      int num_components = 0;
+      std::unique_ptr<unsigned char, void(*)(void*)> stbi_data( stbi_load( request.Filename.c_str(), &width, &height, &num_components, request.NumRequestedComponents ), stbi_image_free );
+
+      if( stbi_data &&
+          (0 < width) &&
+          (0 < height) &&
+          (0 < num_components) ) {
+        int data_size = width * height * (0 < request.NumRequestedComponents ? request.NumRequestedComponents : num_components);
+        if( static_cast<size_t>(data_size) <= request.DestinationSize ) {
+          std::memcpy( request.Destination, stbi_data.get(), data_size );
+          result.Succeeded = true;
+          result.Data = request.Destination;
+          result.Width = width;
+          result.Height = height;
+          result.NumComponents = num_components;
+          result.DataSize = data_size;
+        }
+      }
+
+      result.DecodeTime = std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - start_time ).count();
+    }
+
+  } // namespace
+
+  bool GetTextureFileDescription( char const             * filename,
+                                  int                      num_requested_components,
+                                  TextureFileDescription & description ) {
+    int width = 0;
+    int height = 0;
+    int num_components = 0;
+    if( (!stbi_info( filename, &width, &height, &num_components )) ||
+        (0 >= width) ||
+        (0 >= height) ||
+        (0 >= num_components) ) {
+      std::cout << "Could not read image '" << filename << "'!" << std::endl;
+      return false;
+    }
+
+    description.Width = width;
+    description.Height = height;
+    description.NumComponents = num_components;
+    description.DataSize = width * height * (0 < num_requested_components ? num_requested_components : num_components);
+    return true;
+  }
+
+  bool LoadTextureDataFromFiles( std::vector<TextureDecodeRequest> const & requests,
+                                 std::vector<TextureDecodeResult>        & results,
+                                 ThreadPool                              * thread_pool ) {
+    results.assign( requests.size(), TextureDecodeResult() );
+
+    // Waiting for the pool on one of its own workers could block it, so temporary threads are used then
+    if( (nullptr != thread_pool) &&
+        (0 < thread_pool->GetThreadsCount()) &&
+        !thread_pool->IsWorkerThread() ) {
+      Latch latch( static_cast<uint32_t>(requests.size()) );
+      for( size_t i = 0; i < requests.size(); ++i ) {
+        thread_pool->Execute( [&, i]( uint32_t ) {
+          DecodeTextureFile( requests[i], results[i] );
+          latch.CountDown();
+        } );
+      }
+      latch.Wait();
+    } else {
+      size_t threads_count = std::max<size_t>( 1, std::min<size_t>( std::thread::hardware_concurrency(), requests.size() ) );
+      std::atomic<size_t> next_request( 0 );
+      std::vector<std::thread> threads;
+      for( size_t i = 0; i < threads_count; ++i ) {
+        threads.emplace_back( [&]() {
+          for( size_t index = next_request++; index < requests.size(); index = next_request++ ) {
+            DecodeTextureFile( requests[index], results[index] );
+          }
+        } );
+      }
+      for( auto & thread : threads ) {
+        thread.join();
+      }
+    }
+
+    bool succeeded = true;
+    for( size_t i = 0; i < requests.size(); ++i ) {
+      if( !results[i].Succeeded ) {
+        std::cout << "Could not read image '" << requests[i].Filename << "'!" << std::endl;
+        succeeded = false;
+      }
+    }
+    return succeeded;
+  }
+
+  bool LoadTextureDataFromFiles( std::vector<std::string> const   & filenames,
+                                 int                                num_requested_components,
+                                 std::vector<unsigned char>       & image_data,
+                                 std::vector<TextureDecodeResult> & results,
+                                 ThreadPool                       * thread_pool ) {
+    std::vector<TextureFileDescription> descriptions( filenames.size() );
+    size_t total_data_size = 0;
+    for( size_t i = 0; i < filenames.size(); ++i ) {
+      if( !GetTextureFileDescription( filenames[i].c_str(), num_requested_components, descriptions[i] ) ) {
+        return false;
+      }
+      total_data_size += descriptions[i].DataSize;
+    }
+
+    image_data.resize( total_data_size );
+    std::vector<TextureDecodeRequest> requests( filenames.size() );
+    size_t offset = 0;
+    for( size_t i = 0; i < filenames.size(); ++i ) {
+      requests[i] = {
+        filenames[i],
+        num_requested_components,
+        image_data.data() + offset,
+        static_cast<size_t>(descriptions[i].DataSize)
+      };
+      offset += descriptions[i].DataSize;
+    }
+
+    return LoadTextureDataFromFiles( requests, results, thread_pool );
+  }
+
+} // namespace VulkanCookbook
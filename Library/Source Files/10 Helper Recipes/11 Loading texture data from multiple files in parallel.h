@@ -0,0 +1,85 @@
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and / or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The below copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// Chapter: 10 Helper Recipes
+// Recipe:  11 Loading texture data from multiple files in parallel
+
+#ifndef LOADING_TEXTURE_DATA_FROM_MULTIPLE_FILES_IN_PARALLEL
+#define LOADING_TEXTURE_DATA_FROM_MULTIPLE_FILES_IN_PARALLEL
+
+#include "09 Command Recording and Drawing/21 Recording command buffers on a persistent pool of threads.h"
+
+namespace VulkanCookbook {
+
+  struct TextureFileDescription {
+    int                     Width;
+    int                     Height;
+    int                     NumComponents;
+    int                     DataSize;
+  };
+
+  struct TextureDecodeRequest {
+    std::string             Filename;
+    int                     NumRequestedComponents;
+    unsigned char         * Destination;
+    size_t                  DestinationSize;
+  };
+
+  struct TextureDecodeResult {
+    bool                    Succeeded;
+    unsigned char         * Data;
+    int                     Width;
+    int                     Height;
+    int                     NumComponents;
+    int                     DataSize;
+    double                  DecodeTime;     // in milliseconds
+  };
+
+  // Reads only the header of an image file, so memory for its decoded data can be prepared up front
+
+  bool GetTextureFileDescription( char const             * filename,
+                                  int                      num_requested_components,
+                                  TextureFileDescription & description );
+
+  // Each file is decoded on a separate task and its data is written straight into the memory
+  // provided by the caller (e.g. a part of one big allocation or of mapped staging memory).
+  // When a thread pool isn't provided, temporary threads are created for the duration of the call.
+
+  bool LoadTextureDataFromFiles( std::vector<TextureDecodeRequest> const & requests,
+                                 std::vector<TextureDecodeResult>        & results,
+                                 ThreadPool                              * thread_pool = nullptr );
+
+  // Data of all images is stored one after another in a single vector, in the order of file names;
+  // Data members of results point to the data of each image
+
+  bool LoadTextureDataFromFiles( std::vector<std::string> const   & filenames,
+                                 int                                num_requested_components,
+                                 std::vector<unsigned char>       & image_data,
+                                 std::vector<TextureDecodeResult> & results,
+                                 ThreadPool                       * thread_pool = nullptr );
+
+} // namespace VulkanCookbook
+
+#endif // LOADING_TEXTURE_DATA_FROM_MULTIPLE_FILES_IN_PARALLEL
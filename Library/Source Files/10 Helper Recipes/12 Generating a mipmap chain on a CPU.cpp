@@ -0,0 +1,212 @@
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and / or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The below copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// Chapter: 10 Helper Recipes
+// Recipe:  12 Generating a mipmap chain on a CPU
+
+#include <algorithm>
+#include <cmath>
+#include "10 Helper Recipes/12 Generating a mipmap chain on a CPU.h"
+
+#if defined( __SSE__ ) || defined( _M_X64 ) || (defined( _M_IX86_FP ) && (_M_IX86_FP >= 1))
+#define MIPMAP_GENERATION_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace VulkanCookbook {
+
+  namespace {
+
+    float SrgbToLinear( float value ) {
+      return value <= 0.04045f ? value / 12.92f : std::pow( (value + 0.055f) / 1.055f, 2.4f );
+    }
+
+    struct SrgbConversionTables {
+      static const int  EncodeBucketsCount = 4096;
+
+      float          Decode[256];
+      float          EncodeThresholds[256];                 // linear values half way between neighbouring sRGB codes
+      unsigned char  EncodeBuckets[EncodeBucketsCount + 1]; // smallest code of linear values in each bucket
+
+      SrgbConversionTables() {
+        for( int i = 0; i < 256; ++i ) {
+          Decode[i] = SrgbToLinear( i / 255.0f );
+        }
+        for( int i = 0; i < 255; ++i ) {
+          EncodeThresholds[i] = SrgbToLinear( (i + 0.5f) / 255.0f );
+        }
+        EncodeThresholds[255] = 2.0f;
+        int code = 0;
+        for( int i = 0; i <= EncodeBucketsCount; ++i ) {
+          while( EncodeThresholds[code] <= static_cast<float>(i) / EncodeBucketsCount ) {
+            ++code;
+          }
+          EncodeBuckets[i] = static_cast<unsigned char>(code);
+        }
+      }
+    };
+
+    SrgbConversionTables const & GetSrgbConversionTables() {
+      static SrgbConversionTables tables;
+      return tables;
+    }
+
+    unsigned char EncodeLinear( float value ) {
+      return static_cast<unsigned char>(std::min( std::max( value * 255.0f + 0.5f, 0.0f ), 255.0f ));
+    }
+
+    unsigned char EncodeSrgb( float                        value,
+                              SrgbConversionTables const & tables ) {
+      // Sought code is the number of thresholds not greater than the value - gives the same result as
+      // rounding the exactly encoded value, without calling pow(). Buckets narrow the search to a step or two.
+      value = std::min( std::max( value, 0.0f ), 1.0f );
+      int code = tables.EncodeBuckets[static_cast<int>(value * SrgbConversionTables::EncodeBucketsCount)];
+      while( tables.EncodeThresholds[code] <= value ) {
+        ++code;
+      }
+      return static_cast<unsigned char>(code);
+    }
+
+    void DownsampleLevel( std::vector<float> const & source,
+                          uint32_t                   source_width,
+                          uint32_t                   source_height,
+                          int                        num_components,
+                          std::vector<float>       & destination,
+                          uint32_t                   destination_width,
+                          uint32_t                   destination_height ) {
+      destination.resize( static_cast<size_t>(destination_width) * destination_height * num_components );
+
+      for( uint32_t y = 0; y < destination_height; ++y ) {
+        // Last row and column of an odd-sized level are clamped
+        float const * row_0 = &source[static_cast<size_t>(std::min( 2 * y, source_height - 1 )) * source_width * num_components];
+        float const * row_1 = &source[static_cast<size_t>(std::min( 2 * y + 1, source_height - 1 )) * source_width * num_components];
+        float * destination_row = &destination[static_cast<size_t>(y) * destination_width * num_components];
+
+        for( uint32_t x = 0; x < destination_width; ++x ) {
+          uint32_t x_0 = std::min( 2 * x, source_width - 1 ) * num_components;
+          uint32_t x_1 = std::min( 2 * x + 1, source_width - 1 ) * num_components;
+
+#ifdef MIPMAP_GENERATION_SSE
+          if( 4 == num_components ) {
+            __m128 sum = _mm_add_ps( _mm_add_ps( _mm_loadu_ps( row_0 + x_0 ), _mm_loadu_ps( row_0 + x_1 ) ),
+                                     _mm_add_ps( _mm_loadu_ps( row_1 + x_0 ), _mm_loadu_ps( row_1 + x_1 ) ) );
+            _mm_storeu_ps( destination_row + 4 * x, _mm_mul_ps( sum, _mm_set1_ps( 0.25f ) ) );
+            continue;
+          }
+#endif
+          for( int c = 0; c < num_components; ++c ) {
+            destination_row[x * num_components + c] = 0.25f * ((row_0[x_0 + c] + row_0[x_1 + c]) + (row_1[x_0 + c] + row_1[x_1 + c]));
+          }
+        }
+      }
+    }
+
+  } // namespace
+
+  uint32_t GetMipmapLevelsCount( uint32_t width,
+                                 uint32_t height ) {
+    uint32_t levels_count = 1;
+    for( uint32_t size = std::max( width, height ); size > 1; size /= 2 ) {
+      ++levels_count;
+    }
+    return levels_count;
+  }
+
+  bool GenerateMipmapChain( unsigned char const        * image_data,
+                            uint32_t                     width,
+                            uint32_t                     height,
+                            int                          num_components,
+                            bool                         srgb,
+                            std::vector<unsigned char> & mipmap_data,
+                            std::vector<MipmapLevel>   & levels ) {
+    if( (nullptr == image_data) ||
+        (0 == width) ||
+        (0 == height) ||
+        (0 >= num_components) ||
+        (4 < num_components) ) {
+      std::cout << "Could not generate mipmaps: invalid image data." << std::endl;
+      return false;
+    }
+
+    uint32_t levels_count = GetMipmapLevelsCount( width, height );
+    levels.resize( levels_count );
+    size_t total_data_size = 0;
+    for( uint32_t level = 0; level < levels_count; ++level ) {
+      levels[level].Width = std::max( 1u, width >> level );
+      levels[level].Height = std::max( 1u, height >> level );
+      levels[level].Offset = total_data_size;
+      levels[level].DataSize = static_cast<size_t>(levels[level].Width) * levels[level].Height * num_components;
+      total_data_size += levels[level].DataSize;
+    }
+    mipmap_data.resize( total_data_size );
+    std::memcpy( mipmap_data.data(), image_data, levels[0].DataSize );
+
+    // Components which hold color and are (optionally) sRGB encoded
+    SrgbConversionTables const & tables = GetSrgbConversionTables();
+    int color_components = (srgb ? (0 == num_components % 2 ? num_components - 1 : num_components) : 0);
+
+    // Intermediate levels are kept in floating-point precision, so rounding errors don't accumulate
+    std::vector<float> current_level( levels[0].DataSize );
+    for( size_t i = 0; i < levels[0].DataSize; i += num_components ) {
+      for( int c = 0; c < num_components; ++c ) {
+        current_level[i + c] = (c < color_components ? tables.Decode[image_data[i + c]] : image_data[i + c] / 255.0f);
+      }
+    }
+
+    std::vector<float> next_level;
+    for( uint32_t level = 1; level < levels_count; ++level ) {
+      DownsampleLevel( current_level, levels[level - 1].Width, levels[level - 1].Height, num_components, next_level, levels[level].Width, levels[level].Height );
+
+      unsigned char * level_data = &mipmap_data[levels[level].Offset];
+      for( size_t i = 0; i < levels[level].DataSize; i += num_components ) {
+        for( int c = 0; c < num_components; ++c ) {
+          level_data[i + c] = (c < color_components ? EncodeSrgb( next_level[i + c], tables ) : EncodeLinear( next_level[i + c] ));
+        }
+      }
+      current_level.swap( next_level );
+    }
+    return true;
+  }
+
+  bool LoadTextureDataFromFile( char const                 * filename,
+                                int                          num_requested_components,
+                                bool                         srgb,
+                                std::vector<unsigned char> & mipmap_data,
+                                std::vector<MipmapLevel>   & levels,
+                                int                        * image_num_components ) {
+    std::vector<unsigned char> image_data;
+    int width;
+    int height;
+    int num_components;
+    if( !LoadTextureDataFromFile( filename, num_requested_components, image_data, &width, &height, &num_components ) ) {
+      return false;
+    }
+    if( image_num_components ) {
+      *image_num_components = num_components;
+    }
+    return GenerateMipmapChain( image_data.data(), width, height, 0 < num_requested_components ? num_requested_components : num_components, srgb, mipmap_data, levels );
+  }
+
+} // namespace VulkanCookbook
@@ -0,0 +1,68 @@
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and / or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The below copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// Chapter: 10 Helper Recipes
+// Recipe:  12 Generating a mipmap chain on a CPU
+
+#ifndef GENERATING_A_MIPMAP_CHAIN_ON_A_CPU
+#define GENERATING_A_MIPMAP_CHAIN_ON_A_CPU
+
+#include "10 Helper Recipes/06 Loading texture data from a file.h"
+
+namespace VulkanCookbook {
+
+  struct MipmapLevel {
+    uint32_t  Width;
+    uint32_t  Height;
+    size_t    Offset;
+    size_t    DataSize;
+  };
+
+  uint32_t GetMipmapLevelsCount( uint32_t width,
+                                 uint32_t height );
+
+  // Generates all levels down to 1x1 (level 0 is a copy of the source data), tightly packed one
+  // after another. Each level is a 2x2 box-filtered version of the previous one. When srgb is true,
+  // color components are treated as sRGB encoded and are averaged in linear space; the alpha
+  // component (the last one of 2- and 4-component data) is always averaged as is.
+
+  bool GenerateMipmapChain( unsigned char const        * image_data,
+                            uint32_t                     width,
+                            uint32_t                     height,
+                            int                          num_components,
+                            bool                         srgb,
+                            std::vector<unsigned char> & mipmap_data,
+                            std::vector<MipmapLevel>   & levels );
+
+  bool LoadTextureDataFromFile( char const                 * filename,
+                                int                          num_requested_components,
+                                bool                         srgb,
+                                std::vector<unsigned char> & mipmap_data,
+                                std::vector<MipmapLevel>   & levels,
+                                int                        * image_num_components = nullptr );
+
+} // namespace VulkanCookbook
+
+#endif // GENERATING_A_MIPMAP_CHAIN_ON_A_CPU
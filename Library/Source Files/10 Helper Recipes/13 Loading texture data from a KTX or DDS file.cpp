@@ -0,0 +1,400 @@
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and / or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The below copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// Chapter: 10 Helper Recipes
+// Recipe:  13 Loading texture data from a KTX or DDS file
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include "10 Helper Recipes/13 Loading texture data from a KTX or DDS file.h"
+
+namespace VulkanCookbook {
+
+  namespace {
+
+    // Texture containers store values in little endian order, as do all platforms supported by the library
+
+    template<class Type>
+    bool ReadValue( std::vector<unsigned char> const & file_data,
+                    size_t                             offset,
+                    Type                             & value ) {
+      if( offset + sizeof( Type ) > file_data.size() ) {
+        return false;
+      }
+      std::memcpy( &value, &file_data[offset], sizeof( Type ) );
+      return true;
+    }
+
+    // Values read from a file can't be trusted, so products of sizes and counts are checked for overflows
+    template<class Type>
+    bool Multiply( Type   first,
+                   Type   second,
+                   Type & result ) {
+      if( (0 != first) &&
+          (second > std::numeric_limits<Type>::max() / first) ) {
+        return false;
+      }
+      result = first * second;
+      return true;
+    }
+
+    // Checks whether a given number of bytes starting at a given offset is available in a file
+    bool CheckIfDataIsInFile( std::vector<unsigned char> const & file_data,
+                              size_t                             offset,
+                              size_t                             data_size ) {
+      return (offset <= file_data.size()) &&
+             (data_size <= file_data.size() - offset);
+    }
+
+    // Size of a 4x4 block for compressed formats or of a single texel for uncompressed ones
+    uint32_t GetFormatBlockSize( VkFormat format ) {
+      switch( format ) {
+      case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+      case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+      case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+      case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+      case VK_FORMAT_BC4_UNORM_BLOCK:
+      case VK_FORMAT_BC4_SNORM_BLOCK:
+        return 8;
+      case VK_FORMAT_BC2_UNORM_BLOCK:
+      case VK_FORMAT_BC2_SRGB_BLOCK:
+      case VK_FORMAT_BC3_UNORM_BLOCK:
+      case VK_FORMAT_BC3_SRGB_BLOCK:
+      case VK_FORMAT_BC5_UNORM_BLOCK:
+      case VK_FORMAT_BC5_SNORM_BLOCK:
+      case VK_FORMAT_BC6H_UFLOAT_BLOCK:
+      case VK_FORMAT_BC6H_SFLOAT_BLOCK:
+      case VK_FORMAT_BC7_UNORM_BLOCK:
+      case VK_FORMAT_BC7_SRGB_BLOCK:
+        return 16;
+      case VK_FORMAT_R8G8B8A8_UNORM:
+      case VK_FORMAT_R8G8B8A8_SRGB:
+        return 4;
+      default:
+        return 0;
+      }
+    }
+
+    bool GetSubresourceDataSize( VkFormat    format,
+                                 VkExtent3D  size,
+                                 size_t    & data_size ) {
+      size_t width = size.width;
+      size_t height = size.height;
+      if( CheckIfFormatIsBlockCompressed( format ) ) {
+        width = (width + 3) / 4;
+        height = (height + 3) / 4;
+      }
+      return Multiply<size_t>( width, height, data_size ) &&
+             Multiply<size_t>( data_size, size.depth, data_size ) &&
+             Multiply<size_t>( data_size, GetFormatBlockSize( format ), data_size );
+    }
+
+    // Full mipmap chain ends with a level whose all dimensions are equal to 1
+    uint32_t GetMaxMipmapLevelsCount( VkExtent3D size ) {
+      uint32_t max_dimension = std::max( std::max( size.width, size.height ), size.depth );
+      uint32_t levels_count = 1;
+      while( max_dimension > 1 ) {
+        max_dimension >>= 1;
+        ++levels_count;
+      }
+      return levels_count;
+    }
+
+    VkExtent3D GetMipmapLevelSize( VkExtent3D  size,
+                                   uint32_t    mipmap_level ) {
+      // Shifting by the number of bits of a type (or more) is undefined
+      if( mipmap_level >= 32 ) {
+        return { 1, 1, 1 };
+      }
+      return {
+        std::max( 1u, size.width >> mipmap_level ),
+        std::max( 1u, size.height >> mipmap_level ),
+        std::max( 1u, size.depth >> mipmap_level )
+      };
+    }
+
+    VkFormat GetFormatFromDxgiFormat( uint32_t dxgi_format ) {
+      switch( dxgi_format ) {
+      case 28: return VK_FORMAT_R8G8B8A8_UNORM;     // DXGI_FORMAT_R8G8B8A8_UNORM
+      case 29: return VK_FORMAT_R8G8B8A8_SRGB;      // DXGI_FORMAT_R8G8B8A8_UNORM_SRGB
+      case 71: return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+      case 72: return VK_FORMAT_BC1_RGBA_SRGB_BLOCK;
+      case 74: return VK_FORMAT_BC2_UNORM_BLOCK;
+      case 75: return VK_FORMAT_BC2_SRGB_BLOCK;
+      case 77: return VK_FORMAT_BC3_UNORM_BLOCK;
+      case 78: return VK_FORMAT_BC3_SRGB_BLOCK;
+      case 80: return VK_FORMAT_BC4_UNORM_BLOCK;
+      case 81: return VK_FORMAT_BC4_SNORM_BLOCK;
+      case 83: return VK_FORMAT_BC5_UNORM_BLOCK;
+      case 84: return VK_FORMAT_BC5_SNORM_BLOCK;
+      case 95: return VK_FORMAT_BC6H_UFLOAT_BLOCK;
+      case 96: return VK_FORMAT_BC6H_SFLOAT_BLOCK;
+      case 98: return VK_FORMAT_BC7_UNORM_BLOCK;
+      case 99: return VK_FORMAT_BC7_SRGB_BLOCK;
+      default: return VK_FORMAT_UNDEFINED;
+      }
+    }
+
+    VkFormat GetFormatFromFourCC( uint32_t four_cc ) {
+      auto make_four_cc = []( char const * code ) {
+        return static_cast<uint32_t>(code[0]) | (static_cast<uint32_t>(code[1]) << 8) | (static_cast<uint32_t>(code[2]) << 16) | (static_cast<uint32_t>(code[3]) << 24);
+      };
+      if( make_four_cc( "DXT1" ) == four_cc ) {
+        return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+      } else if( (make_four_cc( "DXT2" ) == four_cc) || (make_four_cc( "DXT3" ) == four_cc) ) {
+        return VK_FORMAT_BC2_UNORM_BLOCK;
+      } else if( (make_four_cc( "DXT4" ) == four_cc) || (make_four_cc( "DXT5" ) == four_cc) ) {
+        return VK_FORMAT_BC3_UNORM_BLOCK;
+      } else if( (make_four_cc( "ATI1" ) == four_cc) || (make_four_cc( "BC4U" ) == four_cc) ) {
+        return VK_FORMAT_BC4_UNORM_BLOCK;
+      } else if( make_four_cc( "BC4S" ) == four_cc ) {
+        return VK_FORMAT_BC4_SNORM_BLOCK;
+      } else if( (make_four_cc( "ATI2" ) == four_cc) || (make_four_cc( "BC5U" ) == four_cc) ) {
+        return VK_FORMAT_BC5_UNORM_BLOCK;
+      } else if( make_four_cc( "BC5S" ) == four_cc ) {
+        return VK_FORMAT_BC5_SNORM_BLOCK;
+      }
+      return VK_FORMAT_UNDEFINED;
+    }
+
+    VkFormat GetFormatFromGlInternalFormat( uint32_t gl_internal_format ) {
+      switch( gl_internal_format ) {
+      case 0x8058: return VK_FORMAT_R8G8B8A8_UNORM;         // GL_RGBA8
+      case 0x8C43: return VK_FORMAT_R8G8B8A8_SRGB;          // GL_SRGB8_ALPHA8
+      case 0x83F0: return VK_FORMAT_BC1_RGB_UNORM_BLOCK;    // GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+      case 0x83F1: return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;   // GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+      case 0x83F2: return VK_FORMAT_BC2_UNORM_BLOCK;        // GL_COMPRESSED_RGBA_S3TC_DXT3_EXT
+      case 0x83F3: return VK_FORMAT_BC3_UNORM_BLOCK;        // GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+      case 0x8C4C: return VK_FORMAT_BC1_RGB_SRGB_BLOCK;     // GL_COMPRESSED_SRGB_S3TC_DXT1_EXT
+      case 0x8C4D: return VK_FORMAT_BC1_RGBA_SRGB_BLOCK;    // GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT
+      case 0x8C4E: return VK_FORMAT_BC2_SRGB_BLOCK;         // GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT
+      case 0x8C4F: return VK_FORMAT_BC3_SRGB_BLOCK;         // GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT
+      case 0x8DBB: return VK_FORMAT_BC4_UNORM_BLOCK;        // GL_COMPRESSED_RED_RGTC1
+      case 0x8DBC: return VK_FORMAT_BC4_SNORM_BLOCK;        // GL_COMPRESSED_SIGNED_RED_RGTC1
+      case 0x8DBD: return VK_FORMAT_BC5_UNORM_BLOCK;        // GL_COMPRESSED_RG_RGTC2
+      case 0x8DBE: return VK_FORMAT_BC5_SNORM_BLOCK;        // GL_COMPRESSED_SIGNED_RG_RGTC2
+      case 0x8E8C: return VK_FORMAT_BC7_UNORM_BLOCK;        // GL_COMPRESSED_RGBA_BPTC_UNORM
+      case 0x8E8D: return VK_FORMAT_BC7_SRGB_BLOCK;         // GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM
+      case 0x8E8E: return VK_FORMAT_BC6H_SFLOAT_BLOCK;      // GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT
+      case 0x8E8F: return VK_FORMAT_BC6H_UFLOAT_BLOCK;      // GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT
+      default:     return VK_FORMAT_UNDEFINED;
+      }
+    }
+
+    bool ParseKtxFile( std::vector<unsigned char> const & file_data,
+                       uint32_t                           max_layers_count,
+                       TextureContainerData             & texture ) {
+      uint32_t header[13];
+      for( uint32_t i = 0; i < 13; ++i ) {
+        if( !ReadValue( file_data, 12 + 4 * i, header[i] ) ) {
+          return false;
+        }
+      }
+      if( 0x04030201 != header[0] ) {
+        std::cout << "Big endian KTX files are not supported." << std::endl;
+        return false;
+      }
+      texture.Format = GetFormatFromGlInternalFormat( header[4] );
+      texture.Size = { header[6], std::max( 1u, header[7] ), std::max( 1u, header[8] ) };
+      uint32_t array_elements = std::max( 1u, header[9] );
+      uint32_t faces = header[10];
+      texture.MipmapLevelsCount = std::max( 1u, header[11] );
+      texture.Cubemap = (6 == faces);
+      if( (VK_FORMAT_UNDEFINED == texture.Format) ||
+          ((1 != faces) && (6 != faces)) ) {
+        std::cout << "Unsupported KTX texture format or type." << std::endl;
+        return false;
+      }
+      if( (!Multiply( array_elements, faces, texture.LayersCount )) ||
+          (texture.LayersCount > max_layers_count) ||
+          (texture.MipmapLevelsCount > GetMaxMipmapLevelsCount( texture.Size )) ) {
+        std::cout << "Invalid number of KTX texture layers or mipmap levels." << std::endl;
+        return false;
+      }
+
+      // Levels are preceded by their size; faces of non-array cubemaps are padded to 4 bytes.
+      // Size of a level includes all its layers, apart from non-array cubemaps, for which it is the size of a single face
+      if( !CheckIfDataIsInFile( file_data, 64, header[12] ) ) {
+        return false;
+      }
+      size_t offset = 64 + header[12];
+      uint32_t layers_in_image_size = (texture.Cubemap && (0 == header[9])) ? 1 : texture.LayersCount;
+      for( uint32_t level = 0; level < texture.MipmapLevelsCount; ++level ) {
+        uint32_t image_size;
+        if( !ReadValue( file_data, offset, image_size ) ) {
+          return false;
+        }
+        offset += 4;
+        VkExtent3D level_size = GetMipmapLevelSize( texture.Size, level );
+        size_t subresource_size;
+        size_t level_data_size;
+        if( (!GetSubresourceDataSize( texture.Format, level_size, subresource_size )) ||
+            (!Multiply<size_t>( subresource_size, layers_in_image_size, level_data_size )) ||
+            (level_data_size > image_size) ||
+            (!CheckIfDataIsInFile( file_data, offset, image_size )) ) {
+          return false;
+        }
+        for( uint32_t layer = 0; layer < texture.LayersCount; ++layer ) {
+          if( !CheckIfDataIsInFile( file_data, offset, subresource_size ) ) {
+            return false;
+          }
+          texture.Subresources.push_back( { level, layer, level_size, offset, subresource_size } );
+          offset += (subresource_size + 3) / 4 * 4;
+        }
+      }
+      return true;
+    }
+
+    bool ParseDdsFile( std::vector<unsigned char> const & file_data,
+                       uint32_t                           max_layers_count,
+                       TextureContainerData             & texture ) {
+      uint32_t header[31];
+      for( uint32_t i = 0; i < 31; ++i ) {
+        if( !ReadValue( file_data, 4 + 4 * i, header[i] ) ) {
+          return false;
+        }
+      }
+      uint32_t height = header[2];
+      uint32_t width = header[3];
+      uint32_t depth = header[5];
+      uint32_t mipmap_count = header[6];
+      uint32_t pixel_format_flags = header[19];
+      uint32_t four_cc = header[20];
+      uint32_t caps_2 = header[27];
+      size_t offset = 128;
+
+      texture.Size = { width, std::max( 1u, height ), (caps_2 & 0x200000) ? std::max( 1u, depth ) : 1u };
+      texture.MipmapLevelsCount = std::max( 1u, mipmap_count );
+      texture.Cubemap = 0 != (caps_2 & 0x200);
+      texture.LayersCount = texture.Cubemap ? 6 : 1;
+
+      if( (pixel_format_flags & 0x4) &&
+          (0x30315844 == four_cc) ) {
+        // "DX10" - extended header with a DXGI format
+        uint32_t dx10_header[5];
+        for( uint32_t i = 0; i < 5; ++i ) {
+          if( !ReadValue( file_data, offset + 4 * i, dx10_header[i] ) ) {
+            return false;
+          }
+        }
+        offset += 20;
+        texture.Format = GetFormatFromDxgiFormat( dx10_header[0] );
+        texture.Cubemap = 0 != (dx10_header[2] & 0x4);
+        if( !Multiply( std::max( 1u, dx10_header[3] ), texture.Cubemap ? 6u : 1u, texture.LayersCount ) ) {
+          return false;
+        }
+      } else if( pixel_format_flags & 0x4 ) {
+        texture.Format = GetFormatFromFourCC( four_cc );
+      } else if( (pixel_format_flags & 0x40) &&
+                 (32 == header[21]) &&
+                 (0x000000FF == header[22]) &&
+                 (0x0000FF00 == header[23]) &&
+                 (0x00FF0000 == header[24]) ) {
+        texture.Format = VK_FORMAT_R8G8B8A8_UNORM;
+      } else {
+        texture.Format = VK_FORMAT_UNDEFINED;
+      }
+      if( VK_FORMAT_UNDEFINED == texture.Format ) {
+        std::cout << "Unsupported DDS texture format." << std::endl;
+        return false;
+      }
+      if( (texture.LayersCount > max_layers_count) ||
+          (texture.MipmapLevelsCount > GetMaxMipmapLevelsCount( texture.Size )) ) {
+        std::cout << "Invalid number of DDS texture layers or mipmap levels." << std::endl;
+        return false;
+      }
+
+      // All levels of a layer (or a cubemap face) are stored before the next layer
+      for( uint32_t layer = 0; layer < texture.LayersCount; ++layer ) {
+        for( uint32_t level = 0; level < texture.MipmapLevelsCount; ++level ) {
+          VkExtent3D level_size = GetMipmapLevelSize( texture.Size, level );
+          size_t subresource_size;
+          if( (!GetSubresourceDataSize( texture.Format, level_size, subresource_size )) ||
+              (!CheckIfDataIsInFile( file_data, offset, subresource_size )) ) {
+            return false;
+          }
+          texture.Subresources.push_back( { level, layer, level_size, offset, subresource_size } );
+          offset += subresource_size;
+        }
+      }
+      return true;
+    }
+
+  } // namespace
+
+  bool CheckIfFormatIsBlockCompressed( VkFormat format ) {
+    return (VK_FORMAT_BC1_RGB_UNORM_BLOCK <= format) &&
+           (VK_FORMAT_BC7_SRGB_BLOCK >= format);
+  }
+
+  bool LoadTextureDataFromContainerFile( char const           * filename,
+                                         TextureContainerData & texture,
+                                         uint32_t               max_layers_count ) {
+    texture = {};
+    std::vector<unsigned char> file_data;
+    if( !GetBinaryFileContents( filename, file_data ) ) {
+      return false;
+    }
+
+    static unsigned char const ktx_identifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n' };
+    bool parsed = false;
+    if( (file_data.size() >= 64) &&
+        (0 == std::memcmp( file_data.data(), ktx_identifier, sizeof( ktx_identifier ) )) ) {
+      parsed = ParseKtxFile( file_data, max_layers_count, texture );
+    } else if( (file_data.size() >= 128) &&
+               (0 == std::memcmp( file_data.data(), "DDS ", 4 )) ) {
+      parsed = ParseDdsFile( file_data, max_layers_count, texture );
+    } else {
+      std::cout << "File '" << filename << "' is neither a KTX nor a DDS file." << std::endl;
+      return false;
+    }
+
+    if( !parsed ||
+        (0 == texture.Size.width) ) {
+      std::cout << "Could not read texture from file '" << filename << "'." << std::endl;
+      return false;
+    }
+
+    // Subresources are repacked tightly, without headers and paddings of the container
+    size_t total_data_size = 0;
+    for( auto & subresource : texture.Subresources ) {
+      if( subresource.Offset + subresource.DataSize > file_data.size() ) {
+        std::cout << "File '" << filename << "' is truncated." << std::endl;
+        return false;
+      }
+      total_data_size += subresource.DataSize;
+    }
+    texture.Data.resize( total_data_size );
+    size_t offset = 0;
+    for( auto & subresource : texture.Subresources ) {
+      std::memcpy( &texture.Data[offset], &file_data[subresource.Offset], subresource.DataSize );
+      subresource.Offset = offset;
+      offset += subresource.DataSize;
+    }
+    return true;
+  }
+
+} // namespace VulkanCookbook
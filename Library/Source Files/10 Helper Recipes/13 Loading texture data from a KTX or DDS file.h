@@ -0,0 +1,70 @@
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and / or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The below copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// Chapter: 10 Helper Recipes
+// Recipe:  13 Loading texture data from a KTX or DDS file
+
+#ifndef LOADING_TEXTURE_DATA_FROM_A_KTX_OR_DDS_FILE
+#define LOADING_TEXTURE_DATA_FROM_A_KTX_OR_DDS_FILE
+
+#include "Tools.h"
+
+namespace VulkanCookbook {
+
+  // Data of all subresources is stored in the order in which it is kept in the file;
+  // each subresource can be copied into an image with a separate buffer-to-image copy region.
+
+  struct TextureContainerData {
+    VkFormat                    Format;
+    VkExtent3D                  Size;
+    uint32_t                    MipmapLevelsCount;
+    uint32_t                    LayersCount;        // six times the number of cubemaps for cubemap textures
+    bool                        Cubemap;
+    std::vector<unsigned char>  Data;
+
+    struct Subresource {
+      uint32_t    MipmapLevel;
+      uint32_t    Layer;
+      VkExtent3D  Size;
+      size_t      Offset;
+      size_t      DataSize;
+    };
+    std::vector<Subresource>    Subresources;
+  };
+
+  bool CheckIfFormatIsBlockCompressed( VkFormat format );
+
+  // Supports KTX 1.1 files and DDS files (with or without the DX10 header) containing
+  // BC1-BC7 compressed or R8G8B8A8 data, with mipmaps, array layers and cubemap faces.
+  // Files with more layers than a device supports (its maxImageArrayLayers limit) are rejected;
+  // by default the minimal value guaranteed by the Vulkan specification is used.
+
+  bool LoadTextureDataFromContainerFile( char const           * filename,
+                                         TextureContainerData & texture,
+                                         uint32_t               max_layers_count = 256 );
+
+} // namespace VulkanCookbook
+
+#endif // LOADING_TEXTURE_DATA_FROM_A_KTX_OR_DDS_FILE
@@ -62,12 +62,26 @@ namespace VulkanCookbook {
   }
 
   void TimerStateParameters::Update() {
+    if( FixedDeltaTime.count() > 0.0f ) {
+      // Simulated time advances by the same step every frame, so consecutive runs render the same frames
+      Time += std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(FixedDeltaTime);
+      DeltaTime = FixedDeltaTime;
+      return;
+    }
+
     auto previous_time = Time;
     Time = std::chrono::high_resolution_clock::now();
     DeltaTime = std::chrono::high_resolution_clock::now() - previous_time;
   }
 
-  TimerStateParameters::TimerStateParameters() {
+  void TimerStateParameters::SetFixedDeltaTime( float delta_time ) {
+    FixedDeltaTime = std::chrono::duration<float>( delta_time );
+    Time = std::chrono::time_point<std::chrono::high_resolution_clock>();
+    DeltaTime = FixedDeltaTime;
+  }
+
+  TimerStateParameters::TimerStateParameters() :
+    FixedDeltaTime( 0.0f ) {
     Update();
   }
 
@@ -76,7 +90,9 @@ namespace VulkanCookbook {
 
   VulkanCookbookSampleBase::VulkanCookbookSampleBase() :
     VulkanLibrary( nullptr ),
-    Ready( false ) {
+    Ready( false ),
+    Headless( false ),
+    HeadlessSize() {
   }
 
   VulkanCookbookSampleBase::~VulkanCookbookSampleBase() {
@@ -126,6 +142,16 @@ namespace VulkanCookbook {
     return Ready;
   }
 
+  void VulkanCookbookSampleBase::EnableHeadlessMode( uint32_t width, uint32_t height, float frame_delta_time ) {
+    Headless = true;
+    HeadlessSize = { width, height };
+    TimerState.SetFixedDeltaTime( frame_delta_time );
+  }
+
+  bool VulkanCookbookSampleBase::IsHeadless() {
+    return Headless;
+  }
+
   void VulkanCookbookSampleBase::OnMouseEvent() {
     // Override this in a derived class to know when a mouse event occured
   }
@@ -149,7 +175,12 @@ namespace VulkanCookbook {
 
     std::vector<char const *> instance_extensions;
     InitVkDestroyer( Instance );
-    if( !CreateVulkanInstanceWithWsiExtensionsEnabled( instance_extensions, "Vulkan Cookbook", *Instance ) ) {
+    // A headless sample doesn't present, so it doesn't need (nor require the driver to support) any WSI extensions
+    if( Headless ) {
+      if( !CreateVulkanInstance( instance_extensions, "Vulkan Cookbook", *Instance ) ) {
+        return false;
+      }
+    } else if( !CreateVulkanInstanceWithWsiExtensionsEnabled( instance_extensions, "Vulkan Cookbook", *Instance ) ) {
       return false;
     }
 
@@ -157,8 +188,10 @@ namespace VulkanCookbook {
       return false;
     }
 
+    // In a headless mode there is no window, so nothing is presented
     InitVkDestroyer( Instance, PresentationSurface );
-    if( !CreatePresentationSurface( *Instance, window_parameters, *PresentationSurface ) ) {
+    if( !Headless &&
+        !CreatePresentationSurface( *Instance, window_parameters, *PresentationSurface ) ) {
       return false;
     }
 
@@ -174,7 +207,9 @@ namespace VulkanCookbook {
         continue;
       }
 
-      if( !SelectQueueFamilyThatSupportsPresentationToGivenSurface( physical_device, *PresentationSurface, PresentQueue.FamilyIndex ) ) {
+      if( Headless ) {
+        PresentQueue.FamilyIndex = GraphicsQueue.FamilyIndex;
+      } else if( !SelectQueueFamilyThatSupportsPresentationToGivenSurface( physical_device, *PresentationSurface, PresentQueue.FamilyIndex ) ) {
         continue;
       }
 
@@ -186,9 +221,26 @@ namespace VulkanCookbook {
           (ComputeQueue.FamilyIndex != PresentQueue.FamilyIndex) ) {
         requested_queues.push_back( { PresentQueue.FamilyIndex, { 1.0f } } );
       }
+      // Block-compressed textures are enabled whenever available, so samples can prefer them over uncompressed data
+      VkPhysicalDeviceFeatures supported_features;
+      VkPhysicalDeviceProperties device_properties;
+      GetFeaturesAndPropertiesOfPhysicalDevice( physical_device, supported_features, device_properties );
+      if( nullptr != desired_device_features ) {
+        EnabledDeviceFeatures = *desired_device_features;
+      } else {
+        EnabledDeviceFeatures = {};
+      }
+      EnabledDeviceFeatures.textureCompressionBC = supported_features.textureCompressionBC;
+
       std::vector<char const *> device_extensions;
       InitVkDestroyer( LogicalDevice );
-      if( !CreateLogicalDeviceWithWsiExtensionsEnabled( physical_device, requested_queues, device_extensions, desired_device_features, *LogicalDevice ) ) {
+      bool device_created;
+      if( Headless ) {
+        device_created = CreateLogicalDevice( physical_device, requested_queues, device_extensions, &EnabledDeviceFeatures, *LogicalDevice );
+      } else {
+        device_created = CreateLogicalDeviceWithWsiExtensionsEnabled( physical_device, requested_queues, device_extensions, &EnabledDeviceFeatures, *LogicalDevice );
+      }
+      if( !device_created ) {
         continue;
       } else {
         PhysicalDevice = physical_device;
@@ -206,11 +258,30 @@ namespace VulkanCookbook {
 
     // Prepare frame resources
 
+    // Command buffers from this pool can be reset individually, so they are used for one-time operations like data uploads
     InitVkDestroyer( LogicalDevice, CommandPool );
     if( !CreateCommandPool( *LogicalDevice, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT, GraphicsQueue.FamilyIndex, *CommandPool ) ) {
       return false;
     }
 
+    // Command buffers recorded every frame are allocated from transient pools reset once per frame
+    if( !FrameCommandPools.Initialize( *LogicalDevice, GraphicsQueue.FamilyIndex, 1, FramesCount ) ) {
+      return false;
+    }
+
+    // Host-visible memory objects of samples stay mapped; their writes are flushed in batches
+    if( !MappedMemory.Initialize( PhysicalDevice, *LogicalDevice ) ) {
+      return false;
+    }
+
+    // Descriptor sets needed only for a single frame are allocated from per-frame pools, reset as a whole
+    if( !TransientDescriptorSets.Initialize( *LogicalDevice, FramesCount ) ) {
+      return false;
+    }
+
+    // Identical descriptor set layouts and pipeline layouts are shared instead of being created again
+    Layouts.Initialize( *LogicalDevice );
+
     for( uint32_t i = 0; i < FramesCount; ++i ) {
       std::vector<VkCommandBuffer> command_buffer;
       VkDestroyer(VkSemaphore) image_acquired_semaphore;
@@ -255,39 +326,81 @@ namespace VulkanCookbook {
   bool VulkanCookbookSample::CreateSwapchain( VkImageUsageFlags swapchain_image_usage,
                                               bool              use_depth,
                                               VkImageUsageFlags depth_attachment_usage ) {
-    WaitForAllSubmittedCommandsToBeFinished( *LogicalDevice );
+    // Objects which may be used by frames in flight are destroyed after these frames are finished,
+    // so the device doesn't have to be idle when the swapchain is recreated
+    DeferredDestructionQueue & retired_objects = FramePacing.GetDeferredDestructionQueue();
+
+    // Samples which render frames on their own never advance the pacer's queue,
+    // so for them old objects are destroyed synchronously, after the device is idle
+    bool destroy_synchronously = !FramePacing.IsPacingFrames();
+    if( destroy_synchronously ) {
+      WaitForAllSubmittedCommandsToBeFinished( *LogicalDevice );
+      retired_objects.DestroyRetiredObjects();
+    }
 
     Ready = false;
 
+    // Cached framebuffers reference swapchain and depth image views which are about to be destroyed
+    Framebuffers.Clear( retired_objects );
+
     Swapchain.ImageViewsRaw.clear();
-    Swapchain.ImageViews.clear();
+    retired_objects.Retire( Swapchain.ImageViews );
     Swapchain.Images.clear();
 
-    if (!Swapchain.Handle) {
-      InitVkDestroyer(LogicalDevice, Swapchain.Handle);
-    }
-    VkDestroyer(VkSwapchainKHR) old_swapchain = std::move( Swapchain.Handle );
-    InitVkDestroyer( LogicalDevice, Swapchain.Handle );
-    if( !CreateSwapchainWithR8G8B8A8FormatAndMailboxPresentMode( PhysicalDevice, *PresentationSurface, *LogicalDevice, swapchain_image_usage, Swapchain.Size, Swapchain.Format, *old_swapchain, *Swapchain.Handle, Swapchain.Images ) ) {
-      return false;
-    }
-    if( !Swapchain.Handle ) {
-      return true;
-    }
+    if( Headless ) {
+      // Swapchain images are replaced with offscreen images, rendered in turn
+      Swapchain.Format = VK_FORMAT_R8G8B8A8_UNORM;
+      Swapchain.Size = HeadlessSize;
+      retired_objects.Retire( OffscreenImages );
+      retired_objects.Retire( OffscreenImagesMemory );
 
-    for( size_t i = 0; i < Swapchain.Images.size(); ++i ) {
-      Swapchain.ImageViews.emplace_back( VkDestroyer(VkImageView)() );
-      InitVkDestroyer( LogicalDevice, Swapchain.ImageViews.back() );
-      if( !CreateImageView( *LogicalDevice, Swapchain.Images[i], VK_IMAGE_VIEW_TYPE_2D, Swapchain.Format, VK_IMAGE_ASPECT_COLOR_BIT, *Swapchain.ImageViews.back() ) ) {
+      for( uint32_t i = 0; i < FramesCount; ++i ) {
+        OffscreenImages.emplace_back( VkDestroyer(VkImage)() );
+        InitVkDestroyer( LogicalDevice, OffscreenImages.back() );
+        OffscreenImagesMemory.emplace_back( VkDestroyer(VkDeviceMemory)() );
+        InitVkDestroyer( LogicalDevice, OffscreenImagesMemory.back() );
+        Swapchain.ImageViews.emplace_back( VkDestroyer(VkImageView)() );
+        InitVkDestroyer( LogicalDevice, Swapchain.ImageViews.back() );
+
+        if( !Create2DImageAndView( PhysicalDevice, *LogicalDevice, Swapchain.Format, Swapchain.Size, 1, 1, VK_SAMPLE_COUNT_1_BIT,
+          swapchain_image_usage | VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, VK_IMAGE_ASPECT_COLOR_BIT, *OffscreenImages.back(), *OffscreenImagesMemory.back(),
+          *Swapchain.ImageViews.back() ) ) {
+          return false;
+        }
+        Swapchain.Images.push_back( *OffscreenImages.back() );
+        Swapchain.ImageViewsRaw.push_back( *Swapchain.ImageViews.back() );
+      }
+    } else {
+      if (!Swapchain.Handle) {
+        InitVkDestroyer(LogicalDevice, Swapchain.Handle);
+      }
+      VkDestroyer(VkSwapchainKHR) old_swapchain = std::move( Swapchain.Handle );
+      InitVkDestroyer( LogicalDevice, Swapchain.Handle );
+      if( !CreateSwapchainWithR8G8B8A8FormatAndMailboxPresentMode( PhysicalDevice, *PresentationSurface, *LogicalDevice, swapchain_image_usage, Swapchain.Size, Swapchain.Format, *old_swapchain, *Swapchain.Handle, Swapchain.Images ) ) {
         return false;
       }
-      Swapchain.ImageViewsRaw.push_back( *Swapchain.ImageViews.back() );
+      retired_objects.Retire( std::move( old_swapchain ) );
+      if( !Swapchain.Handle ) {
+        return true;
+      }
+
+      for( size_t i = 0; i < Swapchain.Images.size(); ++i ) {
+        Swapchain.ImageViews.emplace_back( VkDestroyer(VkImageView)() );
+        InitVkDestroyer( LogicalDevice, Swapchain.ImageViews.back() );
+        if( !CreateImageView( *LogicalDevice, Swapchain.Images[i], VK_IMAGE_VIEW_TYPE_2D, Swapchain.Format, VK_IMAGE_ASPECT_COLOR_BIT, *Swapchain.ImageViews.back() ) ) {
+          return false;
+        }
+        Swapchain.ImageViewsRaw.push_back( *Swapchain.ImageViews.back() );
+      }
     }
 
     // When we want to use depth buffering, we need to use a depth attachment
     // It must have the same size as the swapchain, so we need to recreate it along with the swapchain
-    DepthImages.clear();
-    DepthImagesMemory.clear();
+    for( auto & frame_resources : FramesResources ) {
+      retired_objects.Retire( std::move( frame_resources.DepthAttachment ) );
+    }
+    retired_objects.Retire( DepthImages );
+    retired_objects.Retire( DepthImagesMemory );
 
     if( use_depth ) {
       for( uint32_t i = 0; i < FramesCount; ++i ) {
@@ -305,6 +418,10 @@ namespace VulkanCookbook {
       }
     }
 
+    if( destroy_synchronously ) {
+      retired_objects.DestroyRetiredObjects();
+    }
+
     Ready = true;
     return true;
   }
@@ -313,6 +430,60 @@ namespace VulkanCookbook {
     if( LogicalDevice ) {
       WaitForAllSubmittedCommandsToBeFinished( *LogicalDevice );
     }
+    FramePacing.GetDeferredDestructionQueue().DestroyRetiredObjects();
+    Framebuffers.Clear();
+    Uploader.Destroy();
+    MappedMemory.Destroy();
+    TransientDescriptorSets.Destroy();
+    Layouts.Destroy();
+    RecordingThreads.Destroy();
+    FrameCommandPools.Destroy();
+
+    // In a headless mode standard output is reserved for frame time results
+    std::ostream & statistics = Headless ? std::cerr : std::cout;
+
+    FramePacingStatistics pacing_statistics = FramePacing.GetStatistics();
+    if( 0 < pacing_statistics.FrameCount ) {
+      statistics << "Frames: " << pacing_statistics.FrameCount
+                << ", average frame time: " << 1000.0f * pacing_statistics.AverageFrameTime << " ms"
+                << ", average fence wait time: " << 1000.0f * pacing_statistics.AverageFenceWaitTime << " ms"
+                << ", CPU/GPU overlap: " << 100.0f * pacing_statistics.CpuGpuOverlap << "%" << std::endl;
+    }
+
+    DeferredDestructionStatistics destruction_statistics = FramePacing.GetDeferredDestructionQueue().GetStatistics();
+    if( 0 < destruction_statistics.RetiredObjects ) {
+      statistics << "Objects with deferred destruction: " << destruction_statistics.RetiredObjects << std::endl;
+    }
+
+    StagingUploaderStatistics upload_statistics = Uploader.GetStatistics();
+    if( 0 < upload_statistics.UploadCount ) {
+      statistics << "Uploads: " << upload_statistics.UploadCount
+                << ", submissions: " << upload_statistics.SubmissionCount
+                << ", uploaded data: " << upload_statistics.UploadedBytes / 1024 << " KB"
+                << ", staging ring stalls: " << upload_statistics.StallCount << std::endl;
+    }
+
+    MappedMemoryStatistics mapped_memory_statistics = MappedMemory.GetStatistics();
+    if( 0 < mapped_memory_statistics.MapCount ) {
+      statistics << "Mapped memory objects: " << mapped_memory_statistics.MapCount
+                << ", flushes: " << mapped_memory_statistics.FlushCallCount
+                << ", flushed data: " << mapped_memory_statistics.FlushedBytes << " B" << std::endl;
+    }
+
+    DescriptorAllocatorStatistics descriptor_statistics = TransientDescriptorSets.GetStatistics();
+    if( 0 < descriptor_statistics.AllocatedSets ) {
+      statistics << "Transient descriptor sets: " << descriptor_statistics.AllocatedSets
+                << ", descriptor pools: " << descriptor_statistics.CreatedPools
+                << ", pool resets: " << descriptor_statistics.PoolResets << std::endl;
+    }
+
+    LayoutCacheStatistics layout_statistics = Layouts.GetStatistics();
+    if( 0 < layout_statistics.DescriptorSetLayoutMisses + layout_statistics.PipelineLayoutMisses ) {
+      statistics << "Descriptor set layouts: " << layout_statistics.DescriptorSetLayoutCount
+                << " (" << layout_statistics.DescriptorSetLayoutHits << " reused)"
+                << ", pipeline layouts: " << layout_statistics.PipelineLayoutCount
+                << " (" << layout_statistics.PipelineLayoutHits << " reused)" << std::endl;
+    }
   }
 
 } // namespace VulkanCookbook
@@ -73,6 +73,7 @@ namespace VulkanCookbook {
     float   GetDeltaTime() const;
 
     void    Update();
+    void    SetFixedDeltaTime( float delta_time );
 
       TimerStateParameters();
      ~TimerStateParameters();
@@ -80,6 +81,7 @@ namespace VulkanCookbook {
   private:
     std::chrono::time_point<std::chrono::high_resolution_clock> Time;
     std::chrono::duration<float>                                DeltaTime;
+    std::chrono::duration<float>                                FixedDeltaTime;
   };
 
   // Simple containers for resources
@@ -115,12 +117,16 @@ namespace VulkanCookbook {
     virtual void  MouseReset() final;
     virtual void  UpdateTime() final;
     virtual bool  IsReady() final;
+    virtual void  EnableHeadlessMode( uint32_t width, uint32_t height, float frame_delta_time ) final;
+    virtual bool  IsHeadless() final;
 
   protected:
     virtual void  OnMouseEvent();
 
     LIBRARY_TYPE          VulkanLibrary;
     bool                  Ready;
+    bool                  Headless;
+    VkExtent2D            HeadlessSize;
     MouseStateParameters  MouseState;
     TimerStateParameters  TimerState;
   };
@@ -131,6 +137,7 @@ namespace VulkanCookbook {
   public:
     VkDestroyer(VkInstance)                   Instance;
     VkPhysicalDevice                          PhysicalDevice;
+    VkPhysicalDeviceFeatures                  EnabledDeviceFeatures;
     VkDestroyer(VkDevice)                     LogicalDevice;
     VkDestroyer(VkSurfaceKHR)                 PresentationSurface;
     QueueParameters                           GraphicsQueue;
@@ -138,9 +145,21 @@ namespace VulkanCookbook {
     QueueParameters                           PresentQueue;
     SwapchainParameters                       Swapchain;
     VkDestroyer(VkCommandPool)                CommandPool;
+    CommandPoolRing                           FrameCommandPools;
     std::vector<VkDestroyer(VkImage)>         DepthImages;
     std::vector<VkDestroyer(VkDeviceMemory)>  DepthImagesMemory;
+    std::vector<VkDestroyer(VkImage)>         OffscreenImages;
+    std::vector<VkDestroyer(VkDeviceMemory)>  OffscreenImagesMemory;
     std::vector<FrameResources>               FramesResources;
+    FramebufferCache                          Framebuffers;
+    FramePacer                                FramePacing;
+    // Worker threads are created only by samples which spread their work across threads
+    ThreadPool                                RecordingThreads;
+    // Staging ring is initialized only by samples which upload data, with a size they need
+    StagingUploader                           Uploader;
+    MappedMemoryManager                       MappedMemory;
+    DescriptorAllocator                       TransientDescriptorSets;
+    LayoutCache                               Layouts;
     static uint32_t const                     FramesCount = 3;
     static VkFormat const                     DepthFormat = VK_FORMAT_D16_UNORM;
 
@@ -157,11 +176,24 @@ namespace VulkanCookbook {
 
   // Application starting point implementation
 
+  // Samples started with a "--headless" argument render a fixed number of frames offscreen and report frame times;
+  // windowed samples draw frames according to a policy selected with a "--policy" argument
+
 #define VULKAN_COOKBOOK_SAMPLE_FRAMEWORK( title, x, y, width, height, sample_type )   \
                                                                                       \
-  int main() {                                                                        \
+  int main( int argc, char ** argv ) {                                                \
     sample_type sample;                                                               \
-    WindowFramework window( "Vulkan Cookbook #" title, x, y, width, height, sample ); \
+    BenchmarkParameters benchmark_parameters;                                         \
+    LoopParameters loop_parameters;                                                   \
+    if( ParseCommandLineArguments( argc, argv, benchmark_parameters,                  \
+                                   loop_parameters ) ) {                              \
+      HeadlessFramework headless( "Vulkan Cookbook #" title, width, height,           \
+                                  benchmark_parameters, sample );                     \
+                                                                                      \
+      return headless.Render() ? 0 : 1;                                               \
+    }                                                                                 \
+    WindowFramework window( "Vulkan Cookbook #" title, x, y, width, height, sample,   \
+                            loop_parameters );                                        \
                                                                                       \
     window.Render();                                                                  \
                                                                                       \
@@ -29,8 +29,19 @@
 //
 // OS
 
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
 #include "CookbookSampleFramework.h"
 
+#if defined VK_USE_PLATFORM_XLIB_KHR || defined VK_USE_PLATFORM_XCB_KHR
+#include <poll.h>
+#endif
+#if defined VK_USE_PLATFORM_XLIB_KHR || defined VK_USE_PLATFORM_XCB_KHR
+#include <X11/keysym.h>
+#endif
+
 namespace VulkanCookbook {
 
 #ifdef VK_USE_PLATFORM_WIN32_KHR
@@ -88,10 +99,22 @@ namespace VulkanCookbook {
                                     int                        y,
                                     int                        width,
                                     int                        height,
-                                    VulkanCookbookSampleBase & sample ) :
+                                    VulkanCookbookSampleBase & sample,
+                                    LoopParameters const     & loop_parameters ) :
     WindowParams(),
     Sample( sample ),
-    Created( false ) {
+    Created( false ),
+    Loop( loop_parameters ),
+    RedrawRequested( true ),
+    InputPending( false ),
+    InputTime(),
+    NextFrameTime(),
+    StartTime(),
+    StartCpuTime( 0 ),
+    FramesCount( 0 ),
+    InputFramesCount( 0 ),
+    LatencySum( 0.0 ),
+    LatencyMax( 0.0 ) {
     WindowParams.HInstance = GetModuleHandle( nullptr );
 
     WNDCLASSEX window_class = {
@@ -142,23 +165,28 @@ namespace VulkanCookbook {
 
       MSG message;
       bool loop = true;
+      StartLoop();
 
       while( loop ) {
         if( PeekMessage( &message, NULL, 0, 0, PM_REMOVE ) ) {
           switch( message.message ) {
           case USER_MESSAGE_MOUSE_CLICK:
             Sample.MouseClick( static_cast<size_t>(message.wParam), message.lParam > 0 );
+            RequestRedraw( true );
             break;
           case USER_MESSAGE_MOUSE_MOVE:
             Sample.MouseMove( static_cast<int>(message.wParam), static_cast<int>(message.lParam) );
+            RequestRedraw( true );
             break;
           case USER_MESSAGE_MOUSE_WHEEL:
             Sample.MouseWheel( static_cast<short>(message.wParam) * 0.002f );
+            RequestRedraw( true );
             break;
           case USER_MESSAGE_RESIZE:
             if( !Sample.Resize() ) {
               loop = false;
             }
+            RequestRedraw( false );
             break;
           case USER_MESSAGE_QUIT:
             loop = false;
@@ -166,19 +194,667 @@ namespace VulkanCookbook {
           }
           TranslateMessage( &message );
           DispatchMessage( &message );
+        } else if( Sample.IsReady() &&
+                   ShouldDraw() ) {
+          DrawFrame();
         } else {
-          if( Sample.IsReady() ) {
-            Sample.UpdateTime();
-            Sample.Draw();
-            Sample.MouseReset();
+          // Sleep until a new message arrives or until it's time for the next frame
+          int timeout = GetWaitTimeout();
+          MsgWaitForMultipleObjects( 0, nullptr, FALSE, (timeout < 0) ? INFINITE : static_cast<DWORD>(timeout), QS_ALLINPUT );
+        }
+      }
+
+      PrintStatistics();
+    }
+
+    Sample.Deinitialize();
+  }
+
+#elif defined VK_USE_PLATFORM_XLIB_KHR
+
+  WindowFramework::WindowFramework( const char               * window_title,
+                                    int                        x,
+                                    int                        y,
+                                    int                        width,
+                                    int                        height,
+                                    VulkanCookbookSampleBase & sample,
+                                    LoopParameters const     & loop_parameters ) :
+    WindowParams(),
+    Sample( sample ),
+    Created( false ),
+    Loop( loop_parameters ),
+    RedrawRequested( true ),
+    InputPending( false ),
+    InputTime(),
+    NextFrameTime(),
+    StartTime(),
+    StartCpuTime( 0 ),
+    FramesCount( 0 ),
+    InputFramesCount( 0 ),
+    LatencySum( 0.0 ),
+    LatencyMax( 0.0 ),
+    DeleteWindowAtom( None ),
+    Width( width ),
+    Height( height ) {
+    WindowParams.Dpy = XOpenDisplay( nullptr );
+    if( !WindowParams.Dpy ) {
+      std::cout << "Could not connect with an X server." << std::endl;
+      return;
+    }
+
+    int screen = DefaultScreen( WindowParams.Dpy );
+    WindowParams.Window = XCreateSimpleWindow( WindowParams.Dpy, RootWindow( WindowParams.Dpy, screen ), x, y, width, height, 0, BlackPixel( WindowParams.Dpy, screen ), BlackPixel( WindowParams.Dpy, screen ) );
+    XSelectInput( WindowParams.Dpy, WindowParams.Window, ExposureMask | StructureNotifyMask | KeyPressMask | ButtonPressMask | ButtonReleaseMask | PointerMotionMask );
+    XStoreName( WindowParams.Dpy, WindowParams.Window, window_title );
+
+    // Closing a window with a title bar's button is reported as a client message instead of destroying the window
+    DeleteWindowAtom = XInternAtom( WindowParams.Dpy, "WM_DELETE_WINDOW", False );
+    XSetWMProtocols( WindowParams.Dpy, WindowParams.Window, &DeleteWindowAtom, 1 );
+
+    Created = true;
+  }
+
+  WindowFramework::~WindowFramework() {
+    if( WindowParams.Dpy ) {
+      if( WindowParams.Window ) {
+        XDestroyWindow( WindowParams.Dpy, WindowParams.Window );
+      }
+      XCloseDisplay( WindowParams.Dpy );
+    }
+  }
+
+  void WindowFramework::Render() {
+    if( Created &&
+        Sample.Initialize( WindowParams ) ) {
+
+      XMapWindow( WindowParams.Dpy, WindowParams.Window );
+      XFlush( WindowParams.Dpy );
+
+      XEvent event;
+      bool loop = true;
+      StartLoop();
+
+      while( loop ) {
+        if( 0 == XPending( WindowParams.Dpy ) ) {
+          if( Sample.IsReady() &&
+              ShouldDraw() ) {
+            DrawFrame();
+            continue;
+          }
+          int timeout = GetWaitTimeout();
+          if( timeout >= 0 ) {
+            // Sleep until events arrive or until it's time for the next frame
+            pollfd connection = { ConnectionNumber( WindowParams.Dpy ), POLLIN, 0 };
+            poll( &connection, 1, timeout );
+            continue;
+          }
+          // Without a timeout, XNextEvent() blocks until events arrive
+        }
+
+        XNextEvent( WindowParams.Dpy, &event );
+        switch( event.type ) {
+        case ButtonPress:
+        case ButtonRelease:
+          if( Button1 == event.xbutton.button ) {
+            Sample.MouseClick( 0, ButtonPress == event.type );
+          } else if( Button3 == event.xbutton.button ) {
+            Sample.MouseClick( 1, ButtonPress == event.type );
+          } else if( (ButtonPress == event.type) &&
+                     (Button4 == event.xbutton.button) ) {
+            Sample.MouseWheel( 0.24f );
+          } else if( (ButtonPress == event.type) &&
+                     (Button5 == event.xbutton.button) ) {
+            Sample.MouseWheel( -0.24f );
+          }
+          RequestRedraw( true );
+          break;
+        case MotionNotify:
+          Sample.MouseMove( event.xmotion.x, event.xmotion.y );
+          RequestRedraw( true );
+          break;
+        case ConfigureNotify:
+          if( (Width != event.xconfigure.width) ||
+              (Height != event.xconfigure.height) ) {
+            Width = event.xconfigure.width;
+            Height = event.xconfigure.height;
+            if( !Sample.Resize() ) {
+              loop = false;
+            }
+            RequestRedraw( false );
+          }
+          break;
+        case Expose:
+          RequestRedraw( false );
+          break;
+        case KeyPress:
+          if( XK_Escape == XLookupKeysym( &event.xkey, 0 ) ) {
+            loop = false;
+          }
+          break;
+        case ClientMessage:
+          if( static_cast<Atom>(event.xclient.data.l[0]) == DeleteWindowAtom ) {
+            loop = false;
+          }
+          break;
+        }
+      }
+
+      PrintStatistics();
+    }
+
+    Sample.Deinitialize();
+  }
+
+#elif defined VK_USE_PLATFORM_XCB_KHR
+
+  namespace {
+
+    xcb_atom_t GetAtom( xcb_connection_t * connection,
+                        char const       * name,
+                        bool               only_if_exists ) {
+      xcb_intern_atom_cookie_t cookie = xcb_intern_atom( connection, only_if_exists ? 1 : 0, static_cast<uint16_t>(strlen( name )), name );
+      xcb_intern_atom_reply_t * reply = xcb_intern_atom_reply( connection, cookie, nullptr );
+      if( !reply ) {
+        return XCB_ATOM_NONE;
+      }
+      xcb_atom_t atom = reply->atom;
+      free( reply );
+      return atom;
+    }
+
+    // Key codes depend on a keyboard driver and layout, so a key code is found through the server's keyboard mapping
+    // (like XLookupKeysym() does, only unshifted key symbols are compared)
+    xcb_keycode_t GetKeyCode( xcb_connection_t * connection,
+                              xcb_keysym_t       key_symbol ) {
+      xcb_setup_t const * setup = xcb_get_setup( connection );
+      uint8_t keycodes_count = static_cast<uint8_t>(setup->max_keycode - setup->min_keycode + 1);
+      xcb_get_keyboard_mapping_cookie_t cookie = xcb_get_keyboard_mapping( connection, setup->min_keycode, keycodes_count );
+      xcb_get_keyboard_mapping_reply_t * reply = xcb_get_keyboard_mapping_reply( connection, cookie, nullptr );
+      if( !reply ) {
+        return 0;
+      }
+      xcb_keycode_t key_code = 0;
+      xcb_keysym_t * key_symbols = xcb_get_keyboard_mapping_keysyms( reply );
+      if( 0 < reply->keysyms_per_keycode ) {
+        for( int i = 0; i < xcb_get_keyboard_mapping_keysyms_length( reply ) / reply->keysyms_per_keycode; ++i ) {
+          if( key_symbol == key_symbols[i * reply->keysyms_per_keycode] ) {
+            key_code = static_cast<xcb_keycode_t>(setup->min_keycode + i);
+            break;
+          }
+        }
+      }
+      free( reply );
+      return key_code;
+    }
+
+  } // namespace
+
+  WindowFramework::WindowFramework( const char               * window_title,
+                                    int                        x,
+                                    int                        y,
+                                    int                        width,
+                                    int                        height,
+                                    VulkanCookbookSampleBase & sample,
+                                    LoopParameters const     & loop_parameters ) :
+    WindowParams(),
+    Sample( sample ),
+    Created( false ),
+    Loop( loop_parameters ),
+    RedrawRequested( true ),
+    InputPending( false ),
+    InputTime(),
+    NextFrameTime(),
+    StartTime(),
+    StartCpuTime( 0 ),
+    FramesCount( 0 ),
+    InputFramesCount( 0 ),
+    LatencySum( 0.0 ),
+    LatencyMax( 0.0 ),
+    DeleteWindowAtom( XCB_ATOM_NONE ),
+    EscapeKeyCode( 0 ),
+    Width( width ),
+    Height( height ) {
+    int screen_index = 0;
+    WindowParams.Connection = xcb_connect( nullptr, &screen_index );
+    if( xcb_connection_has_error( WindowParams.Connection ) ) {
+      std::cout << "Could not connect with an X server." << std::endl;
+      return;
+    }
+
+    xcb_screen_iterator_t screen_iterator = xcb_setup_roots_iterator( xcb_get_setup( WindowParams.Connection ) );
+    for( ; screen_index > 0; --screen_index ) {
+      xcb_screen_next( &screen_iterator );
+    }
+    xcb_screen_t * screen = screen_iterator.data;
+
+    uint32_t event_mask = XCB_EVENT_MASK_EXPOSURE | XCB_EVENT_MASK_STRUCTURE_NOTIFY | XCB_EVENT_MASK_KEY_PRESS |
+                          XCB_EVENT_MASK_BUTTON_PRESS | XCB_EVENT_MASK_BUTTON_RELEASE | XCB_EVENT_MASK_POINTER_MOTION;
+    WindowParams.Window = xcb_generate_id( WindowParams.Connection );
+    xcb_create_window( WindowParams.Connection, XCB_COPY_FROM_PARENT, WindowParams.Window, screen->root, static_cast<int16_t>(x), static_cast<int16_t>(y),
+      static_cast<uint16_t>(width), static_cast<uint16_t>(height), 0, XCB_WINDOW_CLASS_INPUT_OUTPUT, screen->root_visual, XCB_CW_EVENT_MASK, &event_mask );
+    xcb_change_property( WindowParams.Connection, XCB_PROP_MODE_REPLACE, WindowParams.Window, XCB_ATOM_WM_NAME, XCB_ATOM_STRING, 8, static_cast<uint32_t>(strlen( window_title )), window_title );
+
+    // Closing a window with a title bar's button is reported as a client message instead of destroying the window
+    xcb_atom_t protocols_atom = GetAtom( WindowParams.Connection, "WM_PROTOCOLS", true );
+    DeleteWindowAtom = GetAtom( WindowParams.Connection, "WM_DELETE_WINDOW", false );
+    if( (XCB_ATOM_NONE != protocols_atom) &&
+        (XCB_ATOM_NONE != DeleteWindowAtom) ) {
+      xcb_change_property( WindowParams.Connection, XCB_PROP_MODE_REPLACE, WindowParams.Window, protocols_atom, XCB_ATOM_ATOM, 32, 1, &DeleteWindowAtom );
+    }
+
+    EscapeKeyCode = GetKeyCode( WindowParams.Connection, XK_Escape );
+
+    Created = true;
+  }
+
+  WindowFramework::~WindowFramework() {
+    if( WindowParams.Connection ) {
+      if( WindowParams.Window ) {
+        xcb_destroy_window( WindowParams.Connection, WindowParams.Window );
+      }
+      xcb_disconnect( WindowParams.Connection );
+    }
+  }
+
+  void WindowFramework::Render() {
+    if( Created &&
+        Sample.Initialize( WindowParams ) ) {
+
+      xcb_map_window( WindowParams.Connection, WindowParams.Window );
+      xcb_flush( WindowParams.Connection );
+
+      bool loop = true;
+      StartLoop();
+
+      while( loop ) {
+        xcb_generic_event_t * event = xcb_poll_for_event( WindowParams.Connection );
+        if( !event ) {
+          if( xcb_connection_has_error( WindowParams.Connection ) ) {
+            break;
+          }
+          if( Sample.IsReady() &&
+              ShouldDraw() ) {
+            DrawFrame();
+            continue;
+          }
+          int timeout = GetWaitTimeout();
+          if( timeout >= 0 ) {
+            // Sleep until events arrive or until it's time for the next frame
+            pollfd connection = { xcb_get_file_descriptor( WindowParams.Connection ), POLLIN, 0 };
+            poll( &connection, 1, timeout );
+            continue;
+          }
+          // Sleep until events arrive
+          event = xcb_wait_for_event( WindowParams.Connection );
+          if( !event ) {
+            break;
+          }
+        }
+
+        switch( event->response_type & 0x7f ) {
+        case XCB_BUTTON_PRESS:
+        case XCB_BUTTON_RELEASE: {
+          xcb_button_press_event_t * button_event = reinterpret_cast<xcb_button_press_event_t*>(event);
+          bool pressed = XCB_BUTTON_PRESS == (event->response_type & 0x7f);
+          if( XCB_BUTTON_INDEX_1 == button_event->detail ) {
+            Sample.MouseClick( 0, pressed );
+          } else if( XCB_BUTTON_INDEX_3 == button_event->detail ) {
+            Sample.MouseClick( 1, pressed );
+          } else if( pressed &&
+                     (XCB_BUTTON_INDEX_4 == button_event->detail) ) {
+            Sample.MouseWheel( 0.24f );
+          } else if( pressed &&
+                     (XCB_BUTTON_INDEX_5 == button_event->detail) ) {
+            Sample.MouseWheel( -0.24f );
           }
+          RequestRedraw( true );
+          break;
         }
+        case XCB_MOTION_NOTIFY: {
+          xcb_motion_notify_event_t * motion_event = reinterpret_cast<xcb_motion_notify_event_t*>(event);
+          Sample.MouseMove( motion_event->event_x, motion_event->event_y );
+          RequestRedraw( true );
+          break;
+        }
+        case XCB_CONFIGURE_NOTIFY: {
+          xcb_configure_notify_event_t * configure_event = reinterpret_cast<xcb_configure_notify_event_t*>(event);
+          if( (Width != configure_event->width) ||
+              (Height != configure_event->height) ) {
+            Width = configure_event->width;
+            Height = configure_event->height;
+            if( !Sample.Resize() ) {
+              loop = false;
+            }
+            RequestRedraw( false );
+          }
+          break;
+        }
+        case XCB_EXPOSE:
+          RequestRedraw( false );
+          break;
+        case XCB_KEY_PRESS:
+          if( (0 != EscapeKeyCode) &&
+              (EscapeKeyCode == reinterpret_cast<xcb_key_press_event_t*>(event)->detail) ) {
+            loop = false;
+          }
+          break;
+        case XCB_CLIENT_MESSAGE:
+          if( reinterpret_cast<xcb_client_message_event_t*>(event)->data.data32[0] == DeleteWindowAtom ) {
+            loop = false;
+          }
+          break;
+        }
+        free( event );
       }
+
+      PrintStatistics();
     }
 
     Sample.Deinitialize();
   }
 
+#else
+
+  WindowFramework::WindowFramework( const char               * window_title,
+                                    int                        x,
+                                    int                        y,
+                                    int                        width,
+                                    int                        height,
+                                    VulkanCookbookSampleBase & sample,
+                                    LoopParameters const     & loop_parameters ) :
+    WindowParams(),
+    Sample( sample ),
+    Created( false ),
+    Loop( loop_parameters ),
+    RedrawRequested( true ),
+    InputPending( false ),
+    InputTime(),
+    NextFrameTime(),
+    StartTime(),
+    StartCpuTime( 0 ),
+    FramesCount( 0 ),
+    InputFramesCount( 0 ),
+    LatencySum( 0.0 ),
+    LatencyMax( 0.0 ) {
+  }
+
+  WindowFramework::~WindowFramework() {
+  }
+
+  void WindowFramework::Render() {
+    std::cout << "Could not create a window on this platform. Run the sample with the --headless argument." << std::endl;
+    Sample.Deinitialize();
+  }
+
 #endif
 
+  void WindowFramework::StartLoop() {
+    RedrawRequested = true;
+    InputPending = false;
+    StartTime = std::chrono::steady_clock::now();
+    NextFrameTime = StartTime;
+    StartCpuTime = std::clock();
+    FramesCount = 0;
+    InputFramesCount = 0;
+    LatencySum = 0.0;
+    LatencyMax = 0.0;
+  }
+
+  void WindowFramework::RequestRedraw( bool input ) {
+    RedrawRequested = true;
+    // Latency is measured from the oldest input event which wasn't presented yet
+    if( input &&
+        !InputPending ) {
+      InputPending = true;
+      InputTime = std::chrono::steady_clock::now();
+    }
+  }
+
+  bool WindowFramework::ShouldDraw() const {
+    switch( Loop.Policy ) {
+    case RENDERING_POLICY_ON_INPUT:
+      return RedrawRequested;
+    case RENDERING_POLICY_CAPPED:
+      return std::chrono::steady_clock::now() >= NextFrameTime;
+    default:
+      return true;
+    }
+  }
+
+  int WindowFramework::GetWaitTimeout() const {
+    // Negative timeout means waiting until a new event arrives
+    if( !Sample.IsReady() ) {
+      return -1;
+    }
+    switch( Loop.Policy ) {
+    case RENDERING_POLICY_ON_INPUT:
+      return RedrawRequested ? 0 : -1;
+    case RENDERING_POLICY_CAPPED: {
+      auto time_left = std::chrono::duration<double, std::milli>( NextFrameTime - std::chrono::steady_clock::now() ).count();
+      return std::max( 0, static_cast<int>(std::ceil( time_left )) );
+    }
+    default:
+      return 0;
+    }
+  }
+
+  void WindowFramework::DrawFrame() {
+    Sample.UpdateTime();
+    Sample.Draw();
+    Sample.MouseReset();
+
+    // Draw() returns right after the frame is submitted, so latency is measured up to the submission - it doesn't include
+    // GPU execution nor the time spent in a presentation engine
+    auto now = std::chrono::steady_clock::now();
+    ++FramesCount;
+    if( InputPending ) {
+      double latency = std::chrono::duration<double, std::milli>( now - InputTime ).count();
+      LatencySum += latency;
+      LatencyMax = std::max( LatencyMax, latency );
+      ++InputFramesCount;
+      InputPending = false;
+    }
+    RedrawRequested = false;
+
+    if( RENDERING_POLICY_CAPPED == Loop.Policy ) {
+      auto frame_period = std::chrono::duration_cast<std::chrono::steady_clock::duration>( std::chrono::duration<double>( 1.0 / Loop.MaxFramesPerSecond ) );
+      // Deadlines are kept on a fixed cadence, unless the loop is already late by a whole frame
+      NextFrameTime += frame_period;
+      if( NextFrameTime < now ) {
+        NextFrameTime = now + frame_period;
+      }
+    }
+  }
+
+  void WindowFramework::PrintStatistics() const {
+    double wall_time = std::chrono::duration<double>( std::chrono::steady_clock::now() - StartTime ).count();
+    double cpu_time = static_cast<double>(std::clock() - StartCpuTime) / CLOCKS_PER_SEC;
+    char const * policy_names[] = { "continuous", "on-input", "capped" };
+
+    std::cout << "Rendering policy: " << policy_names[Loop.Policy];
+    if( RENDERING_POLICY_CAPPED == Loop.Policy ) {
+      std::cout << " (" << Loop.MaxFramesPerSecond << " frames per second)";
+    }
+    std::cout << std::endl
+              << "Frames drawn: " << FramesCount << " in " << wall_time << " s" << std::endl
+              << "CPU usage: " << ((wall_time > 0.0) ? 100.0 * cpu_time / wall_time : 0.0) << "% of a single core" << std::endl;
+    if( InputFramesCount > 0 ) {
+      std::cout << "Input-to-submit latency: " << LatencySum / InputFramesCount << " ms average, " << LatencyMax << " ms maximum" << std::endl;
+    }
+  }
+
+  LoopParameters::LoopParameters() :
+    Policy( RENDERING_POLICY_CONTINUOUS ),
+    MaxFramesPerSecond( 60.0f ) {
+  }
+
+  BenchmarkParameters::BenchmarkParameters() :
+    FramesCount( 500 ),
+    WarmupFramesCount( 20 ),
+    FrameDeltaTime( 1.0f / 60.0f ),
+    OutputFilename() {
+  }
+
+  bool ParseCommandLineArguments( int                   argc,
+                                  char               ** argv,
+                                  BenchmarkParameters & benchmark_parameters,
+                                  LoopParameters      & loop_parameters ) {
+    bool headless = false;
+    for( int i = 1; i < argc; ++i ) {
+      if( std::string( "--headless" ) == argv[i] ) {
+        headless = true;
+      }
+    }
+    // In a headless mode the standard output is reserved for JSON results
+    std::ostream & diagnostics = headless ? std::cerr : std::cout;
+
+    for( int i = 1; i < argc; ++i ) {
+      std::string argument = argv[i];
+      bool has_value = (i + 1 < argc);
+      if( "--headless" == argument ) {
+        continue;
+      } else if( ("--frames" == argument) && has_value ) {
+        benchmark_parameters.FramesCount = std::max( 1u, static_cast<uint32_t>(std::strtoul( argv[++i], nullptr, 10 )) );
+      } else if( ("--warmup" == argument) && has_value ) {
+        benchmark_parameters.WarmupFramesCount = static_cast<uint32_t>(std::strtoul( argv[++i], nullptr, 10 ));
+      } else if( ("--delta-time" == argument) && has_value ) {
+        benchmark_parameters.FrameDeltaTime = std::max( 0.0001f, std::strtof( argv[++i], nullptr ) );
+      } else if( ("--output" == argument) && has_value ) {
+        benchmark_parameters.OutputFilename = argv[++i];
+      } else if( ("--policy" == argument) && has_value ) {
+        std::string policy = argv[++i];
+        if( "continuous" == policy ) {
+          loop_parameters.Policy = RENDERING_POLICY_CONTINUOUS;
+        } else if( "on-input" == policy ) {
+          loop_parameters.Policy = RENDERING_POLICY_ON_INPUT;
+        } else if( "capped" == policy ) {
+          loop_parameters.Policy = RENDERING_POLICY_CAPPED;
+        } else {
+          diagnostics << "Unknown rendering policy: " << policy << std::endl;
+        }
+      } else if( ("--fps" == argument) && has_value ) {
+        loop_parameters.Policy = RENDERING_POLICY_CAPPED;
+        loop_parameters.MaxFramesPerSecond = std::max( 1.0f, std::strtof( argv[++i], nullptr ) );
+      } else {
+        diagnostics << "Unknown command line argument: " << argument << std::endl;
+      }
+    }
+    return headless;
+  }
+
+  HeadlessFramework::HeadlessFramework( const char                * title,
+                                        int                         width,
+                                        int                         height,
+                                        BenchmarkParameters const & parameters,
+                                        VulkanCookbookSampleBase  & sample ) :
+    Title( title ),
+    Width( static_cast<uint32_t>(width) ),
+    Height( static_cast<uint32_t>(height) ),
+    Parameters( parameters ),
+    Sample( sample ) {
+  }
+
+  bool HeadlessFramework::Render() {
+    bool result = false;
+    // Messages printed by the sample and the library go to the standard error, so the standard output contains
+    // nothing but valid JSON results
+    std::streambuf * standard_output_buffer = std::cout.rdbuf( std::cerr.rdbuf() );
+    std::ostream standard_output( standard_output_buffer );
+    Sample.EnableHeadlessMode( Width, Height, Parameters.FrameDeltaTime );
+
+    if( !Sample.Initialize( WindowParameters() ) ) {
+      std::cout << "Could not initialize the sample in a headless mode." << std::endl;
+    } else if( !Sample.IsReady() ) {
+      std::cout << "Sample doesn't render any frames." << std::endl;
+    } else {
+      std::vector<double> frame_times;
+      frame_times.reserve( Parameters.FramesCount );
+      result = true;
+
+      // Frame time is measured from the beginning of one frame to the beginning of the next one, so it includes
+      // waiting for the GPU when it can't keep up with the CPU
+      uint32_t total_frames_count = Parameters.WarmupFramesCount + Parameters.FramesCount;
+      auto frame_start = std::chrono::steady_clock::now();
+      for( uint32_t frame = 0; frame < total_frames_count; ++frame ) {
+        Sample.UpdateTime();
+        if( !Sample.Draw() ) {
+          std::cout << "Could not draw frame number " << frame << "." << std::endl;
+          result = false;
+          break;
+        }
+        Sample.MouseReset();
+
+        auto frame_end = std::chrono::steady_clock::now();
+        if( frame >= Parameters.WarmupFramesCount ) {
+          frame_times.push_back( std::chrono::duration<double, std::milli>( frame_end - frame_start ).count() );
+        }
+        frame_start = frame_end;
+      }
+
+      if( result ) {
+        result = SaveFrameTimes( frame_times, standard_output );
+      }
+    }
+
+    Sample.Deinitialize();
+    std::cout.rdbuf( standard_output_buffer );
+    return result;
+  }
+
+  bool HeadlessFramework::SaveFrameTimes( std::vector<double> & frame_times,
+                                          std::ostream        & standard_output ) const {
+    double total_time = 0.0;
+    for( auto frame_time : frame_times ) {
+      total_time += frame_time;
+    }
+    std::sort( frame_times.begin(), frame_times.end() );
+
+    // Nearest-rank percentile
+    auto percentile = [&]( double fraction ) {
+      size_t rank = static_cast<size_t>(std::ceil( fraction * frame_times.size() ));
+      return frame_times[std::min( std::max<size_t>( rank, 1 ), frame_times.size() ) - 1];
+    };
+
+    std::string title;
+    for( auto character : Title ) {
+      if( ('"' == character) ||
+          ('\\' == character) ) {
+        title += '\\';
+      }
+      title += character;
+    }
+
+    std::ostringstream json;
+    json << "{\n"
+         << "  \"sample\": \"" << title << "\",\n"
+         << "  \"width\": " << Width << ",\n"
+         << "  \"height\": " << Height << ",\n"
+         << "  \"frames\": " << frame_times.size() << ",\n"
+         << "  \"warmup_frames\": " << Parameters.WarmupFramesCount << ",\n"
+         << "  \"frame_delta_time\": " << Parameters.FrameDeltaTime << ",\n"
+         << "  \"frame_time_ms\": {\n"
+         << "    \"min\": " << frame_times.front() << ",\n"
+         << "    \"mean\": " << total_time / frame_times.size() << ",\n"
+         << "    \"p50\": " << percentile( 0.50 ) << ",\n"
+         << "    \"p95\": " << percentile( 0.95 ) << ",\n"
+         << "    \"p99\": " << percentile( 0.99 ) << ",\n"
+         << "    \"max\": " << frame_times.back() << "\n"
+         << "  },\n"
+         << "  \"frames_per_second\": " << 1000.0 * frame_times.size() / total_time << "\n"
+         << "}\n";
+
+    if( Parameters.OutputFilename.empty() ) {
+      standard_output << json.str() << std::flush;
+      return true;
+    }
+
+    std::ofstream file( Parameters.OutputFilename );
+    if( !file ) {
+      std::cout << "Could not open '" << Parameters.OutputFilename << "' file for writing." << std::endl;
+      return false;
+    }
+    file << json.str();
+    return true;
+  }
+
 } // namespace VulkanCookbook
@@ -36,12 +36,29 @@
 #include <Windows.h>
 #endif
 
+#include <chrono>
+#include <ctime>
 #include "Common.h"
 
 namespace VulkanCookbook {
 
   class VulkanCookbookSampleBase;
 
+  // Policies of drawing frames in a window's message loop
+
+  enum RenderingPolicy {
+    RENDERING_POLICY_CONTINUOUS,   // Frames are drawn as fast as possible
+    RENDERING_POLICY_ON_INPUT,     // Loop sleeps until user input or a window event requires a new frame
+    RENDERING_POLICY_CAPPED        // Frames are drawn no more often than the specified frame rate
+  };
+
+  struct LoopParameters {
+    RenderingPolicy  Policy;
+    float            MaxFramesPerSecond;
+
+    LoopParameters();
+  };
+
   // Window managemenet class
 
   class WindowFramework {
@@ -51,15 +68,88 @@ namespace VulkanCookbook {
                               int                        y,
                               int                        width,
                               int                        height,
-                              VulkanCookbookSampleBase & sample );
+                              VulkanCookbookSampleBase & sample,
+                              LoopParameters const     & loop_parameters = LoopParameters() );
     virtual ~WindowFramework();
 
     virtual void Render() final;
 
   private:
-    WindowParameters           WindowParams;
+    void  StartLoop();
+    void  RequestRedraw( bool input );
+    bool  ShouldDraw() const;
+    int   GetWaitTimeout() const;
+    void  DrawFrame();
+    void  PrintStatistics() const;
+
+    WindowParameters                       WindowParams;
+    VulkanCookbookSampleBase             & Sample;
+    bool                                   Created;
+    LoopParameters                         Loop;
+    bool                                   RedrawRequested;
+    bool                                   InputPending;
+    std::chrono::steady_clock::time_point  InputTime;
+    std::chrono::steady_clock::time_point  NextFrameTime;
+    std::chrono::steady_clock::time_point  StartTime;
+    std::clock_t                           StartCpuTime;
+    uint32_t                               FramesCount;
+    uint32_t                               InputFramesCount;
+    double                                 LatencySum;
+    double                                 LatencyMax;
+#ifdef VK_USE_PLATFORM_XLIB_KHR
+    Atom                                   DeleteWindowAtom;
+    int                                    Width;
+    int                                    Height;
+#elif defined VK_USE_PLATFORM_XCB_KHR
+    xcb_atom_t                             DeleteWindowAtom;
+    xcb_keycode_t                          EscapeKeyCode;
+    int                                    Width;
+    int                                    Height;
+#endif
+  };
+
+  // Parameters of a headless, fixed-frame benchmark run
+
+  struct BenchmarkParameters {
+    uint32_t     FramesCount;
+    uint32_t     WarmupFramesCount;
+    float        FrameDeltaTime;
+    std::string  OutputFilename;
+
+    BenchmarkParameters();
+  };
+
+  // Reads "--headless [--frames <count>] [--warmup <count>] [--delta-time <seconds>] [--output <file.json>]" and
+  // "--policy <continuous|on-input|capped>" / "--fps <count>" command line arguments;
+  // returns true when a headless mode was requested
+
+  bool ParseCommandLineArguments( int                   argc,
+                                  char               ** argv,
+                                  BenchmarkParameters & benchmark_parameters,
+                                  LoopParameters      & loop_parameters );
+
+  // Run loop without a window - sample renders offscreen with a deterministic timer
+  // and frame time percentiles are stored as JSON
+
+  class HeadlessFramework {
+  public:
+    HeadlessFramework( const char                * title,
+                       int                         width,
+                       int                         height,
+                       BenchmarkParameters const & parameters,
+                       VulkanCookbookSampleBase  & sample );
+
+    virtual bool Render() final;
+
+  private:
+    bool  SaveFrameTimes( std::vector<double> & frame_times,
+                          std::ostream        & standard_output ) const;
+
+    std::string                Title;
+    uint32_t                   Width;
+    uint32_t                   Height;
+    BenchmarkParameters        Parameters;
     VulkanCookbookSampleBase & Sample;
-    bool                       Created;
   };
 
 } // namespace VulkanCookbook
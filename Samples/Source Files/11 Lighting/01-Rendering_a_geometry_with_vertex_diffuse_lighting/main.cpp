@@ -35,9 +35,11 @@
 using namespace VulkanCookbook;
 
 class Sample : public VulkanCookbookSample {
-  Mesh                                Model;
+  MappedMesh                          Model;
   VkDestroyer(VkBuffer)               VertexBuffer;
   VkDestroyer(VkDeviceMemory)         VertexBufferMemory;
+  VkDestroyer(VkBuffer)               IndexBuffer;
+  VkDestroyer(VkDeviceMemory)         IndexBufferMemory;
 
   VkDestroyer(VkDescriptorSetLayout)  DescriptorSetLayout;
   VkDestroyer(VkDescriptorPool)       DescriptorPool;
@@ -64,7 +66,7 @@ class Sample : public VulkanCookbookSample {
     }
 
     InitVkDestroyer( LogicalDevice, VertexBuffer );
-    if( !CreateBuffer( *LogicalDevice, sizeof( Model.Data[0] ) * Model.Data.size(),
+    if( !CreateBuffer( *LogicalDevice, Model.GetVertexDataSize(),
       VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, *VertexBuffer ) ) {
       return false;
     }
@@ -74,8 +76,26 @@ class Sample : public VulkanCookbookSample {
       return false;
     }
 
-    if( !UseStagingBufferToUpdateBufferWithDeviceLocalMemoryBound( PhysicalDevice, *LogicalDevice, sizeof( Model.Data[0] ) * Model.Data.size(),
-      &Model.Data[0], *VertexBuffer, 0, 0, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+    if( !UseStagingBufferToUpdateBufferWithDeviceLocalMemoryBound( PhysicalDevice, *LogicalDevice, Model.GetVertexDataSize(),
+      Model.GetVertexData(), *VertexBuffer, 0, 0, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+      GraphicsQueue.Handle, FramesResources.front().CommandBuffer, {} ) ) {
+      return false;
+    }
+
+    // Index data
+    InitVkDestroyer( LogicalDevice, IndexBuffer );
+    if( !CreateBuffer( *LogicalDevice, Model.GetIndexDataSize(),
+      VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, *IndexBuffer ) ) {
+      return false;
+    }
+
+    InitVkDestroyer( LogicalDevice, IndexBufferMemory );
+    if( !AllocateAndBindMemoryObjectToBuffer( PhysicalDevice, *LogicalDevice, *IndexBuffer, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, *IndexBufferMemory ) ) {
+      return false;
+    }
+
+    if( !UseStagingBufferToUpdateBufferWithDeviceLocalMemoryBound( PhysicalDevice, *LogicalDevice, Model.GetIndexDataSize(),
+      Model.GetIndexData(), *IndexBuffer, 0, 0, VK_ACCESS_INDEX_READ_BIT, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
       GraphicsQueue.Handle, FramesResources.front().CommandBuffer, {} ) ) {
       return false;
     }
@@ -89,6 +109,9 @@ class Sample : public VulkanCookbookSample {
     if( !AllocateAndBindMemoryObjectToBuffer( PhysicalDevice, *LogicalDevice, *StagingBuffer, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, *StagingBufferMemory ) ) {
       return false;
     }
+    if( !MappedMemory.Map( *StagingBufferMemory, 2 * 16 * sizeof( float ), VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT ) ) {
+      return false;
+    }
 
     // Uniform buffer
     InitVkDestroyer( LogicalDevice, UniformBuffer );
@@ -377,6 +400,11 @@ class Sample : public VulkanCookbookSample {
       if( UpdateUniformBuffer ) {
         UpdateUniformBuffer = false;
 
+        // Matrices written into the staging buffer since the previous frame are flushed with a single call
+        if( !MappedMemory.FlushDirtyRanges() ) {
+          return false;
+        }
+
         BufferTransition pre_transfer_transition = {
           *UniformBuffer,               // VkBuffer         Buffer
           VK_ACCESS_UNIFORM_READ_BIT,   // VkAccessFlags    CurrentAccess
@@ -446,12 +474,14 @@ class Sample : public VulkanCookbookSample {
 
       BindVertexBuffers( command_buffer, 0, { { *VertexBuffer, 0 } } );
 
+      BindIndexBuffer( command_buffer, *IndexBuffer, 0, Model.GetIndexType() );
+
       BindDescriptorSets( command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, *PipelineLayout, 0, DescriptorSets, {} );
 
       BindPipelineObject( command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, *Pipeline );
 
-      for( size_t i = 0; i < Model.Parts.size(); ++i ) {
-        DrawGeometry( command_buffer, Model.Parts[i].VertexCount, 1, Model.Parts[i].VertexOffset, 0 );
+      for( auto & part : Model.GetParts() ) {
+        DrawIndexedGeometry( command_buffer, part.IndexCount, 1, part.IndexOffset, part.VertexOffset, 0 );
       }
 
       EndRenderPass( command_buffer );
@@ -477,7 +507,7 @@ class Sample : public VulkanCookbookSample {
     };
 
     return IncreasePerformanceThroughIncreasingTheNumberOfSeparatelyRenderedFrames( *LogicalDevice, GraphicsQueue.Handle, PresentQueue.Handle,
-      *Swapchain.Handle, Swapchain.Size, Swapchain.ImageViewsRaw, *RenderPass, {}, prepare_frame, FramesResources );
+      *Swapchain.Handle, Swapchain.Size, Swapchain.ImageViewsRaw, *RenderPass, {}, prepare_frame, FramesResources, Framebuffers, FramePacing, FrameCommandPools, TransientDescriptorSets );
   }
 
   void OnMouseEvent() {
@@ -503,15 +533,15 @@ class Sample : public VulkanCookbookSample {
       Matrix4x4 translation_matrix = PrepareTranslationMatrix( 0.0f, 0.0f, -4.0f );
       Matrix4x4 model_view_matrix = translation_matrix * rotation_matrix;
 
-      if( !MapUpdateAndUnmapHostVisibleMemory( *LogicalDevice, *StagingBufferMemory, 0, sizeof( model_view_matrix[0] ) * model_view_matrix.size(), &model_view_matrix[0], true, nullptr ) ) {
+      if( !MappedMemory.Write( *StagingBufferMemory, 0, sizeof( model_view_matrix[0] ) * model_view_matrix.size(), &model_view_matrix[0] ) ) {
         return false;
       }
 
       Matrix4x4 perspective_matrix = PreparePerspectiveProjectionMatrix( static_cast<float>(Swapchain.Size.width) / static_cast<float>(Swapchain.Size.height),
         50.0f, 0.5f, 10.0f );
 
-      if( !MapUpdateAndUnmapHostVisibleMemory( *LogicalDevice, *StagingBufferMemory, sizeof( model_view_matrix[0] ) * model_view_matrix.size(),
-        sizeof( perspective_matrix[0] ) * perspective_matrix.size(), &perspective_matrix[0], true, nullptr ) ) {
+      if( !MappedMemory.Write( *StagingBufferMemory, sizeof( model_view_matrix[0] ) * model_view_matrix.size(),
+        sizeof( perspective_matrix[0] ) * perspective_matrix.size(), &perspective_matrix[0] ) ) {
         return false;
       }
     }
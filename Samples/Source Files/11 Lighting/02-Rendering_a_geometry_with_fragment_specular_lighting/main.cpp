@@ -89,6 +89,9 @@ class Sample : public VulkanCookbookSample {
     if( !AllocateAndBindMemoryObjectToBuffer( PhysicalDevice, *LogicalDevice, *StagingBuffer, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, *StagingBufferMemory ) ) {
       return false;
     }
+    if( !MappedMemory.Map( *StagingBufferMemory, 2 * 16 * sizeof( float ), VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT ) ) {
+      return false;
+    }
 
     // Uniform buffer
     InitVkDestroyer( LogicalDevice, UniformBuffer );
@@ -384,6 +387,11 @@ class Sample : public VulkanCookbookSample {
       if( UpdateUniformBuffer ) {
         UpdateUniformBuffer = false;
 
+        // Matrices written into the staging buffer since the previous frame are flushed with a single call
+        if( !MappedMemory.FlushDirtyRanges() ) {
+          return false;
+        }
+
         BufferTransition pre_transfer_transition = {
           *UniformBuffer,               // VkBuffer         Buffer
           VK_ACCESS_UNIFORM_READ_BIT,   // VkAccessFlags    CurrentAccess
@@ -487,7 +495,7 @@ class Sample : public VulkanCookbookSample {
     };
 
     return IncreasePerformanceThroughIncreasingTheNumberOfSeparatelyRenderedFrames( *LogicalDevice, GraphicsQueue.Handle, PresentQueue.Handle,
-      *Swapchain.Handle, Swapchain.Size, Swapchain.ImageViewsRaw, *RenderPass, {}, prepare_frame, FramesResources );
+      *Swapchain.Handle, Swapchain.Size, Swapchain.ImageViewsRaw, *RenderPass, {}, prepare_frame, FramesResources, Framebuffers, FramePacing, FrameCommandPools, TransientDescriptorSets );
   }
 
   void OnMouseEvent() {
@@ -513,15 +521,15 @@ class Sample : public VulkanCookbookSample {
       Matrix4x4 translation_matrix = PrepareTranslationMatrix( 0.0f, 0.0f, -4.0f );
       Matrix4x4 model_view_matrix = translation_matrix * rotation_matrix;
 
-      if( !MapUpdateAndUnmapHostVisibleMemory( *LogicalDevice, *StagingBufferMemory, 0, sizeof( model_view_matrix[0] ) * model_view_matrix.size(), &model_view_matrix[0], true, nullptr ) ) {
+      if( !MappedMemory.Write( *StagingBufferMemory, 0, sizeof( model_view_matrix[0] ) * model_view_matrix.size(), &model_view_matrix[0] ) ) {
         return false;
       }
 
       Matrix4x4 perspective_matrix = PreparePerspectiveProjectionMatrix( static_cast<float>(Swapchain.Size.width) / static_cast<float>(Swapchain.Size.height),
         50.0f, 0.5f, 10.0f );
 
-      if( !MapUpdateAndUnmapHostVisibleMemory( *LogicalDevice, *StagingBufferMemory, sizeof( model_view_matrix[0] ) * model_view_matrix.size(),
-        sizeof( perspective_matrix[0] ) * perspective_matrix.size(), &perspective_matrix[0], true, nullptr ) ) {
+      if( !MappedMemory.Write( *StagingBufferMemory, sizeof( model_view_matrix[0] ) * model_view_matrix.size(),
+        sizeof( perspective_matrix[0] ) * perspective_matrix.size(), &perspective_matrix[0] ) ) {
         return false;
       }
     }
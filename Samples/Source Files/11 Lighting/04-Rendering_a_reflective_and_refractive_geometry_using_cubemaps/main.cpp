@@ -71,6 +71,11 @@ class Sample : public VulkanCookbookSample {
       return false;
     }
 
+    // Staging ring holds all uploads of a 1024x1024 RGBA cubemap with mipmaps, so they are submitted at once
+    if( !Uploader.Initialize( PhysicalDevice, *LogicalDevice, GraphicsQueue.Handle, GraphicsQueue.FamilyIndex, 40 * 1024 * 1024 ) ) {
+      return false;
+    }
+
     Camera = OrbitingCamera( Vector3{ 0.0f, 0.0f, 0.0f }, 4.0f );
 
     // Vertex data - model
@@ -90,9 +95,8 @@ class Sample : public VulkanCookbookSample {
       return false;
     }
 
-    if( !UseStagingBufferToUpdateBufferWithDeviceLocalMemoryBound( PhysicalDevice, *LogicalDevice, sizeof( Model.Data[0] ) * Model.Data.size(),
-      &Model.Data[0], *ModelVertexBuffer, 0, 0, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
-      GraphicsQueue.Handle, FramesResources.front().CommandBuffer, {} ) ) {
+    if( !Uploader.UpdateBuffer( sizeof( Model.Data[0] ) * Model.Data.size(), &Model.Data[0], *ModelVertexBuffer, 0, 0, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT,
+      VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT ) ) {
       return false;
     }
 
@@ -113,9 +117,8 @@ class Sample : public VulkanCookbookSample {
       return false;
     }
 
-    if( !UseStagingBufferToUpdateBufferWithDeviceLocalMemoryBound( PhysicalDevice, *LogicalDevice, sizeof( Skybox.Data[0] ) * Skybox.Data.size(),
-      &Skybox.Data[0], *SkyboxVertexBuffer, 0, 0, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
-      GraphicsQueue.Handle, FramesResources.front().CommandBuffer, {} ) ) {
+    if( !Uploader.UpdateBuffer( sizeof( Skybox.Data[0] ) * Skybox.Data.size(), &Skybox.Data[0], *SkyboxVertexBuffer, 0, 0, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT,
+      VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT ) ) {
       return false;
     }
 
@@ -128,6 +131,9 @@ class Sample : public VulkanCookbookSample {
     if( !AllocateAndBindMemoryObjectToBuffer( PhysicalDevice, *LogicalDevice, *StagingBuffer, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, *StagingBufferMemory ) ) {
       return false;
     }
+    if( !MappedMemory.Map( *StagingBufferMemory, 2 * 16 * sizeof( float ), VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT ) ) {
+      return false;
+    }
 
     // Uniform buffer
     InitVkDestroyer( LogicalDevice, UniformBuffer );
@@ -146,10 +152,12 @@ class Sample : public VulkanCookbookSample {
     InitVkDestroyer( LogicalDevice, CubemapImageMemory );
     InitVkDestroyer( LogicalDevice, CubemapImageView );
     InitVkDestroyer( LogicalDevice, CubemapSampler );
-    if( !CreateCombinedImageSampler( PhysicalDevice, *LogicalDevice, VK_IMAGE_TYPE_2D, VK_FORMAT_R8G8B8A8_UNORM, { 1024, 1024, 1 }, 1, 6,
+    uint32_t cubemap_mipmap_levels_count = GetMipmapLevelsCount( 1024, 1024 );
+    if( !CreateCombinedImageSampler( PhysicalDevice, *LogicalDevice, VK_IMAGE_TYPE_2D, VK_FORMAT_R8G8B8A8_UNORM, { 1024, 1024, 1 }, cubemap_mipmap_levels_count, 6,
       VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT, true, VK_IMAGE_VIEW_TYPE_CUBE, VK_IMAGE_ASPECT_COLOR_BIT, VK_FILTER_LINEAR,
-      VK_FILTER_LINEAR, VK_SAMPLER_MIPMAP_MODE_NEAREST, VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
-      VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, 0.0f, false, 1.0f, false, VK_COMPARE_OP_ALWAYS, 0.0f, 1.0f, VK_BORDER_COLOR_FLOAT_OPAQUE_BLACK,
+      VK_FILTER_LINEAR, VK_SAMPLER_MIPMAP_MODE_LINEAR, VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+      VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, 0.0f, false, 1.0f, false, VK_COMPARE_OP_ALWAYS, 0.0f, static_cast<float>(cubemap_mipmap_levels_count),
+      VK_BORDER_COLOR_FLOAT_OPAQUE_BLACK,
       false, *CubemapSampler, *CubemapImage, *CubemapImageMemory, *CubemapImageView ) ) {
       return false;
     }
@@ -163,22 +171,59 @@ class Sample : public VulkanCookbookSample {
       "Data/Textures/Skansen/negz.jpg"
     };
 
+    // Worker threads are needed only to decode the cubemap faces in parallel
+    if( !RecordingThreads.Initialize( *LogicalDevice, GraphicsQueue.FamilyIndex, std::max( 1u, std::thread::hardware_concurrency() ), FramesCount ) ) {
+      return false;
+    }
+
+    // All faces are decoded at the same time on worker threads
+    auto loading_start_time = std::chrono::steady_clock::now();
+    std::vector<unsigned char> cubemap_image_data;
+    std::vector<TextureDecodeResult> cubemap_images_results;
+    if( !LoadTextureDataFromFiles( cubemap_images, 4, cubemap_image_data, cubemap_images_results, &RecordingThreads ) ) {
+      return false;
+    }
+    std::chrono::duration<double, std::milli> loading_time = std::chrono::steady_clock::now() - loading_start_time;
+    std::cout << "Cubemap faces loaded in " << loading_time.count() << " ms (decoding:";
+    for( size_t i = 0; i < cubemap_images.size(); ++i ) {
+      std::cout << " " << cubemap_images[i] << " " << cubemap_images_results[i].DecodeTime << " ms" << (i + 1 < cubemap_images.size() ? "," : ")");
+    }
+    std::cout << std::endl;
+
     for( size_t i = 0; i < cubemap_images.size(); ++i ) {
-      std::vector<unsigned char> cubemap_image_data;
-      int image_data_size;
-      if( !LoadTextureDataFromFile( cubemap_images[i].c_str(), 4, cubemap_image_data, nullptr, nullptr, nullptr, &image_data_size ) ) {
+      // Each face fills the whole layer of the cubemap image
+      if( (1024 != cubemap_images_results[i].Width) ||
+          (1024 != cubemap_images_results[i].Height) ) {
+        std::cout << "Cubemap face '" << cubemap_images[i] << "' is " << cubemap_images_results[i].Width << "x" << cubemap_images_results[i].Height
+                  << " instead of 1024x1024!" << std::endl;
         return false;
       }
-      VkImageSubresourceLayers image_subresource = {
-        VK_IMAGE_ASPECT_COLOR_BIT,    // VkImageAspectFlags     aspectMask
-        0,                            // uint32_t               mipLevel
-        static_cast<uint32_t>(i),     // uint32_t               baseArrayLayer
-        1                             // uint32_t               layerCount
-      };
-      UseStagingBufferToUpdateImageWithDeviceLocalMemoryBound( PhysicalDevice, *LogicalDevice, image_data_size, &cubemap_image_data[0],
-        *CubemapImage, image_subresource, { 0, 0, 0 }, { 1024, 1024, 1 }, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-        0, VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_ASPECT_COLOR_BIT, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
-        GraphicsQueue.Handle, FramesResources.front().CommandBuffer, {} );
+
+      std::vector<unsigned char> mipmap_data;
+      std::vector<MipmapLevel> mipmap_levels;
+      if( !GenerateMipmapChain( cubemap_images_results[i].Data, static_cast<uint32_t>(cubemap_images_results[i].Width),
+        static_cast<uint32_t>(cubemap_images_results[i].Height), 4, true, mipmap_data, mipmap_levels ) ) {
+        return false;
+      }
+
+      for( size_t level = 0; level < mipmap_levels.size(); ++level ) {
+        VkImageSubresourceLayers image_subresource = {
+          VK_IMAGE_ASPECT_COLOR_BIT,        // VkImageAspectFlags     aspectMask
+          static_cast<uint32_t>(level),     // uint32_t               mipLevel
+          static_cast<uint32_t>(i),         // uint32_t               baseArrayLayer
+          1                                 // uint32_t               layerCount
+        };
+        if( !Uploader.UpdateImage( mipmap_levels[level].DataSize, &mipmap_data[mipmap_levels[level].Offset], *CubemapImage, image_subresource, { 0, 0, 0 },
+          { mipmap_levels[level].Width, mipmap_levels[level].Height, 1 }, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 0,
+          VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_ASPECT_COLOR_BIT, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT ) ) {
+          return false;
+        }
+      }
+    }
+
+    // Vertex data and all mipmap levels of all cubemap faces are uploaded in a single submission
+    if( !Uploader.Flush() ) {
+      return false;
     }
 
     // Descriptor set
@@ -585,6 +630,11 @@ class Sample : public VulkanCookbookSample {
       if( UpdateUniformBuffer ) {
         UpdateUniformBuffer = false;
 
+        // Matrices written into the staging buffer since the previous frame are flushed with a single call
+        if( !MappedMemory.FlushDirtyRanges() ) {
+          return false;
+        }
+
         BufferTransition pre_transfer_transition = {
           *UniformBuffer,               // VkBuffer         Buffer
           VK_ACCESS_UNIFORM_READ_BIT,   // VkAccessFlags    CurrentAccess
@@ -699,7 +749,7 @@ class Sample : public VulkanCookbookSample {
     };
 
     return IncreasePerformanceThroughIncreasingTheNumberOfSeparatelyRenderedFrames( *LogicalDevice, GraphicsQueue.Handle, PresentQueue.Handle,
-      *Swapchain.Handle, Swapchain.Size, Swapchain.ImageViewsRaw, *RenderPass, {}, prepare_frame, FramesResources );
+      *Swapchain.Handle, Swapchain.Size, Swapchain.ImageViewsRaw, *RenderPass, {}, prepare_frame, FramesResources, Framebuffers, FramePacing, FrameCommandPools, TransientDescriptorSets );
   }
 
   void OnMouseEvent() {
@@ -715,15 +765,15 @@ class Sample : public VulkanCookbookSample {
 
       Matrix4x4 view_matrix = Camera.GetMatrix();
 
-      if( !MapUpdateAndUnmapHostVisibleMemory( *LogicalDevice, *StagingBufferMemory, 0, sizeof( view_matrix[0] ) * view_matrix.size(), &view_matrix[0], true, nullptr ) ) {
+      if( !MappedMemory.Write( *StagingBufferMemory, 0, sizeof( view_matrix[0] ) * view_matrix.size(), &view_matrix[0] ) ) {
         return false;
       }
 
       Matrix4x4 perspective_matrix = PreparePerspectiveProjectionMatrix( static_cast<float>(Swapchain.Size.width) / static_cast<float>(Swapchain.Size.height),
         50.0f, 0.5f, 10.0f );
 
-      if( !MapUpdateAndUnmapHostVisibleMemory( *LogicalDevice, *StagingBufferMemory, sizeof( view_matrix[0] ) * view_matrix.size(),
-        sizeof( perspective_matrix[0] ) * perspective_matrix.size(), &perspective_matrix[0], true, nullptr ) ) {
+      if( !MappedMemory.Write( *StagingBufferMemory, sizeof( view_matrix[0] ) * view_matrix.size(),
+        sizeof( perspective_matrix[0] ) * perspective_matrix.size(), &perspective_matrix[0] ) ) {
         return false;
       }
     }
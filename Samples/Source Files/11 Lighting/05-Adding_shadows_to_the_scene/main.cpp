@@ -59,11 +59,8 @@ class Sample : public VulkanCookbookSample {
   VkDestroyer(VkRenderPass)               SceneRenderPass;
   VkDestroyer(VkPipeline)                 ScenePipeline;
 
-  VkDestroyer(VkBuffer)                   StagingBuffer;
-  VkDestroyer(VkDeviceMemory)             StagingBufferMemory;
-  bool                                    UpdateUniformBuffer;
-  VkDestroyer(VkBuffer)                   UniformBuffer;
-  VkDestroyer(VkDeviceMemory)             UniformBufferMemory;
+  std::vector<float>                      UniformData;
+  UniformRingBuffer                       UniformRing;
 
   OrbitingCamera                          LightSource;
   OrbitingCamera                          Camera;
@@ -107,25 +104,12 @@ class Sample : public VulkanCookbookSample {
       return false;
     }
 
-    // Staging buffer
-    InitVkDestroyer( LogicalDevice, StagingBuffer );
-    if( !CreateBuffer( *LogicalDevice, 3 * 16 * sizeof(float), VK_BUFFER_USAGE_TRANSFER_SRC_BIT, *StagingBuffer ) ) {
-      return false;
-    }
-    InitVkDestroyer( LogicalDevice, StagingBufferMemory );
-    if( !AllocateAndBindMemoryObjectToBuffer( PhysicalDevice, *LogicalDevice, *StagingBuffer, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, *StagingBufferMemory ) ) {
-      return false;
-    }
-
-    // Uniform buffer
-    InitVkDestroyer( LogicalDevice, UniformBuffer );
-    InitVkDestroyer( LogicalDevice, UniformBufferMemory );
-    if( !CreateUniformBuffer( PhysicalDevice, *LogicalDevice, 3 * 16 * sizeof( float ), VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-      *UniformBuffer, *UniformBufferMemory ) ) {
+    // Uniform ring buffer - separate part for each frame in flight, read by shaders directly
+    if( !UniformRing.Initialize( PhysicalDevice, *LogicalDevice, 4096, FramesCount ) ) {
       return false;
     }
 
-    if( !UpdateStagingBuffer( true ) ) {
+    if( !UpdateUniformData( true ) ) {
       return false;
     }
 
@@ -148,7 +132,7 @@ class Sample : public VulkanCookbookSample {
     std::vector<VkDescriptorSetLayoutBinding> descriptor_set_layout_bindings = {
       {
         0,                                          // uint32_t             binding
-        VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,          // VkDescriptorType     descriptorType
+        VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,  // VkDescriptorType     descriptorType
         1,                                          // uint32_t             descriptorCount
         VK_SHADER_STAGE_VERTEX_BIT,                 // VkShaderStageFlags   stageFlags
         nullptr                                     // const VkSampler    * pImmutableSamplers
@@ -168,7 +152,7 @@ class Sample : public VulkanCookbookSample {
 
     std::vector<VkDescriptorPoolSize> descriptor_pool_sizes = {
       {
-        VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,          // VkDescriptorType     type
+        VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,  // VkDescriptorType     type
         1                                           // uint32_t             descriptorCount
       },
       {
@@ -189,12 +173,12 @@ class Sample : public VulkanCookbookSample {
       DescriptorSets[0],                                // VkDescriptorSet                      TargetDescriptorSet
       0,                                                // uint32_t                             TargetDescriptorBinding
       0,                                                // uint32_t                             TargetArrayElement
-      VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,                // VkDescriptorType                     TargetDescriptorType
+      VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,        // VkDescriptorType                     TargetDescriptorType
       {                                                 // std::vector<VkDescriptorBufferInfo>  BufferInfos
         {
-          *UniformBuffer,                                 // VkBuffer                             buffer
+          UniformRing.GetBuffer(),                        // VkBuffer                             buffer
           0,                                              // VkDeviceSize                         offset
-          VK_WHOLE_SIZE                                   // VkDeviceSize                         range
+          3 * 16 * sizeof( float )                        // VkDeviceSize                         range
         }
       }
     };
@@ -582,35 +566,14 @@ class Sample : public VulkanCookbookSample {
         return false;
       }
 
-      if( UpdateUniformBuffer ) {
-        UpdateUniformBuffer = false;
-
-        BufferTransition pre_transfer_transition = {
-          *UniformBuffer,               // VkBuffer         Buffer
-          VK_ACCESS_UNIFORM_READ_BIT,   // VkAccessFlags    CurrentAccess
-          VK_ACCESS_TRANSFER_WRITE_BIT, // VkAccessFlags    NewAccess
-          VK_QUEUE_FAMILY_IGNORED,      // uint32_t         CurrentQueueFamily
-          VK_QUEUE_FAMILY_IGNORED       // uint32_t         NewQueueFamily
-        };
-        SetBufferMemoryBarrier( command_buffer, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, { pre_transfer_transition } );
-
-        std::vector<VkBufferCopy> regions = {
-          {
-            0,                        // VkDeviceSize     srcOffset
-            0,                        // VkDeviceSize     dstOffset
-            3 * 16 * sizeof( float )  // VkDeviceSize     size
-          }
-        };
-        CopyDataBetweenBuffers( command_buffer, *StagingBuffer, *UniformBuffer, regions );
-
-        BufferTransition post_transfer_transition = {
-          *UniformBuffer,               // VkBuffer         Buffer
-          VK_ACCESS_TRANSFER_WRITE_BIT, // VkAccessFlags    CurrentAccess
-          VK_ACCESS_UNIFORM_READ_BIT,   // VkAccessFlags    NewAccess
-          VK_QUEUE_FAMILY_IGNORED,      // uint32_t         CurrentQueueFamily
-          VK_QUEUE_FAMILY_IGNORED       // uint32_t         NewQueueFamily
-        };
-        SetBufferMemoryBarrier( command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, { post_transfer_transition } );
+      // Frame resources were already acquired by the frame pacer, so the part of the uniform ring
+      // dedicated to this frame isn't used by any previously submitted frame
+      if( !UniformRing.BeginFrame( FramePacing.GetFrameIndex() ) ) {
+        return false;
+      }
+      uint32_t uniform_data_offset;
+      if( !UniformRing.Allocate( sizeof( UniformData[0] ) * UniformData.size(), &UniformData[0], uniform_data_offset ) ) {
+        return false;
       }
 
       // Shadow map generation
@@ -619,7 +582,7 @@ class Sample : public VulkanCookbookSample {
 
       BindVertexBuffers( command_buffer, 0, { { *VertexBuffer, 0 } } );
 
-      BindDescriptorSets( command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, *PipelineLayout, 0, DescriptorSets, {} );
+      BindDescriptorSets( command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, *PipelineLayout, 0, DescriptorSets, { uniform_data_offset } );
 
       BindPipelineObject( command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, *ShadowMapPipeline );
 
@@ -694,17 +657,15 @@ class Sample : public VulkanCookbookSample {
       return true;
     };
 
-    WaitForAllSubmittedCommandsToBeFinished( *LogicalDevice );
-
     return IncreasePerformanceThroughIncreasingTheNumberOfSeparatelyRenderedFrames( *LogicalDevice, GraphicsQueue.Handle, PresentQueue.Handle,
-      *Swapchain.Handle, Swapchain.Size, Swapchain.ImageViewsRaw, *SceneRenderPass, {}, prepare_frame, FramesResources );
+      *Swapchain.Handle, Swapchain.Size, Swapchain.ImageViewsRaw, *SceneRenderPass, {}, prepare_frame, FramesResources, Framebuffers, FramePacing, FrameCommandPools, TransientDescriptorSets );
   }
 
   void OnMouseEvent() {
-    UpdateStagingBuffer( false );
+    UpdateUniformData( false );
   }
 
-  bool UpdateStagingBuffer( bool force ) {
+  bool UpdateUniformData( bool force ) {
     if( MouseState.Buttons[0].IsPressed ) {
       Camera.RotateHorizontally( 0.5f * MouseState.Position.Delta.X );
       Camera.RotateVertically( -0.5f * MouseState.Position.Delta.Y );
@@ -718,20 +679,14 @@ class Sample : public VulkanCookbookSample {
     }
 
     if( force ) {
-      UpdateUniformBuffer = true;
-
       Matrix4x4 light_view_matrix = LightSource.GetMatrix();
       Matrix4x4 scene_view_matrix = Camera.GetMatrix();
       Matrix4x4 perspective_matrix = PreparePerspectiveProjectionMatrix( static_cast<float>(Swapchain.Size.width) / static_cast<float>(Swapchain.Size.height), 50.0f, 0.5f, 10.0f );
 
-      std::vector<float> data;
-      data.insert( data.end(), &light_view_matrix[0], &light_view_matrix[0] + 16 );
-      data.insert( data.end(), &scene_view_matrix[0], &scene_view_matrix[0] + 16 );
-      data.insert( data.end(), &perspective_matrix[0], &perspective_matrix[0] + 16 );
-
-      if( !MapUpdateAndUnmapHostVisibleMemory( *LogicalDevice, *StagingBufferMemory, 0, sizeof( data[0] ) * data.size(), &data[0], true, nullptr ) ) {
-        return false;
-      }
+      UniformData.clear();
+      UniformData.insert( UniformData.end(), &light_view_matrix[0], &light_view_matrix[0] + 16 );
+      UniformData.insert( UniformData.end(), &scene_view_matrix[0], &scene_view_matrix[0] + 16 );
+      UniformData.insert( UniformData.end(), &perspective_matrix[0], &perspective_matrix[0] + 16 );
     }
     return true;
   }
@@ -742,7 +697,7 @@ class Sample : public VulkanCookbookSample {
     }
 
     if( IsReady() ) {
-      if( !UpdateStagingBuffer( true ) ) {
+      if( !UpdateUniformData( true ) ) {
         return false;
       }
     }
@@ -36,35 +36,35 @@
 using namespace VulkanCookbook;
 
 class Sample : public VulkanCookbookSample {
-  VkDestroyer(VkCommandPool)                      ComputeCommandPool;
-  VkCommandBuffer                                 ComputeCommandBuffer;
-  VkDestroyer(VkSemaphore)                        ComputeSemaphore;
-  VkDestroyer(VkFence)                            ComputeFence;
+  VkDestroyer(VkCommandPool)                                        ComputeCommandPool;
+  VkCommandBuffer                                                   ComputeCommandBuffer;
+  VkDestroyer(VkSemaphore)                                          ComputeSemaphore;
+  VkDestroyer(VkFence)                                              ComputeFence;
 
-  const uint32_t                                  PARTICLES_COUNT = 2000;
-  VkDestroyer(VkBuffer)                           VertexBuffer;
-  VkDestroyer(VkDeviceMemory)                     VertexBufferMemory;
-  VkDestroyer(VkBufferView)                       VertexBufferView;
+  const uint32_t                                                    PARTICLES_COUNT = 2000;
+  VkDestroyer(VkBuffer)                                             VertexBuffer;
+  VkDestroyer(VkDeviceMemory)                                       VertexBufferMemory;
+  VkDestroyer(VkBufferView)                                         VertexBufferView;
 
-  bool                                            UpdateUniformBuffer;
-  VkDestroyer(VkBuffer)                           UniformBuffer;
-  VkDestroyer(VkDeviceMemory)                     UniformBufferMemory;
+  bool                                                              UpdateUniformBuffer;
+  VkDestroyer(VkBuffer)                                             UniformBuffer;
+  VkDestroyer(VkDeviceMemory)                                       UniformBufferMemory;
 
-  std::vector<VkDestroyer(VkDescriptorSetLayout)> DescriptorSetLayout;
-  VkDestroyer(VkDescriptorPool)                   DescriptorPool;
-  std::vector<VkDescriptorSet>                    DescriptorSets;
+  std::vector<std::shared_ptr<VkDestroyer(VkDescriptorSetLayout)>>  DescriptorSetLayout;
+  VkDestroyer(VkDescriptorPool)                                     DescriptorPool;
+  std::vector<VkDescriptorSet>                                      DescriptorSets;
 
-  VkDestroyer(VkPipelineLayout)                   ComputePipelineLayout;
-  VkDestroyer(VkPipeline)                         ComputePipeline;
+  std::shared_ptr<VkDestroyer(VkPipelineLayout)>                    ComputePipelineLayout;
+  VkDestroyer(VkPipeline)                                           ComputePipeline;
 
-  VkDestroyer(VkRenderPass)                       RenderPass;
-  VkDestroyer(VkPipelineLayout)                   GraphicsPipelineLayout;
-  VkDestroyer(VkPipeline)                         GraphicsPipeline;
+  VkDestroyer(VkRenderPass)                                         RenderPass;
+  std::shared_ptr<VkDestroyer(VkPipelineLayout)>                    GraphicsPipelineLayout;
+  VkDestroyer(VkPipeline)                                           GraphicsPipeline;
 
-  VkDestroyer(VkBuffer)                           StagingBuffer;
-  VkDestroyer(VkDeviceMemory)                     StagingBufferMemory;
+  VkDestroyer(VkBuffer)                                             StagingBuffer;
+  VkDestroyer(VkDeviceMemory)                                       StagingBufferMemory;
 
-  OrbitingCamera                                  Camera;
+  OrbitingCamera                                                    Camera;
 
 
   static const VkFormat DepthFormat = VK_FORMAT_D16_UNORM;
@@ -137,6 +137,9 @@ class Sample : public VulkanCookbookSample {
     if( !AllocateAndBindMemoryObjectToBuffer( PhysicalDevice, *LogicalDevice, *StagingBuffer, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, *StagingBufferMemory ) ) {
       return false;
     }
+    if( !MappedMemory.Map( *StagingBufferMemory, 2 * 16 * sizeof( float ), VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT ) ) {
+      return false;
+    }
 
     // Uniform buffer
     InitVkDestroyer( LogicalDevice, UniformBuffer );
@@ -171,12 +174,10 @@ class Sample : public VulkanCookbookSample {
     };
 
     DescriptorSetLayout.resize( 2 );
-    InitVkDestroyer( LogicalDevice, DescriptorSetLayout[0] );
-    InitVkDestroyer( LogicalDevice, DescriptorSetLayout[1] );
-    if( !CreateDescriptorSetLayout( *LogicalDevice, { descriptor_set_layout_bindings[0] }, *DescriptorSetLayout[0] ) ) {
+    if( !Layouts.GetDescriptorSetLayout( { descriptor_set_layout_bindings[0] }, DescriptorSetLayout[0] ) ) {
       return false;
     }
-    if( !CreateDescriptorSetLayout( *LogicalDevice, { descriptor_set_layout_bindings[1] }, *DescriptorSetLayout[1] ) ) {
+    if( !Layouts.GetDescriptorSetLayout( { descriptor_set_layout_bindings[1] }, DescriptorSetLayout[1] ) ) {
       return false;
     }
 
@@ -195,7 +196,7 @@ class Sample : public VulkanCookbookSample {
       return false;
     }
 
-    if( !AllocateDescriptorSets( *LogicalDevice, *DescriptorPool, { *DescriptorSetLayout[0], *DescriptorSetLayout[1] }, DescriptorSets ) ) {
+    if( !AllocateDescriptorSets( *LogicalDevice, *DescriptorPool, { **DescriptorSetLayout[0], **DescriptorSetLayout[1] }, DescriptorSets ) ) {
       return false;
     }
 
@@ -331,13 +332,12 @@ class Sample : public VulkanCookbookSample {
       sizeof( float )                 // uint32_t               size
     };
 
-    InitVkDestroyer( LogicalDevice, ComputePipelineLayout );
-    if( !CreatePipelineLayout( *LogicalDevice, { *DescriptorSetLayout[1] }, { push_constant_range }, *ComputePipelineLayout ) ) {
+    if( !Layouts.GetPipelineLayout( { **DescriptorSetLayout[1] }, { push_constant_range }, ComputePipelineLayout ) ) {
       return false;
     }
 
     InitVkDestroyer( LogicalDevice, ComputePipeline );
-    if( !CreateComputePipeline( *LogicalDevice, 0, compute_shader_stage_create_infos[0], *ComputePipelineLayout, VK_NULL_HANDLE, VK_NULL_HANDLE, *ComputePipeline ) ) {
+    if( !CreateComputePipeline( *LogicalDevice, 0, compute_shader_stage_create_infos[0], **ComputePipelineLayout, VK_NULL_HANDLE, VK_NULL_HANDLE, *ComputePipeline ) ) {
       return false;
     }
 
@@ -489,15 +489,14 @@ class Sample : public VulkanCookbookSample {
     VkPipelineDynamicStateCreateInfo dynamic_state_create_info;
     SpecifyPipelineDynamicStates( dynamic_states, dynamic_state_create_info );
 
-    InitVkDestroyer( LogicalDevice, GraphicsPipelineLayout );
-    if( !CreatePipelineLayout( *LogicalDevice, { *DescriptorSetLayout[0] }, {}, *GraphicsPipelineLayout ) ) {
+    if( !Layouts.GetPipelineLayout( { **DescriptorSetLayout[0] }, {}, GraphicsPipelineLayout ) ) {
       return false;
     }
 
     VkGraphicsPipelineCreateInfo pipeline_create_info;
     SpecifyGraphicsPipelineCreationParameters( 0, shader_stage_create_infos, vertex_input_state_create_info, input_assembly_state_create_info,
       nullptr, &viewport_state_create_info, rasterization_state_create_info, &multisample_state_create_info, &depth_stencil_state_create_info, &blend_state_create_info,
-      &dynamic_state_create_info, *GraphicsPipelineLayout, *RenderPass, 0, VK_NULL_HANDLE, -1, pipeline_create_info );
+      &dynamic_state_create_info, **GraphicsPipelineLayout, *RenderPass, 0, VK_NULL_HANDLE, -1, pipeline_create_info );
 
     std::vector<VkPipeline> graphics_pipeline;
     if( !CreateGraphicsPipelines( *LogicalDevice, { pipeline_create_info }, VK_NULL_HANDLE, graphics_pipeline ) ) {
@@ -539,12 +538,12 @@ class Sample : public VulkanCookbookSample {
       return false;
     }
 
-    BindDescriptorSets( ComputeCommandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, *ComputePipelineLayout, 0, { DescriptorSets[1] }, {} );
+    BindDescriptorSets( ComputeCommandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, **ComputePipelineLayout, 0, { DescriptorSets[1] }, {} );
 
     BindPipelineObject( ComputeCommandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, *ComputePipeline );
 
     float time = TimerState.GetDeltaTime();
-    ProvideDataToShadersThroughPushConstants( ComputeCommandBuffer, *ComputePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof( float ), &time );
+    ProvideDataToShadersThroughPushConstants( ComputeCommandBuffer, **ComputePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof( float ), &time );
 
     DispatchComputeWork( ComputeCommandBuffer, PARTICLES_COUNT / 32 + 1, 1, 1 );
 
@@ -566,6 +565,11 @@ class Sample : public VulkanCookbookSample {
       if( UpdateUniformBuffer ) {
         UpdateUniformBuffer = false;
 
+        // Matrices written into the staging buffer since the previous frame are flushed with a single call
+        if( !MappedMemory.FlushDirtyRanges() ) {
+          return false;
+        }
+
         BufferTransition pre_transfer_transition = {
           *UniformBuffer,               // VkBuffer         Buffer
           VK_ACCESS_UNIFORM_READ_BIT,   // VkAccessFlags    CurrentAccess
@@ -635,7 +639,7 @@ class Sample : public VulkanCookbookSample {
 
       BindVertexBuffers( command_buffer, 0, { { *VertexBuffer, 0 } } );
 
-      BindDescriptorSets( command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, *GraphicsPipelineLayout, 0, { DescriptorSets[0] }, {} );
+      BindDescriptorSets( command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, **GraphicsPipelineLayout, 0, { DescriptorSets[0] }, {} );
 
       BindPipelineObject( command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, *GraphicsPipeline );
 
@@ -664,7 +668,7 @@ class Sample : public VulkanCookbookSample {
     };
 
     return IncreasePerformanceThroughIncreasingTheNumberOfSeparatelyRenderedFrames( *LogicalDevice, GraphicsQueue.Handle, PresentQueue.Handle,
-      *Swapchain.Handle, Swapchain.Size, Swapchain.ImageViewsRaw, *RenderPass, { wait_semaphore_info }, prepare_frame, FramesResources );
+      *Swapchain.Handle, Swapchain.Size, Swapchain.ImageViewsRaw, *RenderPass, { wait_semaphore_info }, prepare_frame, FramesResources, Framebuffers, FramePacing, FrameCommandPools, TransientDescriptorSets );
   }
 
   void OnMouseEvent() {
@@ -683,15 +687,15 @@ class Sample : public VulkanCookbookSample {
 
       Matrix4x4 model_view_matrix = Camera.GetMatrix();
 
-      if( !MapUpdateAndUnmapHostVisibleMemory( *LogicalDevice, *StagingBufferMemory, 0, sizeof( model_view_matrix[0] ) * model_view_matrix.size(), &model_view_matrix[0], true, nullptr ) ) {
+      if( !MappedMemory.Write( *StagingBufferMemory, 0, sizeof( model_view_matrix[0] ) * model_view_matrix.size(), &model_view_matrix[0] ) ) {
         return false;
       }
 
       Matrix4x4 perspective_matrix = PreparePerspectiveProjectionMatrix( static_cast<float>(Swapchain.Size.width) / static_cast<float>(Swapchain.Size.height),
         50.0f, 0.5f, 10.0f );
 
-      if( !MapUpdateAndUnmapHostVisibleMemory( *LogicalDevice, *StagingBufferMemory, sizeof( model_view_matrix[0] ) * model_view_matrix.size(),
-        sizeof( perspective_matrix[0] ) * perspective_matrix.size(), &perspective_matrix[0], true, nullptr ) ) {
+      if( !MappedMemory.Write( *StagingBufferMemory, sizeof( model_view_matrix[0] ) * model_view_matrix.size(),
+        sizeof( perspective_matrix[0] ) * perspective_matrix.size(), &perspective_matrix[0] ) ) {
         return false;
       }
     }
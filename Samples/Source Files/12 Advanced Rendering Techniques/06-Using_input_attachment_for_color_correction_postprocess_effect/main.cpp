@@ -85,6 +85,11 @@ class Sample : public VulkanCookbookSample {
       return false;
     }
 
+    // Staging ring holds all faces of a 1024x1024 RGBA cubemap, so they are uploaded with one submission
+    if( !Uploader.Initialize( PhysicalDevice, *LogicalDevice, GraphicsQueue.Handle, GraphicsQueue.FamilyIndex, 32 * 1024 * 1024 ) ) {
+      return false;
+    }
+
     Camera = OrbitingCamera( Vector3{ 0.0f, 0.0f, 0.0f }, 4.0f );
 
     InitVkDestroyer( LogicalDevice, SceneFence );
@@ -175,6 +180,9 @@ class Sample : public VulkanCookbookSample {
     if( !AllocateAndBindMemoryObjectToBuffer( PhysicalDevice, *LogicalDevice, *StagingBuffer, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, *StagingBufferMemory ) ) {
       return false;
     }
+    if( !MappedMemory.Map( *StagingBufferMemory, 2 * 16 * sizeof( float ), VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT ) ) {
+      return false;
+    }
 
     // Uniform buffer
 
@@ -195,11 +203,17 @@ class Sample : public VulkanCookbookSample {
     InitVkDestroyer( LogicalDevice, CubemapImageMemory );
     InitVkDestroyer( LogicalDevice, CubemapImageView );
     InitVkDestroyer( LogicalDevice, CubemapSampler );
-    if( !CreateCombinedImageSampler( PhysicalDevice, *LogicalDevice, VK_IMAGE_TYPE_2D, VK_FORMAT_R8G8B8A8_UNORM, { 1024, 1024, 1 }, 1, 6,
-      VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT, true, VK_IMAGE_VIEW_TYPE_CUBE, VK_IMAGE_ASPECT_COLOR_BIT, VK_FILTER_LINEAR,
-      VK_FILTER_LINEAR, VK_SAMPLER_MIPMAP_MODE_NEAREST, VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
-      VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, 0.0f, false, 1.0f, false, VK_COMPARE_OP_ALWAYS, 0.0f, 1.0f, VK_BORDER_COLOR_FLOAT_OPAQUE_BLACK,
-      false, *CubemapSampler, *CubemapImage, *CubemapImageMemory, *CubemapImageView ) ) {
+    // Mipmaps are generated on the GPU when the format supports linearly filtered blits
+    uint32_t cubemap_mipmap_levels_count = 1;
+    if( CheckIfFormatSupportsMipmapGenerationWithBlits( PhysicalDevice, VK_FORMAT_R8G8B8A8_UNORM ) ) {
+      cubemap_mipmap_levels_count = GetMipmapLevelsCount( 1024, 1024 );
+    }
+    if( !CreateCombinedImageSampler( PhysicalDevice, *LogicalDevice, VK_IMAGE_TYPE_2D, VK_FORMAT_R8G8B8A8_UNORM, { 1024, 1024, 1 }, cubemap_mipmap_levels_count, 6,
+      VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT, true, VK_IMAGE_VIEW_TYPE_CUBE,
+      VK_IMAGE_ASPECT_COLOR_BIT, VK_FILTER_LINEAR, VK_FILTER_LINEAR, VK_SAMPLER_MIPMAP_MODE_LINEAR, VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+      VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, 0.0f, false, 1.0f, false, VK_COMPARE_OP_ALWAYS, 0.0f,
+      static_cast<float>(cubemap_mipmap_levels_count), VK_BORDER_COLOR_FLOAT_OPAQUE_BLACK,
+      false, *CubemapSampler, *CubemapImage, *CubemapImageMemory, *CubemapImageView, true ) ) {
       return false;
     }
 
@@ -224,10 +238,33 @@ class Sample : public VulkanCookbookSample {
         static_cast<uint32_t>(i),     // uint32_t               baseArrayLayer
         1                             // uint32_t               layerCount
       };
-      UseStagingBufferToUpdateImageWithDeviceLocalMemoryBound( PhysicalDevice, *LogicalDevice, image_data_size, &cubemap_image_data[0],
-        *CubemapImage, image_subresource, { 0, 0, 0 }, { 1024, 1024, 1 }, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-        0, VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_ASPECT_COLOR_BIT, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
-        GraphicsQueue.Handle, FramesResources.front().CommandBuffer, {} );
+      if( !Uploader.UpdateImage( image_data_size, &cubemap_image_data[0], *CubemapImage, image_subresource, { 0, 0, 0 }, { 1024, 1024, 1 },
+        VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 0, VK_ACCESS_TRANSFER_WRITE_BIT, VK_IMAGE_ASPECT_COLOR_BIT,
+        VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT ) ) {
+        return false;
+      }
+    }
+    if( !Uploader.Flush() ) {
+      return false;
+    }
+
+    // Blits are submitted to the same queue, after the faces are uploaded
+    if( !BeginCommandBufferRecordingOperation( FramesResources.front().CommandBuffer, VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT, nullptr ) ) {
+      return false;
+    }
+    if( !GenerateMipmapsWithBlits( PhysicalDevice, FramesResources.front().CommandBuffer, *CubemapImage, VK_FORMAT_R8G8B8A8_UNORM, { 1024, 1024, 1 },
+      cubemap_mipmap_levels_count, 6, VK_IMAGE_ASPECT_COLOR_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_ACCESS_TRANSFER_WRITE_BIT,
+      VK_PIPELINE_STAGE_TRANSFER_BIT, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_ACCESS_SHADER_READ_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT ) ) {
+      return false;
+    }
+    if( !EndCommandBufferRecordingOperation( FramesResources.front().CommandBuffer ) ) {
+      return false;
+    }
+    if( !SubmitCommandBuffersToQueue( GraphicsQueue.Handle, {}, { FramesResources.front().CommandBuffer }, {}, VK_NULL_HANDLE ) ) {
+      return false;
+    }
+    if( !WaitUntilAllCommandsSubmittedToQueueAreFinished( GraphicsQueue.Handle ) ) {
+      return false;
     }
 
     // Descriptor set
@@ -791,6 +828,11 @@ std::vector<VkSubpassDependency> subpass_dependencies = {
       if( UpdateUniformBuffer ) {
         UpdateUniformBuffer = false;
 
+        // Matrices written into the staging buffer since the previous frame are flushed with a single call
+        if( !MappedMemory.FlushDirtyRanges() ) {
+          return false;
+        }
+
         BufferTransition pre_transfer_transition = {
           *UniformBuffer,               // VkBuffer         Buffer
           VK_ACCESS_UNIFORM_READ_BIT,   // VkAccessFlags    CurrentAccess
@@ -930,10 +972,22 @@ std::vector<VkSubpassDependency> subpass_dependencies = {
       return false;
     }
 
+    // Previous frame is finished, so command pools of the current frame can be reset
+    if( !FrameCommandPools.Reset( frame_index ) ) {
+      return false;
+    }
+    VkCommandBuffer command_buffer;
+    if( !FrameCommandPools.AllocateCommandBuffer( 0, frame_index, VK_COMMAND_BUFFER_LEVEL_PRIMARY, command_buffer ) ) {
+      return false;
+    }
+
     InitVkDestroyer( LogicalDevice, current_frame.Framebuffer );
 
-    uint32_t image_index;
-    if( !AcquireSwapchainImage( *LogicalDevice, *Swapchain.Handle, *current_frame.ImageAcquiredSemaphore, VK_NULL_HANDLE, image_index ) ) {
+    // In a headless mode there is no swapchain, so offscreen images are rendered in turn and nothing is presented
+    bool offscreen = !Swapchain.Handle;
+    uint32_t image_index = frame_index % static_cast<uint32_t>(Swapchain.ImageViewsRaw.size());
+    if( !offscreen &&
+        !AcquireSwapchainImage( *LogicalDevice, *Swapchain.Handle, *current_frame.ImageAcquiredSemaphore, VK_NULL_HANDLE, image_index ) ) {
       return false;
     }
 
@@ -942,17 +996,22 @@ std::vector<VkSubpassDependency> subpass_dependencies = {
       return false;
     }
 
-    if( !prepare_frame( current_frame.CommandBuffer, image_index, *current_frame.Framebuffer ) ) {
+    if( !prepare_frame( command_buffer, image_index, *current_frame.Framebuffer ) ) {
       return false;
     }
 
+    if( offscreen ) {
+      frame_index = (frame_index + 1) % FramesResources.size();
+      return SubmitCommandBuffersToQueue( GraphicsQueue.Handle, {}, { command_buffer }, {}, *SceneFence );
+    }
+
     std::vector<WaitSemaphoreInfo> wait_semaphore_infos = {
       {
         *current_frame.ImageAcquiredSemaphore,          // VkSemaphore            Semaphore
         VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT   // VkPipelineStageFlags   WaitingStage
       }
     };
-    if( !SubmitCommandBuffersToQueue( GraphicsQueue.Handle, wait_semaphore_infos, { current_frame.CommandBuffer },
+    if( !SubmitCommandBuffersToQueue( GraphicsQueue.Handle, wait_semaphore_infos, { command_buffer },
     { *current_frame.ReadyToPresentSemaphore }, *SceneFence ) ) {
       return false;
     }
@@ -983,15 +1042,15 @@ std::vector<VkSubpassDependency> subpass_dependencies = {
 
       Matrix4x4 view_matrix = Camera.GetMatrix();
 
-      if( !MapUpdateAndUnmapHostVisibleMemory( *LogicalDevice, *StagingBufferMemory, 0, sizeof( view_matrix[0] ) * view_matrix.size(), &view_matrix[0], true, nullptr ) ) {
+      if( !MappedMemory.Write( *StagingBufferMemory, 0, sizeof( view_matrix[0] ) * view_matrix.size(), &view_matrix[0] ) ) {
         return false;
       }
 
       Matrix4x4 perspective_matrix = PreparePerspectiveProjectionMatrix( static_cast<float>(Swapchain.Size.width) / static_cast<float>(Swapchain.Size.height),
         50.0f, 0.5f, 10.0f );
 
-      if( !MapUpdateAndUnmapHostVisibleMemory( *LogicalDevice, *StagingBufferMemory, sizeof( view_matrix[0] ) * view_matrix.size(),
-        sizeof( perspective_matrix[0] ) * perspective_matrix.size(), &perspective_matrix[0], true, nullptr ) ) {
+      if( !MappedMemory.Write( *StagingBufferMemory, sizeof( view_matrix[0] ) * view_matrix.size(),
+        sizeof( perspective_matrix[0] ) * perspective_matrix.size(), &perspective_matrix[0] ) ) {
         return false;
       }
     }
@@ -999,6 +1058,10 @@ std::vector<VkSubpassDependency> subpass_dependencies = {
   }
 
   virtual bool Resize() override {
+    // Scene image is recreated and the postprocess descriptor set referencing it is updated in place,
+    // so the frames in flight, which still render into and read from the image, must finish first
+    WaitForAllSubmittedCommandsToBeFinished( *LogicalDevice );
+
     if( !CreateSwapchain() ) {
       return false;
     }
@@ -50,6 +50,12 @@ class Sample : public VulkanCookbookSampleBase {
   VkCommandBuffer             CommandBuffer;
 
   virtual bool Initialize( WindowParameters window_parameters ) override {
+    // This sample creates a swapchain for a window, which doesn't exist in a headless mode
+    if( Headless ) {
+      std::cout << "Swapchain can't be created in a headless mode." << std::endl;
+      return false;
+    }
+
     // Instance creation
     if( !ConnectWithVulkanLoaderLibrary( VulkanLibrary ) ) {
       return false;
@@ -308,8 +308,11 @@ class Sample : public VulkanCookbookSample {
       return false;
     }
 
-    uint32_t image_index;
-    if( !AcquireSwapchainImage( *LogicalDevice, *Swapchain.Handle, *ImageAcquiredSemaphore, VK_NULL_HANDLE, image_index ) ) {
+    // In a headless mode there is no swapchain, so the first offscreen image is rendered and nothing is presented
+    bool offscreen = !Swapchain.Handle;
+    uint32_t image_index = 0;
+    if( !offscreen &&
+        !AcquireSwapchainImage( *LogicalDevice, *Swapchain.Handle, *ImageAcquiredSemaphore, VK_NULL_HANDLE, image_index ) ) {
       return false;
     }
 
@@ -386,6 +389,10 @@ class Sample : public VulkanCookbookSample {
       return false;
     }
 
+    if( offscreen ) {
+      return SubmitCommandBuffersToQueue( GraphicsQueue.Handle, {}, { CommandBuffer }, {}, *DrawingFence );
+    }
+
     WaitSemaphoreInfo wait_semaphore_info = {
       *ImageAcquiredSemaphore,            // VkSemaphore            Semaphore
       VK_PIPELINE_STAGE_ALL_COMMANDS_BIT  // VkPipelineStageFlags   WaitingStage
@@ -55,36 +55,62 @@ class Sample : public VulkanCookbookSample {
       return false;
     }
 
+    // Staging ring holds the uncompressed 1024x768 RGBA texture with mipmaps, so it is uploaded with one submission
+    if( !Uploader.Initialize( PhysicalDevice, *LogicalDevice, GraphicsQueue.Handle, GraphicsQueue.FamilyIndex, 8 * 1024 * 1024 ) ) {
+      return false;
+    }
+
     // Combined image sampler
-    int width = 1;
-    int height = 1;
+    // Block-compressed texture is preferred; uncompressed data is used when the device doesn't support BC formats
+    VkFormat format = VK_FORMAT_R8G8B8A8_UNORM;
     std::vector<unsigned char> image_data;
-    if( !LoadTextureDataFromFile( "Data/Textures/sunset.jpg", 4, image_data, &width, &height ) ) {
+    std::vector<MipmapLevel> mipmap_levels;
+    TextureContainerData texture;
+    VkPhysicalDeviceFeatures device_features;
+    VkPhysicalDeviceProperties device_properties;
+    GetFeaturesAndPropertiesOfPhysicalDevice( PhysicalDevice, device_features, device_properties );
+    if( EnabledDeviceFeatures.textureCompressionBC &&
+        LoadTextureDataFromContainerFile( "Data/Textures/sunset.dds", texture, device_properties.limits.maxImageArrayLayers ) ) {
+      // As in the uncompressed path, sRGB-encoded values are sampled without conversion
+      format = (VK_FORMAT_BC1_RGBA_SRGB_BLOCK == texture.Format) ? VK_FORMAT_BC1_RGBA_UNORM_BLOCK : texture.Format;
+      image_data = std::move( texture.Data );
+      for( auto & subresource : texture.Subresources ) {
+        mipmap_levels.push_back( { subresource.Size.width, subresource.Size.height, subresource.Offset, subresource.DataSize } );
+      }
+    } else if( !LoadTextureDataFromFile( "Data/Textures/sunset.jpg", 4, true, image_data, mipmap_levels ) ) {
       return false;
     }
+    uint32_t width = mipmap_levels[0].Width;
+    uint32_t height = mipmap_levels[0].Height;
 
     InitVkDestroyer( LogicalDevice, Sampler );
     InitVkDestroyer( LogicalDevice, Image );
     InitVkDestroyer( LogicalDevice, ImageMemory );
     InitVkDestroyer( LogicalDevice, ImageView );
-    if( !CreateCombinedImageSampler( PhysicalDevice, *LogicalDevice, VK_IMAGE_TYPE_2D, VK_FORMAT_R8G8B8A8_UNORM, { (uint32_t)width, (uint32_t)height, 1 },
-      1, 1, VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT, false, VK_IMAGE_VIEW_TYPE_2D, VK_IMAGE_ASPECT_COLOR_BIT, VK_FILTER_LINEAR,
-      VK_FILTER_LINEAR, VK_SAMPLER_MIPMAP_MODE_NEAREST, VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
-      VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, 0.0f, false, 1.0f, false, VK_COMPARE_OP_ALWAYS, 0.0f, 1.0f, VK_BORDER_COLOR_FLOAT_OPAQUE_BLACK,
+    if( !CreateCombinedImageSampler( PhysicalDevice, *LogicalDevice, VK_IMAGE_TYPE_2D, format, { width, height, 1 },
+      static_cast<uint32_t>(mipmap_levels.size()), 1, VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT, false, VK_IMAGE_VIEW_TYPE_2D,
+      VK_IMAGE_ASPECT_COLOR_BIT, VK_FILTER_LINEAR, VK_FILTER_LINEAR, VK_SAMPLER_MIPMAP_MODE_LINEAR, VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+      VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, 0.0f, false, 1.0f, false, VK_COMPARE_OP_ALWAYS, 0.0f,
+      static_cast<float>(mipmap_levels.size()), VK_BORDER_COLOR_FLOAT_OPAQUE_BLACK,
       false, *Sampler, *Image, *ImageMemory, *ImageView ) ) {
       return false;
     }
 
-    VkImageSubresourceLayers image_subresource_layer = {
-      VK_IMAGE_ASPECT_COLOR_BIT,    // VkImageAspectFlags     aspectMask
-      0,                            // uint32_t               mipLevel
-      0,                            // uint32_t               baseArrayLayer
-      1                             // uint32_t               layerCount
-    };
-    if( !UseStagingBufferToUpdateImageWithDeviceLocalMemoryBound( PhysicalDevice, *LogicalDevice, static_cast<VkDeviceSize>(image_data.size()),
-      &image_data[0], *Image, image_subresource_layer, { 0, 0, 0 }, { (uint32_t)width, (uint32_t)height, 1 }, VK_IMAGE_LAYOUT_UNDEFINED,
-      VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 0, VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_ASPECT_COLOR_BIT, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
-      VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, GraphicsQueue.Handle, FramesResources.front().CommandBuffer, {} ) ) {
+    // All mipmap levels are copied with one command and one submission
+    for( size_t level = 0; level < mipmap_levels.size(); ++level ) {
+      VkImageSubresourceLayers image_subresource_layer = {
+        VK_IMAGE_ASPECT_COLOR_BIT,        // VkImageAspectFlags     aspectMask
+        static_cast<uint32_t>(level),     // uint32_t               mipLevel
+        0,                                // uint32_t               baseArrayLayer
+        1                                 // uint32_t               layerCount
+      };
+      if( !Uploader.UpdateImage( mipmap_levels[level].DataSize, &image_data[mipmap_levels[level].Offset], *Image, image_subresource_layer, { 0, 0, 0 },
+        { mipmap_levels[level].Width, mipmap_levels[level].Height, 1 }, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 0,
+        VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_ASPECT_COLOR_BIT, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT ) ) {
+        return false;
+      }
+    }
+    if( !Uploader.Flush() ) {
       return false;
     }
 
@@ -433,7 +459,7 @@ class Sample : public VulkanCookbookSample {
     };
 
     return IncreasePerformanceThroughIncreasingTheNumberOfSeparatelyRenderedFrames( *LogicalDevice, GraphicsQueue.Handle, PresentQueue.Handle,
-      *Swapchain.Handle, Swapchain.Size, Swapchain.ImageViewsRaw, *RenderPass, {}, prepare_frame, FramesResources );
+      *Swapchain.Handle, Swapchain.Size, Swapchain.ImageViewsRaw, *RenderPass, {}, prepare_frame, FramesResources, Framebuffers, FramePacing, FrameCommandPools, TransientDescriptorSets );
   }
 
   virtual bool Resize() override {
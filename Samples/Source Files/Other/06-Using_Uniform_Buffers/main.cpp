@@ -42,8 +42,6 @@ class Sample : public VulkanCookbookSample {
   VkDestroyer(VkDeviceMemory)         UniformBufferMemory;
 
   VkDestroyer(VkDescriptorSetLayout)  DescriptorSetLayout;
-  VkDestroyer(VkDescriptorPool)       DescriptorPool;
-  std::vector<VkDescriptorSet>        DescriptorSets;
 
   VkDestroyer(VkRenderPass)           RenderPass;
   VkDestroyer(VkPipelineLayout)       PipelineLayout;
@@ -66,7 +64,7 @@ class Sample : public VulkanCookbookSample {
       return false;
     }
 
-    // Descriptor set with uniform buffer
+    // Descriptor set with uniform buffer is allocated for each frame from per-frame pools
     VkDescriptorSetLayoutBinding descriptor_set_layout_binding = {
       0,                                          // uint32_t             binding
       VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,          // VkDescriptorType     descriptorType
@@ -79,35 +77,10 @@ class Sample : public VulkanCookbookSample {
       return false;
     }
 
-    VkDescriptorPoolSize descriptor_pool_size = {
-      VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,          // VkDescriptorType     type
-      1                                           // uint32_t             descriptorCount
-    };
-    InitVkDestroyer( LogicalDevice, DescriptorPool );
-    if( !CreateDescriptorPool( *LogicalDevice, false, 1, { descriptor_pool_size }, *DescriptorPool ) ) {
+    if( !TransientDescriptorSets.RegisterLayout( *DescriptorSetLayout, { descriptor_set_layout_binding } ) ) {
       return false;
     }
 
-    if( !AllocateDescriptorSets( *LogicalDevice, *DescriptorPool, { *DescriptorSetLayout }, DescriptorSets ) ) {
-      return false;
-    }
-
-    BufferDescriptorInfo buffer_descriptor_update = {
-      DescriptorSets[0],                          // VkDescriptorSet                      TargetDescriptorSet
-      0,                                          // uint32_t                             TargetDescriptorBinding
-      0,                                          // uint32_t                             TargetArrayElement
-      VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,          // VkDescriptorType                     TargetDescriptorType
-      {                                           // std::vector<VkDescriptorBufferInfo>  BufferInfos
-        {
-          *UniformBuffer,                           // VkBuffer                             buffer
-          0,                                        // VkDeviceSize                         offset
-          VK_WHOLE_SIZE                             // VkDeviceSize                         range
-        }
-      }
-    };
-
-    UpdateDescriptorSets( *LogicalDevice, {}, { buffer_descriptor_update }, {}, {} );
-
     // Render pass
     std::vector<VkAttachmentDescription> attachment_descriptions = {
       {
@@ -329,6 +302,28 @@ class Sample : public VulkanCookbookSample {
 
   virtual bool Draw() override {
     auto prepare_frame = [&]( VkCommandBuffer command_buffer, uint32_t swapchain_image_index, VkFramebuffer framebuffer ) {
+      // Descriptor set is valid only until the frame's pools are reset, when the frame's resources are used again
+      VkDescriptorSet descriptor_set;
+      if( !TransientDescriptorSets.Allocate( *DescriptorSetLayout, descriptor_set ) ) {
+        return false;
+      }
+
+      BufferDescriptorInfo buffer_descriptor_update = {
+        descriptor_set,                             // VkDescriptorSet                      TargetDescriptorSet
+        0,                                          // uint32_t                             TargetDescriptorBinding
+        0,                                          // uint32_t                             TargetArrayElement
+        VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,          // VkDescriptorType                     TargetDescriptorType
+        {                                           // std::vector<VkDescriptorBufferInfo>  BufferInfos
+          {
+            *UniformBuffer,                           // VkBuffer                             buffer
+            0,                                        // VkDeviceSize                         offset
+            VK_WHOLE_SIZE                             // VkDeviceSize                         range
+          }
+        }
+      };
+
+      UpdateDescriptorSets( *LogicalDevice, {}, { buffer_descriptor_update }, {}, {} );
+
       if( !BeginCommandBufferRecordingOperation( command_buffer, VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT, nullptr ) ) {
         return false;
       }
@@ -373,7 +368,7 @@ class Sample : public VulkanCookbookSample {
       };
       SetScissorStateDynamically( command_buffer, 0, { scissor } );
 
-      BindDescriptorSets( command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, *PipelineLayout, 0, DescriptorSets, {} );
+      BindDescriptorSets( command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, *PipelineLayout, 0, { descriptor_set }, {} );
 
       BindVertexBuffers( command_buffer, 0, { { *VertexBuffer, 0 } } );
 
@@ -404,10 +399,14 @@ class Sample : public VulkanCookbookSample {
     };
 
     return IncreasePerformanceThroughIncreasingTheNumberOfSeparatelyRenderedFrames( *LogicalDevice, GraphicsQueue.Handle, PresentQueue.Handle,
-      *Swapchain.Handle, Swapchain.Size, Swapchain.ImageViewsRaw, *RenderPass, {}, prepare_frame, FramesResources );
+      *Swapchain.Handle, Swapchain.Size, Swapchain.ImageViewsRaw, *RenderPass, {}, prepare_frame, FramesResources, Framebuffers, FramePacing, FrameCommandPools, TransientDescriptorSets );
   }
 
   virtual bool Resize() override {
+    // Uniform buffer read by the frames in flight is overwritten with a copy recorded into the command
+    // buffer of the first frame resources, which may still be pending
+    WaitForAllSubmittedCommandsToBeFinished( *LogicalDevice );
+
     if( !CreateSwapchain( VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, false ) ) {
       return false;
     }
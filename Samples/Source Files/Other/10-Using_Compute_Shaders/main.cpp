@@ -179,8 +179,11 @@ class Sample : public VulkanCookbookSample {
       return false;
     }
 
-    uint32_t image_index;
-    if( !AcquireSwapchainImage( *LogicalDevice, *Swapchain.Handle, *ImageAcquiredSemaphore, VK_NULL_HANDLE, image_index ) ) {
+    // In a headless mode there is no swapchain, so the first offscreen image is rendered and nothing is presented
+    bool offscreen = !Swapchain.Handle;
+    uint32_t image_index = 0;
+    if( !offscreen &&
+        !AcquireSwapchainImage( *LogicalDevice, *Swapchain.Handle, *ImageAcquiredSemaphore, VK_NULL_HANDLE, image_index ) ) {
       return false;
     }
 
@@ -285,6 +288,10 @@ class Sample : public VulkanCookbookSample {
       return false;
     }
 
+    if( offscreen ) {
+      return SubmitCommandBuffersToQueue( ComputeQueue.Handle, {}, { CommandBuffer }, {}, *DrawingFence );
+    }
+
     WaitSemaphoreInfo wait_semaphore_info = {
       *ImageAcquiredSemaphore,            // VkSemaphore            Semaphore
       VK_PIPELINE_STAGE_ALL_COMMANDS_BIT  // VkPipelineStageFlags   WaitingStage
@@ -304,6 +311,9 @@ class Sample : public VulkanCookbookSample {
   }
 
   virtual bool Resize() override {
+    // Storage image written by the frames in flight is destroyed and its descriptor set is updated in place
+    WaitForAllSubmittedCommandsToBeFinished( *LogicalDevice );
+
     if( !CreateSwapchain( VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT, false ) ) {
       return false;
     }
@@ -494,7 +494,7 @@ class Sample : public VulkanCookbookSample {
     };
 
     return IncreasePerformanceThroughIncreasingTheNumberOfSeparatelyRenderedFrames( *LogicalDevice, GraphicsQueue.Handle, PresentQueue.Handle,
-      *Swapchain.Handle, Swapchain.Size, Swapchain.ImageViewsRaw, *RenderPass, {}, prepare_frame, FramesResources );
+      *Swapchain.Handle, Swapchain.Size, Swapchain.ImageViewsRaw, *RenderPass, {}, prepare_frame, FramesResources, Framebuffers, FramePacing, FrameCommandPools, TransientDescriptorSets );
   }
 
   bool UpdateUniformBuffer() {
@@ -520,6 +520,10 @@ class Sample : public VulkanCookbookSample {
   }
 
   virtual bool Resize() override {
+    // Uniform buffer with a projection matrix depending on the window size is overwritten, while the frames
+    // in flight still read it
+    WaitForAllSubmittedCommandsToBeFinished( *LogicalDevice );
+
     if( !CreateSwapchain( VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, false ) ) {
       return false;
     }
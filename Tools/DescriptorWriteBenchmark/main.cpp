@@ -0,0 +1,185 @@
+// MIT License
+//
+// Copyright( c ) 2017 Packt
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// DescriptorWriteBenchmark
+
+#include <chrono>
+#include <cstdlib>
+#include <map>
+#include <new>
+#include <tuple>
+#include "05 Descriptor Sets/13 Updating descriptor sets.h"
+#include "05 Descriptor Sets/22 Batching descriptor set updates.h"
+
+// Micro-benchmark comparing UpdateDescriptorSets() with a DescriptorWriteBatch:
+//
+//   DescriptorWriteBenchmark [<writes count> [<iterations count>]]
+//
+// Each iteration writes a uniform buffer and a combined image sampler descriptors into 5000 sets and
+// rewrites every fourth set's buffer descriptor again. No device is needed - vkUpdateDescriptorSets()
+// is replaced with a function recording the final state of descriptors, which is compared between both methods.
+
+using namespace VulkanCookbook;
+
+namespace {
+
+  uint64_t HeapAllocationsCount = 0;
+
+  typedef std::map<std::tuple<VkDescriptorSet, uint32_t, uint32_t>, uint64_t> DescriptorsState;
+
+  DescriptorsState * RecordedState = nullptr;
+  uint64_t           UpdateCallsCount = 0;
+  uint64_t           SubmittedWritesCount = 0;
+
+  VKAPI_ATTR void VKAPI_CALL RecordDescriptorSetsUpdate( VkDevice                     /*device*/,
+                                                         uint32_t                     descriptor_write_count,
+                                                         VkWriteDescriptorSet const * descriptor_writes,
+                                                         uint32_t                     /*descriptor_copy_count*/,
+                                                         VkCopyDescriptorSet const  * /*descriptor_copies*/ ) {
+    ++UpdateCallsCount;
+    SubmittedWritesCount += descriptor_write_count;
+    if( nullptr == RecordedState ) {
+      return;
+    }
+    for( uint32_t i = 0; i < descriptor_write_count; ++i ) {
+      auto & write = descriptor_writes[i];
+      for( uint32_t j = 0; j < write.descriptorCount; ++j ) {
+        uint64_t value = (nullptr != write.pBufferInfo) ? write.pBufferInfo[j].offset : reinterpret_cast<uint64_t>(write.pImageInfo[j].imageView);
+        (*RecordedState)[std::make_tuple( write.dstSet, write.dstBinding, write.dstArrayElement + j )] = value;
+      }
+    }
+  }
+
+  VkDescriptorSet Set( uint32_t index ) {
+    return reinterpret_cast<VkDescriptorSet>(static_cast<uint64_t>(0x1000 + (index / 2) % 5000));
+  }
+
+  void UpdateWithVectors( uint32_t writes_count,
+                          uint32_t iteration ) {
+    std::vector<ImageDescriptorInfo> image_descriptor_infos;
+    std::vector<BufferDescriptorInfo> buffer_descriptor_infos;
+    for( uint32_t i = 0; i < writes_count; ++i ) {
+      if( 0 == i % 2 ) {
+        buffer_descriptor_infos.push_back( { Set( i ), 0, 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, { { reinterpret_cast<VkBuffer>(0x10), 256 * (i + iteration), 256 } } } );
+      } else {
+        image_descriptor_infos.push_back( { Set( i ), 1, 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, { { reinterpret_cast<VkSampler>(0x20), reinterpret_cast<VkImageView>(static_cast<uint64_t>(0x30 + i + iteration)), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL } } } );
+      }
+    }
+    for( uint32_t i = 0; i < writes_count / 8; ++i ) {
+      buffer_descriptor_infos.push_back( { Set( 8 * i ), 0, 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, { { reinterpret_cast<VkBuffer>(0x10), 7 + i + iteration, 256 } } } );
+    }
+    UpdateDescriptorSets( VK_NULL_HANDLE, image_descriptor_infos, buffer_descriptor_infos, {}, {} );
+  }
+
+  void UpdateWithBatch( DescriptorWriteBatch & batch,
+                        uint32_t               writes_count,
+                        uint32_t               iteration ) {
+    for( uint32_t i = 0; i < writes_count; ++i ) {
+      if( 0 == i % 2 ) {
+        batch.WriteBuffer( Set( i ), 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, reinterpret_cast<VkBuffer>(0x10), 256 * (i + iteration), 256 );
+      } else {
+        batch.WriteImage( Set( i ), 1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, reinterpret_cast<VkSampler>(0x20), reinterpret_cast<VkImageView>(static_cast<uint64_t>(0x30 + i + iteration)), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL );
+      }
+    }
+    for( uint32_t i = 0; i < writes_count / 8; ++i ) {
+      batch.WriteBuffer( Set( 8 * i ), 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, reinterpret_cast<VkBuffer>(0x10), 7 + i + iteration, 256 );
+    }
+    batch.Flush( VK_NULL_HANDLE );
+  }
+
+  template<typename Function>
+  void Measure( char const * name,
+                uint32_t     iterations_count,
+                Function     function ) {
+    HeapAllocationsCount = 0;
+    UpdateCallsCount = 0;
+    SubmittedWritesCount = 0;
+    auto start = std::chrono::steady_clock::now();
+    for( uint32_t i = 0; i < iterations_count; ++i ) {
+      function( i );
+    }
+    std::chrono::duration<double, std::micro> duration = std::chrono::steady_clock::now() - start;
+
+    std::cout << name << ": " << duration.count() / iterations_count << " us"
+              << ", heap allocations: " << HeapAllocationsCount / iterations_count
+              << ", vkUpdateDescriptorSets() calls: " << UpdateCallsCount / iterations_count
+              << ", submitted writes: " << SubmittedWritesCount / iterations_count << std::endl;
+  }
+
+} // namespace
+
+void * operator new( size_t size ) {
+  ++HeapAllocationsCount;
+  if( void * memory = std::malloc( size > 0 ? size : 1 ) ) {
+    return memory;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete( void * memory ) noexcept {
+  std::free( memory );
+}
+
+int main( int argc, char ** argv ) {
+  uint32_t writes_count = (argc > 1) ? static_cast<uint32_t>(std::atoi( argv[1] )) : 10000;
+  uint32_t iterations_count = (argc > 2) ? static_cast<uint32_t>(std::atoi( argv[2] )) : 200;
+  if( (0 == writes_count) ||
+      (0 == iterations_count) ) {
+    std::cout << "Usage: DescriptorWriteBenchmark [<writes count> [<iterations count>]]" << std::endl;
+    return -1;
+  }
+
+  vkUpdateDescriptorSets = RecordDescriptorSetsUpdate;
+  DescriptorWriteBatch batch;
+
+  // Both methods must leave descriptors in the same state
+  DescriptorsState vectors_state;
+  DescriptorsState batch_state;
+  RecordedState = &vectors_state;
+  UpdateWithVectors( writes_count, 0 );
+  RecordedState = &batch_state;
+  UpdateWithBatch( batch, writes_count, 0 );
+  RecordedState = nullptr;
+  if( vectors_state != batch_state ) {
+    std::cout << "Descriptors updated through a batch differ from the ones updated through vectors!" << std::endl;
+    return -1;
+  }
+
+  std::cout << writes_count + writes_count / 8 << " writes into " << vectors_state.size() << " descriptors" << std::endl;
+  Measure( "UpdateDescriptorSets()", iterations_count, [&]( uint32_t iteration ) {
+    UpdateWithVectors( writes_count, iteration );
+  } );
+  Measure( "DescriptorWriteBatch  ", iterations_count, [&]( uint32_t iteration ) {
+    UpdateWithBatch( batch, writes_count, iteration );
+  } );
+
+  DescriptorWriteBatchStatistics statistics = batch.GetStatistics();
+  std::cout << "Writes replaced by later ones: " << statistics.DiscardedWriteCount << " of " << statistics.WriteCount << std::endl;
+  return 0;
+}
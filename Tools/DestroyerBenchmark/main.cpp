@@ -0,0 +1,188 @@
+// MIT License
+//
+// Copyright( c ) 2017 Packt
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// DestroyerBenchmark
+
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include "Common.h"
+
+// Micro-benchmark comparing VkDestroyer<> with its previous implementation, which stored a deleter in a std::function<>:
+//
+//   DestroyerBenchmark [<objects count> [<iterations count>]]
+//
+// Each iteration creates destroyers for the given number of buffers and image views, moves them into a vector
+// and destroys them. No device is needed - deleters are replaced with functions counting destroyed objects.
+
+using namespace VulkanCookbook;
+
+namespace {
+
+  // Previous implementation of the VkDestroyer<> class, kept for comparison
+
+  template<class VkTypeWrapper>
+  class FunctionVkDestroyer {
+  public:
+    FunctionVkDestroyer() :
+      DestroyerFunction( nullptr ) {
+      Object.Handle = VK_NULL_HANDLE;
+    }
+
+    FunctionVkDestroyer( std::function<void( VkTypeWrapper )> destroyer_function ) :
+      DestroyerFunction( destroyer_function ) {
+      Object.Handle = VK_NULL_HANDLE;
+    }
+
+    ~FunctionVkDestroyer() {
+      if( DestroyerFunction && Object.Handle ) {
+        DestroyerFunction( Object );
+      }
+    }
+
+    FunctionVkDestroyer( FunctionVkDestroyer<VkTypeWrapper> && other ) :
+      DestroyerFunction( other.DestroyerFunction ) {
+      Object.Handle = other.Object.Handle;
+      other.Object.Handle = VK_NULL_HANDLE;
+      other.DestroyerFunction = nullptr;
+    }
+
+    FunctionVkDestroyer& operator=( FunctionVkDestroyer<VkTypeWrapper> && other ) {
+      if( this != &other ) {
+        VkTypeWrapper object = Object;
+        std::function<void( VkTypeWrapper )> destroyer_function = DestroyerFunction;
+
+        Object.Handle = other.Object.Handle;
+        DestroyerFunction = other.DestroyerFunction;
+
+        other.Object.Handle = object.Handle;
+        other.DestroyerFunction = destroyer_function;
+      }
+      return *this;
+    }
+
+    decltype(VkTypeWrapper::Handle) & operator*() {
+      return Object.Handle;
+    }
+
+  private:
+    VkTypeWrapper Object;
+    std::function<void( VkTypeWrapper )> DestroyerFunction;
+  };
+
+  template<class VkType>
+  void InitDestroyer( VkDevice                      device,
+                      FunctionVkDestroyer<VkType> & destroyer ) {
+    destroyer = FunctionVkDestroyer<VkType>( std::bind( DestroyVulkanObject<VkDevice, VkType>, device, std::placeholders::_1 ) );
+  }
+
+  template<class VkType>
+  void InitDestroyer( VkDevice              device,
+                      VkDestroyer<VkType> & destroyer ) {
+    InitVkDestroyer( device, destroyer );
+  }
+
+  uint64_t HeapAllocationsCount = 0;
+  uint64_t DestroyedObjectsCount = 0;
+
+  VKAPI_ATTR void VKAPI_CALL CountDestroyedBuffer( VkDevice, VkBuffer, VkAllocationCallbacks const * ) {
+    ++DestroyedObjectsCount;
+  }
+
+  VKAPI_ATTR void VKAPI_CALL CountDestroyedImageView( VkDevice, VkImageView, VkAllocationCallbacks const * ) {
+    ++DestroyedObjectsCount;
+  }
+
+  template<template<class> class Destroyer>
+  void Measure( char const * name,
+                uint32_t     objects_count,
+                uint32_t     iterations_count ) {
+    VkDevice device = reinterpret_cast<VkDevice>(static_cast<uintptr_t>(0x10));
+    std::vector<Destroyer<VkBufferWrapper>> buffers;
+    std::vector<Destroyer<VkImageViewWrapper>> image_views;
+
+    HeapAllocationsCount = 0;
+    DestroyedObjectsCount = 0;
+    auto start = std::chrono::steady_clock::now();
+    for( uint32_t iteration = 0; iteration < iterations_count; ++iteration ) {
+      buffers.reserve( objects_count );
+      image_views.reserve( objects_count );
+      for( uint32_t i = 0; i < objects_count; ++i ) {
+        Destroyer<VkBufferWrapper> buffer;
+        InitDestroyer( device, buffer );
+        *buffer = reinterpret_cast<VkBuffer>(static_cast<uintptr_t>(0x1000 + i));
+        buffers.push_back( std::move( buffer ) );
+
+        Destroyer<VkImageViewWrapper> image_view;
+        InitDestroyer( device, image_view );
+        *image_view = reinterpret_cast<VkImageView>(static_cast<uintptr_t>(0x1000 + i));
+        image_views.push_back( std::move( image_view ) );
+      }
+      buffers.clear();
+      image_views.clear();
+    }
+    std::chrono::duration<double, std::nano> duration = std::chrono::steady_clock::now() - start;
+    uint64_t objects_total = 2ull * objects_count * iterations_count;
+
+    std::cout << name << ": " << sizeof( Destroyer<VkBufferWrapper> ) << " bytes per object"
+              << ", " << duration.count() / objects_total << " ns per object (create, move and destroy)"
+              << ", heap allocations per object: " << static_cast<double>(HeapAllocationsCount) / objects_total
+              << ", destroyed objects: " << DestroyedObjectsCount << " of " << objects_total << std::endl;
+  }
+
+} // namespace
+
+void * operator new( size_t size ) {
+  ++HeapAllocationsCount;
+  if( void * memory = std::malloc( size > 0 ? size : 1 ) ) {
+    return memory;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete( void * memory ) noexcept {
+  std::free( memory );
+}
+
+int main( int argc, char ** argv ) {
+  uint32_t objects_count = (argc > 1) ? static_cast<uint32_t>(std::atoi( argv[1] )) : 50000;
+  uint32_t iterations_count = (argc > 2) ? static_cast<uint32_t>(std::atoi( argv[2] )) : 20;
+  if( (0 == objects_count) ||
+      (0 == iterations_count) ) {
+    std::cout << "Usage: DestroyerBenchmark [<objects count> [<iterations count>]]" << std::endl;
+    return -1;
+  }
+
+  vkDestroyBuffer = CountDestroyedBuffer;
+  vkDestroyImageView = CountDestroyedImageView;
+
+  Measure<FunctionVkDestroyer>( "std::function<> deleter", objects_count, iterations_count );
+  Measure<VkDestroyer>(         "Compile-time deleter   ", objects_count, iterations_count );
+  return 0;
+}
@@ -0,0 +1,305 @@
+// MIT License
+//
+// Copyright( c ) 2017 Packt
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// MemoryAllocatorTest
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include "Common.h"
+#include "04 Resources and Memory/22 Sub-allocating memory objects from larger memory blocks.h"
+
+// Checks the memory sub-allocator against a mock vkAllocateMemory() and reports fragmentation and throughput:
+//
+//   MemoryAllocatorTest [<operations count> [<seed>]]
+//
+// No device is needed - memory objects are only handles counted by the stubs. Returns a non-zero exit code
+// when any of the checks fails.
+
+using namespace VulkanCookbook;
+
+namespace {
+
+  VkDeviceSize const BLOCK_SIZE = 1024 * 1024;
+  VkDeviceSize const BUFFER_IMAGE_GRANULARITY = 1024;
+
+  uint64_t NextMemoryObject = 0x1000;
+  uint32_t AllocatedMemoryObjects = 0;
+  uint32_t LiveMemoryObjects = 0;
+  uint32_t FailedChecks = 0;
+
+  VKAPI_ATTR void VKAPI_CALL GetPhysicalDevicePropertiesStub( VkPhysicalDevice, VkPhysicalDeviceProperties * properties ) {
+    *properties = {};
+    properties->limits.bufferImageGranularity = BUFFER_IMAGE_GRANULARITY;
+  }
+
+  VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceMemoryPropertiesStub( VkPhysicalDevice, VkPhysicalDeviceMemoryProperties * properties ) {
+    *properties = {};
+    properties->memoryTypeCount = 2;
+    properties->memoryTypes[0].propertyFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    properties->memoryTypes[1].propertyFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    properties->memoryHeapCount = 1;
+    properties->memoryHeaps[0].size = 1024 * BLOCK_SIZE;
+  }
+
+  VKAPI_ATTR VkResult VKAPI_CALL AllocateMemoryStub( VkDevice, VkMemoryAllocateInfo const *, VkAllocationCallbacks const *, VkDeviceMemory * memory ) {
+    *memory = reinterpret_cast<VkDeviceMemory>(static_cast<uintptr_t>(NextMemoryObject++));
+    ++AllocatedMemoryObjects;
+    ++LiveMemoryObjects;
+    return VK_SUCCESS;
+  }
+
+  VKAPI_ATTR void VKAPI_CALL FreeMemoryStub( VkDevice, VkDeviceMemory, VkAllocationCallbacks const * ) {
+    --LiveMemoryObjects;
+  }
+
+  void InstallStubs() {
+    vkGetPhysicalDeviceProperties = GetPhysicalDevicePropertiesStub;
+    vkGetPhysicalDeviceMemoryProperties = GetPhysicalDeviceMemoryPropertiesStub;
+    vkAllocateMemory = AllocateMemoryStub;
+    vkFreeMemory = FreeMemoryStub;
+  }
+
+  void Check( bool         condition,
+              char const * description ) {
+    if( !condition ) {
+      std::cout << "FAILED: " << description << std::endl;
+      ++FailedChecks;
+    }
+  }
+
+  bool Initialize( MemoryAllocator & allocator ) {
+    return allocator.Initialize( reinterpret_cast<VkPhysicalDevice>(1), reinterpret_cast<VkDevice>(1), BLOCK_SIZE );
+  }
+
+  bool Allocate( MemoryAllocator  & allocator,
+                 VkDeviceSize       size,
+                 VkDeviceSize       alignment,
+                 bool               linear,
+                 MemoryAllocation & allocation ) {
+    VkMemoryRequirements memory_requirements = {
+      size,         // VkDeviceSize   size
+      alignment,    // VkDeviceSize   alignment
+      0x3           // uint32_t       memoryTypeBits
+    };
+    return allocator.Allocate( memory_requirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, linear, allocation );
+  }
+
+  bool Overlap( MemoryAllocation const & left,
+                MemoryAllocation const & right ) {
+    return (left.Memory == right.Memory) &&
+           (left.Offset < right.Offset + right.Size) &&
+           (right.Offset < left.Offset + left.Size);
+  }
+
+  void TestSubAllocation() {
+    MemoryAllocator allocator;
+    Check( Initialize( allocator ), "allocator is initialized" );
+
+    uint32_t memory_objects = AllocatedMemoryObjects;
+    std::vector<MemoryAllocation> allocations( 64 );
+    for( auto & allocation : allocations ) {
+      Check( Allocate( allocator, 4096, 256, true, allocation ), "small allocation succeeds" );
+      Check( 0 == allocation.MemoryTypeIndex, "allocation uses a memory type with requested properties" );
+    }
+    Check( 1 == AllocatedMemoryObjects - memory_objects, "small allocations share a single memory block" );
+    for( size_t i = 0; i < allocations.size(); ++i ) {
+      for( size_t j = i + 1; j < allocations.size(); ++j ) {
+        Check( !Overlap( allocations[i], allocations[j] ), "sub-allocations don't overlap" );
+      }
+    }
+
+    MemoryAllocation dedicated;
+    Check( Allocate( allocator, BLOCK_SIZE / 2 + 1, 256, true, dedicated ), "big allocation succeeds" );
+    Check( 2 == AllocatedMemoryObjects - memory_objects, "big allocation gets a dedicated memory object" );
+    uint32_t live_memory_objects = LiveMemoryObjects;
+    allocator.Free( dedicated );
+    Check( live_memory_objects - 1 == LiveMemoryObjects, "dedicated memory object is released immediately" );
+
+    MemoryAllocation image;
+    Check( Allocate( allocator, 4096, 256, false, image ), "non-linear allocation succeeds" );
+    for( auto & allocation : allocations ) {
+      Check( allocation.Memory != image.Memory, "linear and non-linear resources don't share a block" );
+    }
+
+    allocator.Free( image );
+    for( auto & allocation : allocations ) {
+      allocator.Free( allocation );
+    }
+    allocator.Destroy();
+    Check( 0 == LiveMemoryObjects, "all memory objects are released" );
+  }
+
+  void TestAlignment() {
+    MemoryAllocator allocator;
+    Check( Initialize( allocator ), "allocator is initialized" );
+
+    std::vector<MemoryAllocation> allocations;
+    for( VkDeviceSize alignment = 1; alignment <= 65536; alignment *= 2 ) {
+      // Odd sizes leave the end of each allocation unaligned for the next one
+      MemoryAllocation allocation;
+      Check( Allocate( allocator, 3 * alignment + 1, alignment, true, allocation ), "aligned allocation succeeds" );
+      Check( 0 == allocation.Offset % alignment, "offset is a multiple of the alignment" );
+      Check( 3 * alignment + 1 == allocation.Size, "allocation has the requested size" );
+      allocations.push_back( allocation );
+    }
+
+    for( auto & allocation : allocations ) {
+      allocator.Free( allocation );
+    }
+    MemoryAllocatorStatistics statistics = allocator.GetStatistics();
+    Check( 0 == statistics.UsedBytes, "padding is returned to the free list" );
+    Check( statistics.BlockCount == statistics.FreeRangeCount, "free ranges are merged back into whole blocks" );
+  }
+
+  void TestFreeListReuse() {
+    MemoryAllocator allocator;
+    Check( Initialize( allocator ), "allocator is initialized" );
+
+    MemoryAllocation first, second, third;
+    Check( Allocate( allocator, 65536, 256, true, first ), "first allocation succeeds" );
+    Check( Allocate( allocator, 65536, 256, true, second ), "second allocation succeeds" );
+    Check( Allocate( allocator, 65536, 256, true, third ), "third allocation succeeds" );
+    VkDeviceMemory memory = second.Memory;
+    VkDeviceSize offset = second.Offset;
+
+    // A hole left by a freed resource is filled first
+    uint32_t memory_objects = AllocatedMemoryObjects;
+    allocator.Free( second );
+    Check( 2 == allocator.GetStatistics().FreeRangeCount, "freed range is kept in the free list" );
+    Check( Allocate( allocator, 65536, 256, true, second ), "reallocation succeeds" );
+    Check( (memory == second.Memory) && (offset == second.Offset), "freed range is reused" );
+    Check( memory_objects == AllocatedMemoryObjects, "reuse doesn't allocate new memory objects" );
+
+    // Freeing neighbours in any order merges ranges
+    allocator.Free( first );
+    allocator.Free( third );
+    allocator.Free( second );
+    MemoryAllocatorStatistics statistics = allocator.GetStatistics();
+    Check( (1 == statistics.FreeRangeCount) && (BLOCK_SIZE == statistics.LargestFreeRange), "neighbouring free ranges are merged" );
+
+    // Regular blocks are kept for later allocations
+    Check( Allocate( allocator, 65536, 256, true, first ), "allocation after freeing everything succeeds" );
+    Check( memory_objects == AllocatedMemoryObjects, "empty blocks are reused" );
+    allocator.Free( first );
+  }
+
+  void TestRandomOperations( uint32_t operations_count,
+                             uint32_t seed ) {
+    MemoryAllocator allocator;
+    Check( Initialize( allocator ), "allocator is initialized" );
+
+    std::mt19937 generator( seed );
+    std::uniform_int_distribution<uint32_t> size_distribution( 1, 64 * 1024 );
+    std::uniform_int_distribution<uint32_t> alignment_distribution( 0, 12 );
+
+    uint32_t memory_objects = AllocatedMemoryObjects;
+    std::vector<MemoryAllocation> allocations;
+    std::vector<bool> linear;
+    uint32_t allocations_count = 0;
+    uint32_t peak_allocations_count = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for( uint32_t i = 0; i < operations_count; ++i ) {
+      // Slightly more allocations than frees, so the number of live resources grows over time
+      if( allocations.empty() ||
+          (generator() % 100 < 55) ) {
+        MemoryAllocation allocation;
+        bool is_linear = 0 == generator() % 2;
+        if( Allocate( allocator, size_distribution( generator ), VkDeviceSize( 1 ) << alignment_distribution( generator ), is_linear, allocation ) ) {
+          allocations.push_back( allocation );
+          linear.push_back( is_linear );
+          ++allocations_count;
+        }
+      } else {
+        size_t index = generator() % allocations.size();
+        allocator.Free( allocations[index] );
+        allocations[index] = allocations.back();
+        allocations.pop_back();
+        linear[index] = linear.back();
+        linear.pop_back();
+      }
+      if( allocations.size() > peak_allocations_count ) {
+        peak_allocations_count = static_cast<uint32_t>(allocations.size());
+      }
+    }
+    auto duration = std::chrono::steady_clock::now() - start;
+    MemoryAllocatorStatistics run_statistics = allocator.GetStatistics();
+
+    // Overlaps are checked after the measurement, sorted by memory object and offset
+    std::vector<size_t> order( allocations.size() );
+    for( size_t i = 0; i < order.size(); ++i ) {
+      order[i] = i;
+    }
+    std::sort( order.begin(), order.end(), [&]( size_t left, size_t right ) {
+      return (allocations[left].Memory < allocations[right].Memory) ||
+             ((allocations[left].Memory == allocations[right].Memory) && (allocations[left].Offset < allocations[right].Offset));
+    } );
+    for( size_t i = 1; i < order.size(); ++i ) {
+      Check( !Overlap( allocations[order[i - 1]], allocations[order[i]] ), "random sub-allocations don't overlap" );
+      Check( (allocations[order[i - 1]].Memory != allocations[order[i]].Memory) ||
+             (linear[order[i - 1]] == linear[order[i]]), "random linear and non-linear resources don't share a block" );
+    }
+
+    double microseconds = std::chrono::duration<double, std::micro>( duration ).count();
+    std::cout << operations_count << " random operations: " << 1000.0 * microseconds / operations_count << " ns per operation, "
+              << allocations_count << " allocations served by " << AllocatedMemoryObjects - memory_objects << " memory objects" << std::endl;
+    std::cout << "Live allocations: " << allocations.size() << " (peak " << peak_allocations_count << "), blocks: " << run_statistics.BlockCount
+              << ", used: " << 100.0 * run_statistics.UsedBytes / run_statistics.ReservedBytes << "% of " << run_statistics.ReservedBytes / 1024 << " KB, "
+              << "free ranges: " << run_statistics.FreeRangeCount << ", largest free range: " << run_statistics.LargestFreeRange / 1024 << " KB" << std::endl;
+
+    for( auto & allocation : allocations ) {
+      allocator.Free( allocation );
+    }
+    MemoryAllocatorStatistics statistics = allocator.GetStatistics();
+    Check( 0 == statistics.UsedBytes, "all random allocations are freed" );
+    Check( statistics.BlockCount == statistics.FreeRangeCount, "all blocks return to a single free range" );
+  }
+
+} // namespace
+
+int main( int argc, char ** argv ) {
+  uint32_t operations_count = (argc > 1) ? static_cast<uint32_t>(std::atoi( argv[1] )) : 100000;
+  uint32_t seed = (argc > 2) ? static_cast<uint32_t>(std::atoi( argv[2] )) : 1;
+
+  InstallStubs();
+
+  TestSubAllocation();
+  TestAlignment();
+  TestFreeListReuse();
+  TestRandomOperations( operations_count, seed );
+
+  if( 0 < FailedChecks ) {
+    std::cout << FailedChecks << " check(s) failed." << std::endl;
+    return 1;
+  }
+  std::cout << "All checks passed." << std::endl;
+  return 0;
+}
@@ -0,0 +1,240 @@
+// MIT License
+//
+// Copyright( c ) 2017 Packt
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// MipmapGenerationTest
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include "Common.h"
+#include "10 Helper Recipes/12 Generating a mipmap chain on a CPU.h"
+
+// Compares mipmap chains generated on a CPU with scalar references over randomized images:
+//
+//   MipmapGenerationTest [<images count> [<seed>]]
+//
+// 4-component images are filtered with SSE (when available), while images with fewer components always use
+// the scalar path. Each channel of an RGBA image, extracted into a 1-component image, must give exactly the
+// same chain. All chains are also compared with a reference computed in double precision with exact sRGB
+// conversions; they may differ by one code only where the exact value lies half way between two codes.
+// Returns a non-zero exit code when any of the checks fails.
+
+using namespace VulkanCookbook;
+
+namespace {
+
+  double SrgbToLinear( double value ) {
+    return value <= 0.04045 ? value / 12.92 : std::pow( (value + 0.055) / 1.055, 2.4 );
+  }
+
+  double LinearToSrgb( double value ) {
+    return value <= 0.0031308 ? value * 12.92 : 1.055 * std::pow( value, 1.0 / 2.4 ) - 0.055;
+  }
+
+  // Box-filters a level in double precision, clamping the last row and column of odd-sized levels
+
+  std::vector<double> DownsampleLevel( std::vector<double> const & source,
+                                       uint32_t                    source_width,
+                                       uint32_t                    source_height,
+                                       int                         num_components,
+                                       uint32_t                    width,
+                                       uint32_t                    height ) {
+    std::vector<double> destination( static_cast<size_t>(width) * height * num_components );
+    for( uint32_t y = 0; y < height; ++y ) {
+      uint32_t y_0 = std::min( 2 * y, source_height - 1 );
+      uint32_t y_1 = std::min( 2 * y + 1, source_height - 1 );
+      for( uint32_t x = 0; x < width; ++x ) {
+        uint32_t x_0 = std::min( 2 * x, source_width - 1 );
+        uint32_t x_1 = std::min( 2 * x + 1, source_width - 1 );
+        for( int c = 0; c < num_components; ++c ) {
+          destination[(static_cast<size_t>(y) * width + x) * num_components + c] = 0.25 * (
+            source[(static_cast<size_t>(y_0) * source_width + x_0) * num_components + c] +
+            source[(static_cast<size_t>(y_0) * source_width + x_1) * num_components + c] +
+            source[(static_cast<size_t>(y_1) * source_width + x_0) * num_components + c] +
+            source[(static_cast<size_t>(y_1) * source_width + x_1) * num_components + c] );
+        }
+      }
+    }
+    return destination;
+  }
+
+  struct Statistics {
+    uint32_t  Images;
+    uint32_t  Failures;
+    size_t    Texels;
+    size_t    Ties;
+  };
+
+  // Compares a generated chain with the double-precision reference
+
+  void CompareWithReference( std::vector<unsigned char> const & image_data,
+                             uint32_t                           width,
+                             uint32_t                           height,
+                             int                                num_components,
+                             bool                               srgb,
+                             std::vector<unsigned char> const & mipmap_data,
+                             std::vector<MipmapLevel> const   & levels,
+                             Statistics                       & statistics ) {
+    int color_components = (srgb ? (0 == num_components % 2 ? num_components - 1 : num_components) : 0);
+
+    std::vector<double> current( image_data.size() );
+    for( size_t i = 0; i < image_data.size(); ++i ) {
+      double value = image_data[i] / 255.0;
+      current[i] = (static_cast<int>(i % num_components) < color_components ? SrgbToLinear( value ) : value);
+    }
+
+    for( size_t level = 1; level < levels.size(); ++level ) {
+      current = DownsampleLevel( current, levels[level - 1].Width, levels[level - 1].Height, num_components, levels[level].Width, levels[level].Height );
+      for( size_t i = 0; i < current.size(); ++i ) {
+        double value = (static_cast<int>(i % num_components) < color_components ? LinearToSrgb( current[i] ) : current[i]);
+        int expected = static_cast<int>(std::floor( value * 255.0 + 0.5 ));
+        int difference = std::abs( expected - mipmap_data[levels[level].Offset + i] );
+        // Averages of 4 codes are often exactly half way between two codes, so rounding in single precision may go either way
+        bool tie = std::abs( value * 255.0 - std::floor( value * 255.0 ) - 0.5 ) < 1e-3;
+        ++statistics.Texels;
+        if( tie &&
+            (1 == difference) ) {
+          ++statistics.Ties;
+        } else if( 0 < difference ) {
+          std::cout << "FAILED: " << width << "x" << height << "x" << num_components << (srgb ? " sRGB" : "") << " image, level " << level
+                    << ", value " << i << ": " << static_cast<int>(mipmap_data[levels[level].Offset + i]) << " instead of " << expected << std::endl;
+          ++statistics.Failures;
+          return;
+        }
+      }
+    }
+  }
+
+  bool Generate( std::vector<unsigned char> const & image_data,
+                 uint32_t                           width,
+                 uint32_t                           height,
+                 int                                num_components,
+                 bool                               srgb,
+                 std::vector<unsigned char>       & mipmap_data,
+                 std::vector<MipmapLevel>         & levels,
+                 Statistics                       & statistics ) {
+    if( !GenerateMipmapChain( image_data.data(), width, height, num_components, srgb, mipmap_data, levels ) ||
+        (GetMipmapLevelsCount( width, height ) != levels.size()) ||
+        (1 != levels.back().Width) ||
+        (1 != levels.back().Height) ||
+        (levels.back().Offset + levels.back().DataSize != mipmap_data.size()) ) {
+      std::cout << "FAILED: could not generate a mipmap chain of a " << width << "x" << height << "x" << num_components << " image." << std::endl;
+      ++statistics.Failures;
+      return false;
+    }
+    CompareWithReference( image_data, width, height, num_components, srgb, mipmap_data, levels, statistics );
+    return true;
+  }
+
+  void TestImage( std::mt19937 & generator,
+                  Statistics   & statistics ) {
+    // Mostly small, often odd and non-square sizes, so clamping at the edges is exercised on most levels
+    std::uniform_int_distribution<uint32_t> size_distribution( 1, 300 );
+    uint32_t width = size_distribution( generator );
+    uint32_t height = size_distribution( generator );
+    bool srgb = 0 == generator() % 2;
+
+    std::vector<unsigned char> rgba( static_cast<size_t>(width) * height * 4 );
+    for( auto & value : rgba ) {
+      value = static_cast<unsigned char>(generator());
+    }
+
+    std::vector<unsigned char> rgba_mipmaps;
+    std::vector<MipmapLevel> rgba_levels;
+    if( !Generate( rgba, width, height, 4, srgb, rgba_mipmaps, rgba_levels, statistics ) ) {
+      return;
+    }
+    ++statistics.Images;
+
+    // Each channel filtered on its own must give the same results as the vectorized 4-component path;
+    // color channels of an sRGB image are sRGB encoded, alpha never is
+    for( int channel = 0; channel < 4; ++channel ) {
+      std::vector<unsigned char> image( static_cast<size_t>(width) * height );
+      for( size_t i = 0; i < image.size(); ++i ) {
+        image[i] = rgba[4 * i + channel];
+      }
+
+      std::vector<unsigned char> mipmaps;
+      std::vector<MipmapLevel> levels;
+      if( !Generate( image, width, height, 1, srgb && (channel < 3), mipmaps, levels, statistics ) ) {
+        return;
+      }
+      for( size_t level = 0; level < levels.size(); ++level ) {
+        for( size_t i = 0; i < levels[level].DataSize; ++i ) {
+          if( mipmaps[levels[level].Offset + i] != rgba_mipmaps[rgba_levels[level].Offset + 4 * i + channel] ) {
+            std::cout << "FAILED: " << width << "x" << height << (srgb ? " sRGB" : "") << " image, level " << level << ", channel " << channel
+                      << ", texel " << i << ": 4-component path gives " << static_cast<int>(rgba_mipmaps[rgba_levels[level].Offset + 4 * i + channel])
+                      << ", 1-component path gives " << static_cast<int>(mipmaps[levels[level].Offset + i]) << std::endl;
+            ++statistics.Failures;
+            return;
+          }
+        }
+      }
+    }
+
+    // 2- and 3-component images only have the scalar path
+    for( int num_components = 2; num_components <= 3; ++num_components ) {
+      std::vector<unsigned char> image( static_cast<size_t>(width) * height * num_components );
+      for( size_t i = 0; i < image.size(); ++i ) {
+        image[i] = rgba[4 * (i / num_components) + i % num_components];
+      }
+      std::vector<unsigned char> mipmaps;
+      std::vector<MipmapLevel> levels;
+      Generate( image, width, height, num_components, srgb, mipmaps, levels, statistics );
+    }
+  }
+
+} // namespace
+
+int main( int argc, char ** argv ) {
+  uint32_t images_count = (argc > 1) ? static_cast<uint32_t>(std::atoi( argv[1] )) : 200;
+  uint32_t seed = (argc > 2) ? static_cast<uint32_t>(std::atoi( argv[2] )) : 1;
+
+#if defined( __SSE__ ) || defined( _M_X64 ) || (defined( _M_IX86_FP ) && (_M_IX86_FP >= 1))
+  std::cout << "4-component images are filtered with SSE." << std::endl;
+#else
+  std::cout << "SSE is not available - all images are filtered with the scalar path." << std::endl;
+#endif
+
+  std::mt19937 generator( seed );
+  Statistics statistics = {};
+  for( uint32_t i = 0; i < images_count; ++i ) {
+    TestImage( generator, statistics );
+  }
+
+  std::cout << statistics.Images << " images, " << statistics.Texels << " values compared with the reference, "
+            << statistics.Ties << " ties rounded the other way (" << 100.0 * statistics.Ties / std::max<size_t>( 1, statistics.Texels ) << "%)" << std::endl;
+  if( 0 < statistics.Failures ) {
+    std::cout << statistics.Failures << " check(s) failed." << std::endl;
+    return 1;
+  }
+  std::cout << "All checks passed." << std::endl;
+  return 0;
+}
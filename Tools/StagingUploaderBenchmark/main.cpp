@@ -0,0 +1,392 @@
+// MIT License
+//
+// Copyright( c ) 2017 Packt
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// StagingUploaderBenchmark
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include "04 Resources and Memory/15 Using staging buffer to update a buffer with a device-local memory bound.h"
+#include "04 Resources and Memory/16 Using staging buffer to update an image with a device-local memory bound.h"
+#include "04 Resources and Memory/23 Uploading data through a persistently mapped staging ring.h"
+
+// Micro-benchmark comparing the blocking staging helpers with uploads through a persistently mapped staging ring:
+//
+//   StagingUploaderBenchmark [<uploads count> [<upload size in KB> [<submission latency in microseconds> [<ring size in MB>]]]]
+//
+// No device is needed - Vulkan functions are replaced with stubs. Memory objects are allocated on the heap, so data
+// is really copied into staging memory. The mock queue executes submissions one after another and signals the fence
+// of each submission a given time after the previous one finishes; waiting for a fence spins until then.
+
+using namespace VulkanCookbook;
+
+namespace {
+
+  typedef std::chrono::steady_clock Clock;
+
+  struct MockBuffer {
+    VkDeviceSize  Size;
+  };
+
+  struct MockFence {
+    bool                Submitted;
+    Clock::time_point   SignalTime;
+  };
+
+  std::chrono::microseconds  SubmissionLatency( 100 );
+  Clock::time_point          QueueIdleTime;
+  uint64_t                   SubmissionsCount = 0;
+  uint64_t                   MemoryAllocationsCount = 0;
+  uint64_t                   CopyCommandsCount = 0;
+
+  bool IsSignaled( VkFence fence ) {
+    MockFence const * mock_fence = reinterpret_cast<MockFence const *>(fence);
+    return mock_fence->Submitted && (Clock::now() >= mock_fence->SignalTime);
+  }
+
+  VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceFeaturesStub( VkPhysicalDevice, VkPhysicalDeviceFeatures * features ) {
+    *features = {};
+  }
+
+  VKAPI_ATTR void VKAPI_CALL GetPhysicalDevicePropertiesStub( VkPhysicalDevice, VkPhysicalDeviceProperties * properties ) {
+    *properties = {};
+    properties->limits.optimalBufferCopyOffsetAlignment = 64;
+    properties->limits.nonCoherentAtomSize = 64;
+  }
+
+  VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceMemoryPropertiesStub( VkPhysicalDevice, VkPhysicalDeviceMemoryProperties * properties ) {
+    *properties = {};
+    properties->memoryTypeCount = 1;
+    properties->memoryTypes[0].propertyFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    properties->memoryHeapCount = 1;
+    properties->memoryHeaps[0].size = VkDeviceSize( 1 ) << 32;
+  }
+
+  VKAPI_ATTR VkResult VKAPI_CALL CreateBufferStub( VkDevice, VkBufferCreateInfo const * create_info, VkAllocationCallbacks const *, VkBuffer * buffer ) {
+    *buffer = reinterpret_cast<VkBuffer>(new MockBuffer{ create_info->size });
+    return VK_SUCCESS;
+  }
+
+  VKAPI_ATTR void VKAPI_CALL DestroyBufferStub( VkDevice, VkBuffer buffer, VkAllocationCallbacks const * ) {
+    delete reinterpret_cast<MockBuffer *>(buffer);
+  }
+
+  VKAPI_ATTR void VKAPI_CALL GetBufferMemoryRequirementsStub( VkDevice, VkBuffer buffer, VkMemoryRequirements * memory_requirements ) {
+    memory_requirements->size = reinterpret_cast<MockBuffer *>(buffer)->Size;
+    memory_requirements->alignment = 64;
+    memory_requirements->memoryTypeBits = 1;
+  }
+
+  VKAPI_ATTR VkResult VKAPI_CALL AllocateMemoryStub( VkDevice, VkMemoryAllocateInfo const * allocate_info, VkAllocationCallbacks const *, VkDeviceMemory * memory ) {
+    *memory = reinterpret_cast<VkDeviceMemory>(new unsigned char[static_cast<size_t>(allocate_info->allocationSize)]);
+    ++MemoryAllocationsCount;
+    return VK_SUCCESS;
+  }
+
+  VKAPI_ATTR void VKAPI_CALL FreeMemoryStub( VkDevice, VkDeviceMemory memory, VkAllocationCallbacks const * ) {
+    delete [] reinterpret_cast<unsigned char *>(memory);
+  }
+
+  VKAPI_ATTR VkResult VKAPI_CALL BindBufferMemoryStub( VkDevice, VkBuffer, VkDeviceMemory, VkDeviceSize ) {
+    return VK_SUCCESS;
+  }
+
+  VKAPI_ATTR VkResult VKAPI_CALL MapMemoryStub( VkDevice, VkDeviceMemory memory, VkDeviceSize offset, VkDeviceSize, VkMemoryMapFlags, void ** data ) {
+    *data = reinterpret_cast<unsigned char *>(memory) + offset;
+    return VK_SUCCESS;
+  }
+
+  VKAPI_ATTR void VKAPI_CALL UnmapMemoryStub( VkDevice, VkDeviceMemory ) {
+  }
+
+  VKAPI_ATTR VkResult VKAPI_CALL FlushMappedMemoryRangesStub( VkDevice, uint32_t, VkMappedMemoryRange const * ) {
+    return VK_SUCCESS;
+  }
+
+  VKAPI_ATTR VkResult VKAPI_CALL CreateCommandPoolStub( VkDevice, VkCommandPoolCreateInfo const *, VkAllocationCallbacks const *, VkCommandPool * command_pool ) {
+    static uint64_t next_command_pool = 0x1000;
+    *command_pool = reinterpret_cast<VkCommandPool>(static_cast<uintptr_t>(next_command_pool++));
+    return VK_SUCCESS;
+  }
+
+  VKAPI_ATTR void VKAPI_CALL DestroyCommandPoolStub( VkDevice, VkCommandPool, VkAllocationCallbacks const * ) {
+  }
+
+  VKAPI_ATTR VkResult VKAPI_CALL ResetCommandPoolStub( VkDevice, VkCommandPool, VkCommandPoolResetFlags ) {
+    return VK_SUCCESS;
+  }
+
+  VKAPI_ATTR VkResult VKAPI_CALL AllocateCommandBuffersStub( VkDevice, VkCommandBufferAllocateInfo const * allocate_info, VkCommandBuffer * command_buffers ) {
+    static uint64_t next_command_buffer = 0x100000;
+    for( uint32_t i = 0; i < allocate_info->commandBufferCount; ++i ) {
+      command_buffers[i] = reinterpret_cast<VkCommandBuffer>(static_cast<uintptr_t>(next_command_buffer++));
+    }
+    return VK_SUCCESS;
+  }
+
+  VKAPI_ATTR VkResult VKAPI_CALL BeginCommandBufferStub( VkCommandBuffer, VkCommandBufferBeginInfo const * ) {
+    return VK_SUCCESS;
+  }
+
+  VKAPI_ATTR VkResult VKAPI_CALL EndCommandBufferStub( VkCommandBuffer ) {
+    return VK_SUCCESS;
+  }
+
+  VKAPI_ATTR void VKAPI_CALL CmdPipelineBarrierStub( VkCommandBuffer, VkPipelineStageFlags, VkPipelineStageFlags, VkDependencyFlags,
+                                                     uint32_t, VkMemoryBarrier const *, uint32_t, VkBufferMemoryBarrier const *,
+                                                     uint32_t, VkImageMemoryBarrier const * ) {
+  }
+
+  VKAPI_ATTR void VKAPI_CALL CmdCopyBufferStub( VkCommandBuffer, VkBuffer, VkBuffer, uint32_t region_count, VkBufferCopy const * ) {
+    CopyCommandsCount += region_count;
+  }
+
+  VKAPI_ATTR void VKAPI_CALL CmdCopyBufferToImageStub( VkCommandBuffer, VkBuffer, VkImage, VkImageLayout, uint32_t region_count, VkBufferImageCopy const * ) {
+    CopyCommandsCount += region_count;
+  }
+
+  VKAPI_ATTR VkResult VKAPI_CALL CreateFenceStub( VkDevice, VkFenceCreateInfo const * create_info, VkAllocationCallbacks const *, VkFence * fence ) {
+    bool signaled = 0 != (create_info->flags & VK_FENCE_CREATE_SIGNALED_BIT);
+    *fence = reinterpret_cast<VkFence>(new MockFence{ signaled, Clock::now() });
+    return VK_SUCCESS;
+  }
+
+  VKAPI_ATTR void VKAPI_CALL DestroyFenceStub( VkDevice, VkFence fence, VkAllocationCallbacks const * ) {
+    delete reinterpret_cast<MockFence *>(fence);
+  }
+
+  VKAPI_ATTR VkResult VKAPI_CALL ResetFencesStub( VkDevice, uint32_t fence_count, VkFence const * fences ) {
+    for( uint32_t i = 0; i < fence_count; ++i ) {
+      reinterpret_cast<MockFence *>(fences[i])->Submitted = false;
+    }
+    return VK_SUCCESS;
+  }
+
+  VKAPI_ATTR VkResult VKAPI_CALL GetFenceStatusStub( VkDevice, VkFence fence ) {
+    return IsSignaled( fence ) ? VK_SUCCESS : VK_NOT_READY;
+  }
+
+  VKAPI_ATTR VkResult VKAPI_CALL WaitForFencesStub( VkDevice, uint32_t fence_count, VkFence const * fences, VkBool32 wait_all, uint64_t timeout ) {
+    Clock::time_point end = Clock::now() + std::chrono::nanoseconds( std::min<uint64_t>( timeout, 60000000000ull ) );
+    for( ;; ) {
+      uint32_t signaled_count = 0;
+      for( uint32_t i = 0; i < fence_count; ++i ) {
+        signaled_count += IsSignaled( fences[i] ) ? 1 : 0;
+      }
+      if( (wait_all && (signaled_count == fence_count)) ||
+          (!wait_all && (0 < signaled_count)) ) {
+        return VK_SUCCESS;
+      }
+      if( Clock::now() >= end ) {
+        return VK_TIMEOUT;
+      }
+      std::this_thread::yield();
+    }
+  }
+
+  VKAPI_ATTR VkResult VKAPI_CALL QueueSubmitStub( VkQueue, uint32_t, VkSubmitInfo const *, VkFence fence ) {
+    // Submissions are executed in order - each one starts when the previous one is finished
+    QueueIdleTime = std::max( QueueIdleTime, Clock::now() ) + SubmissionLatency;
+    if( VK_NULL_HANDLE != fence ) {
+      MockFence * mock_fence = reinterpret_cast<MockFence *>(fence);
+      mock_fence->Submitted = true;
+      mock_fence->SignalTime = QueueIdleTime;
+    }
+    ++SubmissionsCount;
+    return VK_SUCCESS;
+  }
+
+  void InstallStubs() {
+    vkGetPhysicalDeviceFeatures = GetPhysicalDeviceFeaturesStub;
+    vkGetPhysicalDeviceProperties = GetPhysicalDevicePropertiesStub;
+    vkGetPhysicalDeviceMemoryProperties = GetPhysicalDeviceMemoryPropertiesStub;
+
+    // Some recipes use the default dispatch table, so stubs are installed in both places
+#define INSTALL_STUB( name, stub ) name = stub; DefaultDeviceDispatch.name = stub;
+    INSTALL_STUB( vkCreateBuffer, CreateBufferStub )
+    INSTALL_STUB( vkDestroyBuffer, DestroyBufferStub )
+    INSTALL_STUB( vkGetBufferMemoryRequirements, GetBufferMemoryRequirementsStub )
+    INSTALL_STUB( vkAllocateMemory, AllocateMemoryStub )
+    INSTALL_STUB( vkFreeMemory, FreeMemoryStub )
+    INSTALL_STUB( vkBindBufferMemory, BindBufferMemoryStub )
+    INSTALL_STUB( vkMapMemory, MapMemoryStub )
+    INSTALL_STUB( vkUnmapMemory, UnmapMemoryStub )
+    INSTALL_STUB( vkFlushMappedMemoryRanges, FlushMappedMemoryRangesStub )
+    INSTALL_STUB( vkCreateCommandPool, CreateCommandPoolStub )
+    INSTALL_STUB( vkDestroyCommandPool, DestroyCommandPoolStub )
+    INSTALL_STUB( vkResetCommandPool, ResetCommandPoolStub )
+    INSTALL_STUB( vkAllocateCommandBuffers, AllocateCommandBuffersStub )
+    INSTALL_STUB( vkBeginCommandBuffer, BeginCommandBufferStub )
+    INSTALL_STUB( vkEndCommandBuffer, EndCommandBufferStub )
+    INSTALL_STUB( vkCmdPipelineBarrier, CmdPipelineBarrierStub )
+    INSTALL_STUB( vkCmdCopyBuffer, CmdCopyBufferStub )
+    INSTALL_STUB( vkCmdCopyBufferToImage, CmdCopyBufferToImageStub )
+    INSTALL_STUB( vkCreateFence, CreateFenceStub )
+    INSTALL_STUB( vkDestroyFence, DestroyFenceStub )
+    INSTALL_STUB( vkResetFences, ResetFencesStub )
+    INSTALL_STUB( vkGetFenceStatus, GetFenceStatusStub )
+    INSTALL_STUB( vkWaitForFences, WaitForFencesStub )
+    INSTALL_STUB( vkQueueSubmit, QueueSubmitStub )
+#undef INSTALL_STUB
+  }
+
+  VkPhysicalDevice const PHYSICAL_DEVICE = reinterpret_cast<VkPhysicalDevice>(1);
+  VkDevice const         LOGICAL_DEVICE = reinterpret_cast<VkDevice>(1);
+  VkQueue const          QUEUE = reinterpret_cast<VkQueue>(1);
+
+  // Every upload goes to a separate region of a buffer or to a separate image
+
+  VkBuffer DestinationBuffer() {
+    return reinterpret_cast<VkBuffer>(static_cast<uintptr_t>(0x10));
+  }
+
+  VkImage DestinationImage( uint32_t upload ) {
+    return reinterpret_cast<VkImage>(static_cast<uintptr_t>(0x10000 + upload));
+  }
+
+  VkExtent3D ImageSize( VkDeviceSize upload_size ) {
+    // RGBA8 images, 256 texels wide
+    return { 256, static_cast<uint32_t>(std::max<VkDeviceSize>( 1, upload_size / (4 * 256) )), 1 };
+  }
+
+  template<typename Function>
+  bool Measure( char const   * name,
+                uint32_t       uploads_count,
+                VkDeviceSize   upload_size,
+                Function       function ) {
+    // The previous case may leave work in the mock queue
+    while( Clock::now() < QueueIdleTime ) {
+    }
+    SubmissionsCount = 0;
+    MemoryAllocationsCount = 0;
+    CopyCommandsCount = 0;
+    uint64_t stalls_count = 0;
+
+    auto start = Clock::now();
+    if( !function( stalls_count ) ) {
+      std::cout << name << ": failed!" << std::endl;
+      return false;
+    }
+    double milliseconds = std::chrono::duration<double, std::milli>( Clock::now() - start ).count();
+
+    std::cout << "  " << name << ": " << milliseconds << " ms, "
+              << static_cast<double>(uploads_count) * upload_size / (1024.0 * 1024.0) / (milliseconds / 1000.0) << " MB/s, "
+              << static_cast<double>(SubmissionsCount) / uploads_count << " submissions and "
+              << static_cast<double>(MemoryAllocationsCount) / uploads_count << " memory allocations per upload, "
+              << CopyCommandsCount << " copies, " << stalls_count << " ring stalls" << std::endl;
+    return true;
+  }
+
+  bool UploadThroughRing( uint32_t                     uploads_count,
+                          std::vector<unsigned char> & data,
+                          VkDeviceSize                 ring_size,
+                          uint32_t                     flush_interval,
+                          bool                         images,
+                          uint64_t                   & stalls_count ) {
+    StagingUploader uploader;
+    if( !uploader.Initialize( PHYSICAL_DEVICE, LOGICAL_DEVICE, QUEUE, 0, ring_size ) ) {
+      return false;
+    }
+    for( uint32_t i = 0; i < uploads_count; ++i ) {
+      bool result = images
+        ? uploader.UpdateImage( data.size(), data.data(), DestinationImage( i ), { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 }, { 0, 0, 0 }, ImageSize( data.size() ),
+            VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 0, VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_ASPECT_COLOR_BIT,
+            VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT )
+        : uploader.UpdateBuffer( data.size(), data.data(), DestinationBuffer(), i * data.size(), 0, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT,
+            VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT );
+      if( !result ) {
+        return false;
+      }
+      if( (0 == (i + 1) % flush_interval) &&
+          !uploader.Flush() ) {
+        return false;
+      }
+    }
+    if( !uploader.Flush() ||
+        !uploader.WaitForAll() ) {
+      return false;
+    }
+    stalls_count = uploader.GetStatistics().StallCount;
+    return true;
+  }
+
+} // namespace
+
+int main( int argc, char ** argv ) {
+  uint32_t uploads_count = (argc > 1) ? static_cast<uint32_t>(std::atoi( argv[1] )) : 2000;
+  VkDeviceSize upload_size = 1024 * ((argc > 2) ? static_cast<VkDeviceSize>(std::atoi( argv[2] )) : 64);
+  SubmissionLatency = std::chrono::microseconds( (argc > 3) ? std::atoi( argv[3] ) : 100 );
+  VkDeviceSize ring_size = 1024 * 1024 * ((argc > 4) ? static_cast<VkDeviceSize>(std::atoi( argv[4] )) : 16);
+  if( (0 == uploads_count) ||
+      (0 == upload_size) ||
+      (ring_size < upload_size) ) {
+    std::cout << "Usage: StagingUploaderBenchmark [<uploads count> [<upload size in KB> [<submission latency in microseconds> [<ring size in MB>]]]]" << std::endl;
+    return 1;
+  }
+
+  InstallStubs();
+
+  std::vector<unsigned char> data( static_cast<size_t>(upload_size) );
+  for( size_t i = 0; i < data.size(); ++i ) {
+    data[i] = static_cast<unsigned char>(i);
+  }
+  VkCommandBuffer command_buffer = reinterpret_cast<VkCommandBuffer>(static_cast<uintptr_t>(0x20));
+
+  std::cout << uploads_count << " x " << upload_size / 1024 << " KB uploads, " << SubmissionLatency.count() << " us per submission, "
+            << ring_size / (1024 * 1024) << " MB ring" << std::endl;
+
+  bool succeeded = true;
+  for( int images = 0; succeeded && (images < 2); ++images ) {
+    std::cout << (images ? "Images:" : "Buffers:") << std::endl;
+
+    succeeded &= Measure( images ? "04/16 staging image helper" : "04/15 staging buffer helper", uploads_count, upload_size, [&]( uint64_t & ) {
+      for( uint32_t i = 0; i < uploads_count; ++i ) {
+        bool result = images
+          ? UseStagingBufferToUpdateImageWithDeviceLocalMemoryBound( PHYSICAL_DEVICE, LOGICAL_DEVICE, data.size(), data.data(), DestinationImage( i ),
+              { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 }, { 0, 0, 0 }, ImageSize( data.size() ), VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+              0, VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_ASPECT_COLOR_BIT, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, QUEUE, command_buffer, {} )
+          : UseStagingBufferToUpdateBufferWithDeviceLocalMemoryBound( PHYSICAL_DEVICE, LOGICAL_DEVICE, data.size(), data.data(), DestinationBuffer(),
+              i * data.size(), 0, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, QUEUE, command_buffer, {} );
+        if( !result ) {
+          return false;
+        }
+      }
+      return true;
+    } );
+
+    for( uint32_t flush_interval : { 1u, 16u, 128u } ) {
+      std::string name = "ring, flush every " + std::to_string( flush_interval ) + " upload(s)";
+      succeeded &= Measure( name.c_str(), uploads_count, upload_size, [&]( uint64_t & stalls_count ) {
+        return UploadThroughRing( uploads_count, data, ring_size, flush_interval, 0 != images, stalls_count );
+      } );
+    }
+  }
+  return succeeded ? 0 : 1;
+}
@@ -0,0 +1,186 @@
+// MIT License
+//
+// Copyright( c ) 2017 Packt
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// TangentSpaceBenchmark
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include "Common.h"
+#include "10 Helper Recipes/07 Loading a 3D model from an OBJ file.h"
+
+// Measures generation of tangent space vectors for a synthetic model:
+//
+//   TangentSpaceBenchmark [<triangles count> [<repetitions count>]]
+//
+// A wavy grid with normal vectors and texture coordinates is written to a temporary OBJ file. The model is loaded
+// without tangent space vectors and then with them - the difference is mostly the time of the generation. It is done
+// with temporary threads and with thread pools of different sizes; all of them must give exactly the same data.
+// No device is needed - Vulkan functions used by the thread pool are replaced with stubs.
+
+using namespace VulkanCookbook;
+
+namespace {
+
+  uint64_t NextHandle = 0x1000;
+
+  VKAPI_ATTR VkResult VKAPI_CALL CreateCommandPoolStub( VkDevice, VkCommandPoolCreateInfo const *, VkAllocationCallbacks const *, VkCommandPool * command_pool ) {
+    *command_pool = reinterpret_cast<VkCommandPool>(static_cast<uintptr_t>(NextHandle++));
+    return VK_SUCCESS;
+  }
+
+  VKAPI_ATTR void VKAPI_CALL DestroyCommandPoolStub( VkDevice, VkCommandPool, VkAllocationCallbacks const * ) {
+  }
+
+  void InstallStubs() {
+    vkCreateCommandPool = CreateCommandPoolStub;
+    vkDestroyCommandPool = DestroyCommandPoolStub;
+    DefaultDeviceDispatch.vkCreateCommandPool = CreateCommandPoolStub;
+    DefaultDeviceDispatch.vkDestroyCommandPool = DestroyCommandPoolStub;
+  }
+
+  // Grid of size x size quads, each split into two triangles; vertices are shared by adjacent quads
+
+  bool WriteGridObjFile( char const * filename,
+                         uint32_t     size ) {
+    std::ofstream file( filename );
+    if( file.fail() ) {
+      std::cout << "Could not create the '" << filename << "' file." << std::endl;
+      return false;
+    }
+
+    for( uint32_t y = 0; y <= size; ++y ) {
+      for( uint32_t x = 0; x <= size; ++x ) {
+        float u = static_cast<float>(x) / size;
+        float v = static_cast<float>(y) / size;
+        float height = 0.05f * std::sin( 20.0f * u ) * std::cos( 20.0f * v );
+        file << "v " << u << " " << height << " " << v << "\n";
+        // Normal vector of the height field
+        float dx = std::cos( 20.0f * u ) * std::cos( 20.0f * v );
+        float dz = -std::sin( 20.0f * u ) * std::sin( 20.0f * v );
+        float length = std::sqrt( dx * dx + 1.0f + dz * dz );
+        file << "vn " << -dx / length << " " << 1.0f / length << " " << -dz / length << "\n";
+        file << "vt " << u << " " << v << "\n";
+      }
+    }
+    for( uint32_t y = 0; y < size; ++y ) {
+      for( uint32_t x = 0; x < size; ++x ) {
+        uint32_t i0 = y * (size + 1) + x + 1;
+        uint32_t i1 = i0 + 1;
+        uint32_t i2 = i0 + size + 1;
+        uint32_t i3 = i2 + 1;
+        file << "f " << i0 << "/" << i0 << "/" << i0 << " " << i2 << "/" << i2 << "/" << i2 << " " << i1 << "/" << i1 << "/" << i1 << "\n";
+        file << "f " << i1 << "/" << i1 << "/" << i1 << " " << i2 << "/" << i2 << "/" << i2 << " " << i3 << "/" << i3 << "/" << i3 << "\n";
+      }
+    }
+    return !file.fail();
+  }
+
+  // Returns the shortest of all repetitions, in milliseconds
+
+  bool Load( char const * filename,
+             bool         generate_tangent_space_vectors,
+             ThreadPool * thread_pool,
+             uint32_t     repetitions_count,
+             Mesh       & mesh,
+             double     & milliseconds ) {
+    milliseconds = 0.0;
+    for( uint32_t i = 0; i < repetitions_count; ++i ) {
+      auto start = std::chrono::steady_clock::now();
+      if( !Load3DModelFromObjFile( filename, true, true, generate_tangent_space_vectors, false, mesh, nullptr, thread_pool ) ) {
+        return false;
+      }
+      double duration = std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - start ).count();
+      if( (0 == i) ||
+          (duration < milliseconds) ) {
+        milliseconds = duration;
+      }
+    }
+    return true;
+  }
+
+} // namespace
+
+int main( int argc, char ** argv ) {
+  uint32_t triangles_count = (argc > 1) ? static_cast<uint32_t>(std::atoi( argv[1] )) : 1000000;
+  uint32_t repetitions_count = (argc > 2) ? static_cast<uint32_t>(std::atoi( argv[2] )) : 3;
+  if( (2 > triangles_count) ||
+      (0 == repetitions_count) ) {
+    std::cout << "Usage: TangentSpaceBenchmark [<triangles count> [<repetitions count>]]" << std::endl;
+    return 1;
+  }
+
+  InstallStubs();
+
+  uint32_t grid_size = static_cast<uint32_t>(std::sqrt( triangles_count / 2.0 ));
+  char const * filename = "TangentSpaceBenchmark.obj";
+  if( !WriteGridObjFile( filename, grid_size ) ) {
+    return 1;
+  }
+  std::cout << 2 * grid_size * grid_size << " triangles, best of " << repetitions_count << " run(s)" << std::endl;
+
+  bool succeeded = true;
+  Mesh mesh;
+  double load_milliseconds;
+  if( Load( filename, false, nullptr, repetitions_count, mesh, load_milliseconds ) ) {
+    std::cout << "Loading without tangent space vectors: " << load_milliseconds << " ms" << std::endl;
+
+    Mesh reference_mesh;
+    double milliseconds;
+    if( Load( filename, true, nullptr, repetitions_count, reference_mesh, milliseconds ) ) {
+      std::cout << "Generation on temporary threads: " << milliseconds - load_milliseconds << " ms" << std::endl;
+    } else {
+      succeeded = false;
+    }
+
+    // At least a few workers are used even on machines with fewer cores, so splitting the work is always verified
+    uint32_t max_threads_count = std::max( 4u, std::thread::hardware_concurrency() );
+    for( uint32_t threads_count = 1; succeeded && (threads_count <= max_threads_count); threads_count *= 2 ) {
+      ThreadPool thread_pool;
+      if( !thread_pool.Initialize( reinterpret_cast<VkDevice>(1), 0, threads_count, 1 ) ||
+          !Load( filename, true, &thread_pool, repetitions_count, mesh, milliseconds ) ) {
+        succeeded = false;
+        break;
+      }
+      std::cout << "Generation on a pool of " << threads_count << " thread(s): " << milliseconds - load_milliseconds << " ms" << std::endl;
+      if( mesh.Data != reference_mesh.Data ) {
+        std::cout << "Tangent space vectors differ from the ones generated on temporary threads!" << std::endl;
+        succeeded = false;
+      }
+    }
+  } else {
+    succeeded = false;
+  }
+
+  std::remove( filename );
+  return succeeded ? 0 : 1;
+}
@@ -0,0 +1,438 @@
+// MIT License
+//
+// Copyright( c ) 2017 Packt
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// TextureCompressor
+
+#include <algorithm>
+#include <fstream>
+#include "10 Helper Recipes/12 Generating a mipmap chain on a CPU.h"
+#include "10 Helper Recipes/13 Loading texture data from a KTX or DDS file.h"
+
+// Offline tool converting images into block-compressed DDS or KTX files with a full mipmap chain:
+//
+//   TextureCompressor <BC1|BC3|BC4|BC5> [-srgb] [-nomips] <output.dds|output.ktx> <input> [<input> x5 for a cubemap]
+//
+// BC1 and BC3 store colors (and alpha), BC4 stores the red component, BC5 stores red and green
+// components (e.g. of normal maps). Six inputs are stored as cubemap faces in the +X, -X, +Y, -Y, +Z, -Z order.
+
+using namespace VulkanCookbook;
+
+namespace {
+
+  enum class BlockFormat {
+    BC1,
+    BC3,
+    BC4,
+    BC5
+  };
+
+  uint16_t PackColor565( float const color[3] ) {
+    uint32_t r = static_cast<uint32_t>(std::min( 31.0f, std::max( 0.0f, color[0] * 31.0f / 255.0f + 0.5f ) ));
+    uint32_t g = static_cast<uint32_t>(std::min( 63.0f, std::max( 0.0f, color[1] * 63.0f / 255.0f + 0.5f ) ));
+    uint32_t b = static_cast<uint32_t>(std::min( 31.0f, std::max( 0.0f, color[2] * 31.0f / 255.0f + 0.5f ) ));
+    return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+  }
+
+  void UnpackColor565( uint16_t  packed,
+                       float     color[3] ) {
+    uint32_t r = (packed >> 11) & 31;
+    uint32_t g = (packed >> 5) & 63;
+    uint32_t b = packed & 31;
+    color[0] = static_cast<float>((r << 3) | (r >> 2));
+    color[1] = static_cast<float>((g << 2) | (g >> 4));
+    color[2] = static_cast<float>((b << 3) | (b >> 2));
+  }
+
+  // Endpoints are found along the principal axis of the block's colors, then refined
+  // with a least-squares fit to the selected palette indices
+
+  void CompressColorBlock( unsigned char const block[16][4],
+                           unsigned char       output[8] ) {
+    float mean[3] = { 0.0f, 0.0f, 0.0f };
+    for( int i = 0; i < 16; ++i ) {
+      for( int c = 0; c < 3; ++c ) {
+        mean[c] += block[i][c] / 16.0f;
+      }
+    }
+    float covariance[6] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+    for( int i = 0; i < 16; ++i ) {
+      float d[3] = { block[i][0] - mean[0], block[i][1] - mean[1], block[i][2] - mean[2] };
+      covariance[0] += d[0] * d[0];
+      covariance[1] += d[0] * d[1];
+      covariance[2] += d[0] * d[2];
+      covariance[3] += d[1] * d[1];
+      covariance[4] += d[1] * d[2];
+      covariance[5] += d[2] * d[2];
+    }
+    float axis[3] = { 1.0f, 1.0f, 1.0f };
+    for( int iteration = 0; iteration < 8; ++iteration ) {
+      float x = covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2];
+      float y = covariance[1] * axis[0] + covariance[3] * axis[1] + covariance[4] * axis[2];
+      float z = covariance[2] * axis[0] + covariance[4] * axis[1] + covariance[5] * axis[2];
+      float length = std::max( std::max( std::abs( x ), std::abs( y ) ), std::abs( z ) );
+      if( length < 1e-6f ) {
+        break;
+      }
+      axis[0] = x / length;
+      axis[1] = y / length;
+      axis[2] = z / length;
+    }
+
+    float min_projection = 1e30f;
+    float max_projection = -1e30f;
+    for( int i = 0; i < 16; ++i ) {
+      float projection = (block[i][0] - mean[0]) * axis[0] + (block[i][1] - mean[1]) * axis[1] + (block[i][2] - mean[2]) * axis[2];
+      min_projection = std::min( min_projection, projection );
+      max_projection = std::max( max_projection, projection );
+    }
+    float axis_length_squared = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+    float endpoints[2][3];
+    for( int c = 0; c < 3; ++c ) {
+      endpoints[0][c] = mean[c] + axis[c] * max_projection / axis_length_squared;
+      endpoints[1][c] = mean[c] + axis[c] * min_projection / axis_length_squared;
+    }
+
+    uint16_t packed[2];
+    uint32_t indices = 0;
+    for( int pass = 0; pass < 2; ++pass ) {
+      packed[0] = PackColor565( endpoints[0] );
+      packed[1] = PackColor565( endpoints[1] );
+      if( packed[0] < packed[1] ) {
+        std::swap( packed[0], packed[1] );
+      }
+
+      // Palette order: color0, color1, 2/3 color0 + 1/3 color1, 1/3 color0 + 2/3 color1
+      float palette[4][3];
+      UnpackColor565( packed[0], palette[0] );
+      UnpackColor565( packed[1], palette[1] );
+      for( int c = 0; c < 3; ++c ) {
+        palette[2][c] = (2.0f * palette[0][c] + palette[1][c]) / 3.0f;
+        palette[3][c] = (palette[0][c] + 2.0f * palette[1][c]) / 3.0f;
+      }
+      static float const weights[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+
+      indices = 0;
+      float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+      float ax[3] = { 0.0f, 0.0f, 0.0f };
+      float bx[3] = { 0.0f, 0.0f, 0.0f };
+      for( int i = 0; i < 16; ++i ) {
+        uint32_t best_index = 0;
+        float best_error = 1e30f;
+        for( uint32_t index = 0; index < ((packed[0] == packed[1]) ? 1u : 4u); ++index ) {
+          float error = 0.0f;
+          for( int c = 0; c < 3; ++c ) {
+            float d = block[i][c] - palette[index][c];
+            error += d * d;
+          }
+          if( error < best_error ) {
+            best_error = error;
+            best_index = index;
+          }
+        }
+        indices |= best_index << (2 * i);
+
+        float a = weights[best_index];
+        float b = 1.0f - a;
+        aa += a * a;
+        ab += a * b;
+        bb += b * b;
+        for( int c = 0; c < 3; ++c ) {
+          ax[c] += a * block[i][c];
+          bx[c] += b * block[i][c];
+        }
+      }
+
+      float determinant = aa * bb - ab * ab;
+      if( (0 == pass) &&
+          (std::abs( determinant ) > 1e-6f) ) {
+        for( int c = 0; c < 3; ++c ) {
+          endpoints[0][c] = (ax[c] * bb - bx[c] * ab) / determinant;
+          endpoints[1][c] = (bx[c] * aa - ax[c] * ab) / determinant;
+        }
+      } else {
+        break;
+      }
+    }
+
+    output[0] = static_cast<unsigned char>(packed[0] & 0xFF);
+    output[1] = static_cast<unsigned char>(packed[0] >> 8);
+    output[2] = static_cast<unsigned char>(packed[1] & 0xFF);
+    output[3] = static_cast<unsigned char>(packed[1] >> 8);
+    for( int i = 0; i < 4; ++i ) {
+      output[4 + i] = static_cast<unsigned char>((indices >> (8 * i)) & 0xFF);
+    }
+  }
+
+  // Eight-value mode: value0 = maximum, value1 = minimum, remaining values interpolated between them
+
+  void CompressSingleComponentBlock( unsigned char const block[16][4],
+                                     int                 component,
+                                     unsigned char       output[8] ) {
+    unsigned char min_value = 255;
+    unsigned char max_value = 0;
+    for( int i = 0; i < 16; ++i ) {
+      min_value = std::min( min_value, block[i][component] );
+      max_value = std::max( max_value, block[i][component] );
+    }
+    output[0] = max_value;
+    output[1] = min_value;
+
+    uint64_t indices = 0;
+    if( max_value > min_value ) {
+      for( int i = 0; i < 16; ++i ) {
+        int position = (14 * (block[i][component] - min_value) + (max_value - min_value)) / (2 * (max_value - min_value));
+        uint64_t index = (7 == position) ? 0 : ((0 == position) ? 1 : 8 - position);
+        indices |= index << (3 * i);
+      }
+    }
+    for( int i = 0; i < 6; ++i ) {
+      output[2 + i] = static_cast<unsigned char>((indices >> (8 * i)) & 0xFF);
+    }
+  }
+
+  uint32_t GetBlockSize( BlockFormat format ) {
+    return ((BlockFormat::BC1 == format) || (BlockFormat::BC4 == format)) ? 8 : 16;
+  }
+
+  void CompressImage( unsigned char const        * rgba_data,
+                      uint32_t                     width,
+                      uint32_t                     height,
+                      BlockFormat                  format,
+                      std::vector<unsigned char> & compressed_data ) {
+    for( uint32_t block_y = 0; block_y < height; block_y += 4 ) {
+      for( uint32_t block_x = 0; block_x < width; block_x += 4 ) {
+        // Texels outside of the image (in levels smaller than 4x4) replicate the edge ones
+        unsigned char block[16][4];
+        for( uint32_t y = 0; y < 4; ++y ) {
+          for( uint32_t x = 0; x < 4; ++x ) {
+            uint32_t source_x = std::min( block_x + x, width - 1 );
+            uint32_t source_y = std::min( block_y + y, height - 1 );
+            std::memcpy( block[4 * y + x], &rgba_data[4 * (source_y * width + source_x)], 4 );
+          }
+        }
+
+        unsigned char output[16];
+        switch( format ) {
+        case BlockFormat::BC1:
+          CompressColorBlock( block, output );
+          break;
+        case BlockFormat::BC3:
+          CompressSingleComponentBlock( block, 3, output );
+          CompressColorBlock( block, output + 8 );
+          break;
+        case BlockFormat::BC4:
+          CompressSingleComponentBlock( block, 0, output );
+          break;
+        case BlockFormat::BC5:
+          CompressSingleComponentBlock( block, 0, output );
+          CompressSingleComponentBlock( block, 1, output + 8 );
+          break;
+        }
+        compressed_data.insert( compressed_data.end(), output, output + GetBlockSize( format ) );
+      }
+    }
+  }
+
+  void AppendValue( std::vector<unsigned char> & data,
+                    uint32_t                     value ) {
+    unsigned char bytes[4];
+    std::memcpy( bytes, &value, 4 );
+    data.insert( data.end(), bytes, bytes + 4 );
+  }
+
+  // Levels are stored per face in DDS files and faces are stored per level in KTX files
+
+  bool SaveTextureContainerFile( std::string const                                    & filename,
+                                 BlockFormat                                            format,
+                                 bool                                                   srgb,
+                                 uint32_t                                               width,
+                                 uint32_t                                               height,
+                                 std::vector<std::vector<std::vector<unsigned char>>> const & faces_levels ) {
+    uint32_t faces_count = static_cast<uint32_t>(faces_levels.size());
+    uint32_t levels_count = static_cast<uint32_t>(faces_levels[0].size());
+    std::vector<unsigned char> file_data;
+
+    if( (filename.size() > 4) &&
+        (".ktx" == filename.substr( filename.size() - 4 )) ) {
+      static uint32_t const gl_internal_formats[4][2] = {
+        { 0x83F1, 0x8C4D },   // BC1
+        { 0x83F3, 0x8C4F },   // BC3
+        { 0x8DBB, 0x8DBB },   // BC4
+        { 0x8DBD, 0x8DBD }    // BC5
+      };
+      static uint32_t const gl_base_formats[4] = { 0x1908, 0x1908, 0x1903, 0x8227 };   // GL_RGBA, GL_RGBA, GL_RED, GL_RG
+
+      static unsigned char const identifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n' };
+      file_data.insert( file_data.end(), identifier, identifier + 12 );
+      AppendValue( file_data, 0x04030201 );
+      AppendValue( file_data, 0 );                                                            // glType
+      AppendValue( file_data, 1 );                                                            // glTypeSize
+      AppendValue( file_data, 0 );                                                            // glFormat
+      AppendValue( file_data, gl_internal_formats[static_cast<int>(format)][srgb ? 1 : 0] );
+      AppendValue( file_data, gl_base_formats[static_cast<int>(format)] );
+      AppendValue( file_data, width );
+      AppendValue( file_data, height );
+      AppendValue( file_data, 0 );                                                            // pixelDepth
+      AppendValue( file_data, 0 );                                                            // numberOfArrayElements
+      AppendValue( file_data, faces_count );
+      AppendValue( file_data, levels_count );
+      AppendValue( file_data, 0 );                                                            // bytesOfKeyValueData
+
+      for( uint32_t level = 0; level < levels_count; ++level ) {
+        AppendValue( file_data, static_cast<uint32_t>(faces_levels[0][level].size()) );
+        for( uint32_t face = 0; face < faces_count; ++face ) {
+          file_data.insert( file_data.end(), faces_levels[face][level].begin(), faces_levels[face][level].end() );
+          file_data.resize( (file_data.size() + 3) / 4 * 4, 0 );
+        }
+      }
+    } else {
+      static uint32_t const dxgi_formats[4][2] = {
+        { 71, 72 },   // BC1
+        { 77, 78 },   // BC3
+        { 80, 80 },   // BC4
+        { 83, 83 }    // BC5
+      };
+
+      file_data.insert( file_data.end(), { 'D', 'D', 'S', ' ' } );
+      AppendValue( file_data, 124 );                                                          // size
+      AppendValue( file_data, 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000 | 0x80000 );                // caps, height, width, pixel format, mipmap count, linear size
+      AppendValue( file_data, height );
+      AppendValue( file_data, width );
+      AppendValue( file_data, static_cast<uint32_t>(faces_levels[0][0].size()) );            // linear size
+      AppendValue( file_data, 0 );                                                            // depth
+      AppendValue( file_data, levels_count );
+      for( int i = 0; i < 11; ++i ) {
+        AppendValue( file_data, 0 );                                                          // reserved
+      }
+      AppendValue( file_data, 32 );                                                           // pixel format size
+      AppendValue( file_data, 0x4 );                                                          // four CC
+      AppendValue( file_data, 0x30315844 );                                                   // "DX10"
+      for( int i = 0; i < 5; ++i ) {
+        AppendValue( file_data, 0 );                                                          // bit counts and masks
+      }
+      AppendValue( file_data, 0x1000 | 0x400000 | ((6 == faces_count) ? 0x8 : 0) );           // texture, mipmap, complex
+      AppendValue( file_data, (6 == faces_count) ? 0xFE00 : 0 );                              // cubemap with all faces
+      AppendValue( file_data, 0 );
+      AppendValue( file_data, 0 );
+      AppendValue( file_data, 0 );
+      AppendValue( file_data, dxgi_formats[static_cast<int>(format)][srgb ? 1 : 0] );
+      AppendValue( file_data, 3 );                                                            // 2D texture
+      AppendValue( file_data, (6 == faces_count) ? 0x4 : 0 );                                 // cubemap
+      AppendValue( file_data, 1 );                                                            // array size
+      AppendValue( file_data, 0 );
+
+      for( uint32_t face = 0; face < faces_count; ++face ) {
+        for( uint32_t level = 0; level < levels_count; ++level ) {
+          file_data.insert( file_data.end(), faces_levels[face][level].begin(), faces_levels[face][level].end() );
+        }
+      }
+    }
+
+    std::ofstream file( filename, std::ios::binary );
+    if( file.fail() ) {
+      std::cout << "Could not open '" << filename << "' file." << std::endl;
+      return false;
+    }
+    file.write( reinterpret_cast<char const *>(file_data.data()), file_data.size() );
+    return !file.fail();
+  }
+
+} // namespace
+
+int main( int    argc,
+          char * argv[] ) {
+  std::vector<std::string> arguments( argv + 1, argv + argc );
+  bool srgb = false;
+  bool generate_mipmaps = true;
+  arguments.erase( std::remove_if( arguments.begin(), arguments.end(), [&]( std::string const & argument ) {
+    if( "-srgb" == argument ) {
+      srgb = true;
+      return true;
+    } else if( "-nomips" == argument ) {
+      generate_mipmaps = false;
+      return true;
+    }
+    return false;
+  } ), arguments.end() );
+
+  std::vector<std::string> const format_names = { "BC1", "BC3", "BC4", "BC5" };
+  auto format_name = (arguments.size() > 0) ? std::find( format_names.begin(), format_names.end(), arguments[0] ) : format_names.end();
+  if( (format_names.end() == format_name) ||
+      ((3 != arguments.size()) && (8 != arguments.size())) ) {
+    std::cout << "Usage: TextureCompressor <BC1|BC3|BC4|BC5> [-srgb] [-nomips] <output.dds|output.ktx> <input> [<input> x5 for a cubemap]" << std::endl;
+    return 1;
+  }
+  BlockFormat format = static_cast<BlockFormat>(format_name - format_names.begin());
+  if( (BlockFormat::BC4 == format) ||
+      (BlockFormat::BC5 == format) ) {
+    srgb = false;
+  }
+
+  uint32_t width = 0;
+  uint32_t height = 0;
+  std::vector<std::vector<std::vector<unsigned char>>> faces_levels;
+  for( size_t input = 2; input < arguments.size(); ++input ) {
+    std::vector<unsigned char> mipmap_data;
+    std::vector<MipmapLevel> levels;
+    if( !LoadTextureDataFromFile( arguments[input].c_str(), 4, srgb, mipmap_data, levels ) ) {
+      return 1;
+    }
+    if( 0 == width ) {
+      width = levels[0].Width;
+      height = levels[0].Height;
+    } else if( (width != levels[0].Width) ||
+               (height != levels[0].Height) ) {
+      std::cout << "All cubemap faces must have the same size!" << std::endl;
+      return 1;
+    }
+    if( !generate_mipmaps ) {
+      levels.resize( 1 );
+    }
+
+    faces_levels.emplace_back();
+    for( auto & level : levels ) {
+      faces_levels.back().emplace_back();
+      CompressImage( &mipmap_data[level.Offset], level.Width, level.Height, format, faces_levels.back().back() );
+    }
+  }
+
+  if( !SaveTextureContainerFile( arguments[1], format, srgb, width, height, faces_levels ) ) {
+    return 1;
+  }
+
+  // Verify that the written file can be consumed by the loader used by the samples
+  TextureContainerData texture;
+  if( !LoadTextureDataFromContainerFile( arguments[1].c_str(), texture ) ) {
+    return 1;
+  }
+  std::cout << "Saved " << texture.Size.width << "x" << texture.Size.height << " " << *format_name << (srgb ? " sRGB" : "")
+            << " texture with " << texture.MipmapLevelsCount << " mipmap level(s) and " << texture.LayersCount << " layer(s) ("
+            << texture.Data.size() << " bytes) to '" << arguments[1] << "'." << std::endl;
+  return 0;
+}
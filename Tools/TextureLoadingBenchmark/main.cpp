@@ -0,0 +1,193 @@
+// MIT License
+//
+// Copyright( c ) 2017 Packt
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// TextureLoadingBenchmark
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include "10 Helper Recipes/06 Loading texture data from a file.h"
+#include "10 Helper Recipes/11 Loading texture data from multiple files in parallel.h"
+
+// Compares loading texture files one after another with decoding them in parallel:
+//
+//   TextureLoadingBenchmark [<repetitions count> [<image file> ...]]
+//
+// Without files, faces of the skybox cubemap from the Data/Textures directory are used (run it from the build
+// directory, like samples). Files are loaded serially with LoadTextureDataFromFile(), in parallel on temporary threads
+// and on a thread pool with one worker per core; decode times of each file and the total loading time are reported.
+// All methods must give the same data. No device is needed - Vulkan functions used by the thread pool are replaced with stubs.
+
+using namespace VulkanCookbook;
+
+namespace {
+
+  uint64_t NextHandle = 0x1000;
+
+  VKAPI_ATTR VkResult VKAPI_CALL CreateCommandPoolStub( VkDevice, VkCommandPoolCreateInfo const *, VkAllocationCallbacks const *, VkCommandPool * command_pool ) {
+    *command_pool = reinterpret_cast<VkCommandPool>(static_cast<uintptr_t>(NextHandle++));
+    return VK_SUCCESS;
+  }
+
+  VKAPI_ATTR void VKAPI_CALL DestroyCommandPoolStub( VkDevice, VkCommandPool, VkAllocationCallbacks const * ) {
+  }
+
+  void InstallStubs() {
+    vkCreateCommandPool = CreateCommandPoolStub;
+    vkDestroyCommandPool = DestroyCommandPoolStub;
+    DefaultDeviceDispatch.vkCreateCommandPool = CreateCommandPoolStub;
+    DefaultDeviceDispatch.vkDestroyCommandPool = DestroyCommandPoolStub;
+  }
+
+  void Report( char const                     * name,
+               double                           milliseconds,
+               std::vector<std::string> const & filenames,
+               std::vector<double> const      & decode_times ) {
+    std::cout << name << ": " << milliseconds << " ms (decoding:";
+    for( size_t i = 0; i < filenames.size(); ++i ) {
+      std::cout << " " << filenames[i].substr( filenames[i].find_last_of( "/\\" ) + 1 ) << " " << decode_times[i] << " ms" << (i + 1 < filenames.size() ? "," : ")");
+    }
+    std::cout << std::endl;
+  }
+
+  bool LoadSerially( std::vector<std::string> const & filenames,
+                     std::vector<unsigned char>     & image_data,
+                     std::vector<double>            & decode_times ) {
+    image_data.clear();
+    decode_times.resize( filenames.size() );
+    for( size_t i = 0; i < filenames.size(); ++i ) {
+      auto start = std::chrono::steady_clock::now();
+      std::vector<unsigned char> data;
+      if( !LoadTextureDataFromFile( filenames[i].c_str(), 4, data ) ) {
+        return false;
+      }
+      decode_times[i] = std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - start ).count();
+      image_data.insert( image_data.end(), data.begin(), data.end() );
+    }
+    return true;
+  }
+
+  bool LoadInParallel( std::vector<std::string> const & filenames,
+                       ThreadPool                     * thread_pool,
+                       std::vector<unsigned char>     & image_data,
+                       std::vector<double>            & decode_times ) {
+    std::vector<TextureDecodeResult> results;
+    if( !LoadTextureDataFromFiles( filenames, 4, image_data, results, thread_pool ) ) {
+      return false;
+    }
+    decode_times.resize( results.size() );
+    for( size_t i = 0; i < results.size(); ++i ) {
+      decode_times[i] = results[i].DecodeTime;
+    }
+    return true;
+  }
+
+  // Reports the repetition with the shortest total time
+
+  template<typename Function>
+  bool Measure( char const                       * name,
+                std::vector<std::string> const   & filenames,
+                uint32_t                           repetitions_count,
+                std::vector<unsigned char>       & image_data,
+                Function                           function ) {
+    double best_milliseconds = 0.0;
+    std::vector<double> best_decode_times;
+    for( uint32_t i = 0; i < repetitions_count; ++i ) {
+      std::vector<double> decode_times;
+      auto start = std::chrono::steady_clock::now();
+      if( !function( image_data, decode_times ) ) {
+        return false;
+      }
+      double milliseconds = std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - start ).count();
+      if( (0 == i) ||
+          (milliseconds < best_milliseconds) ) {
+        best_milliseconds = milliseconds;
+        best_decode_times = decode_times;
+      }
+    }
+    Report( name, best_milliseconds, filenames, best_decode_times );
+    return true;
+  }
+
+} // namespace
+
+int main( int argc, char ** argv ) {
+  uint32_t repetitions_count = (argc > 1) ? static_cast<uint32_t>(std::atoi( argv[1] )) : 3;
+  if( 0 == repetitions_count ) {
+    std::cout << "Usage: TextureLoadingBenchmark [<repetitions count> [<image file> ...]]" << std::endl;
+    return 1;
+  }
+
+  std::vector<std::string> filenames;
+  for( int i = 2; i < argc; ++i ) {
+    filenames.push_back( argv[i] );
+  }
+  if( filenames.empty() ) {
+    filenames = {
+      "Data/Textures/Skansen/posx.jpg",
+      "Data/Textures/Skansen/negx.jpg",
+      "Data/Textures/Skansen/posy.jpg",
+      "Data/Textures/Skansen/negy.jpg",
+      "Data/Textures/Skansen/posz.jpg",
+      "Data/Textures/Skansen/negz.jpg"
+    };
+  }
+
+  InstallStubs();
+  uint32_t threads_count = std::max( 1u, std::thread::hardware_concurrency() );
+  ThreadPool thread_pool;
+  if( !thread_pool.Initialize( reinterpret_cast<VkDevice>(1), 0, threads_count, 1 ) ) {
+    return 1;
+  }
+
+  std::cout << filenames.size() << " file(s), best of " << repetitions_count << " run(s), " << threads_count << " core(s)" << std::endl;
+
+  std::vector<unsigned char> serial_data;
+  std::vector<unsigned char> parallel_data;
+  std::vector<unsigned char> pool_data;
+  if( !Measure( "Serial LoadTextureDataFromFile()", filenames, repetitions_count, serial_data, [&]( std::vector<unsigned char> & data, std::vector<double> & decode_times ) {
+        return LoadSerially( filenames, data, decode_times );
+      } ) ||
+      !Measure( "LoadTextureDataFromFiles() on temporary threads", filenames, repetitions_count, parallel_data, [&]( std::vector<unsigned char> & data, std::vector<double> & decode_times ) {
+        return LoadInParallel( filenames, nullptr, data, decode_times );
+      } ) ||
+      !Measure( "LoadTextureDataFromFiles() on a thread pool", filenames, repetitions_count, pool_data, [&]( std::vector<unsigned char> & data, std::vector<double> & decode_times ) {
+        return LoadInParallel( filenames, &thread_pool, data, decode_times );
+      } ) ) {
+    return 1;
+  }
+
+  if( (serial_data != parallel_data) ||
+      (serial_data != pool_data) ) {
+    std::cout << "Data loaded in parallel differs from data loaded serially!" << std::endl;
+    return 1;
+  }
+  return 0;
+}
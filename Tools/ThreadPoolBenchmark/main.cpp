@@ -0,0 +1,174 @@
+// MIT License
+//
+// Copyright( c ) 2017 Packt
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// ThreadPoolBenchmark
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include "Common.h"
+#include "09 Command Recording and Drawing/17 Recording command buffers on multiple threads.h"
+#include "09 Command Recording and Drawing/21 Recording command buffers on a persistent pool of threads.h"
+
+// Micro-benchmark comparing a thread spawned for each command buffer in every frame with a persistent pool of workers:
+//
+//   ThreadPoolBenchmark [<command buffers per frame> [<frames count> [<recording time in microseconds> [<workers count>]]]]
+//
+// No device is needed - Vulkan functions are replaced with stubs and recording only keeps a thread busy for a given time.
+// With recording time equal to 0, tasks are as small as possible, so the results show mostly contention on task queues.
+
+using namespace VulkanCookbook;
+
+namespace {
+
+  uint32_t const FRAMES_IN_FLIGHT = 3;
+
+  uint64_t NextHandle = 0x1000;
+
+  VKAPI_ATTR VkResult VKAPI_CALL CreateCommandPoolStub( VkDevice, VkCommandPoolCreateInfo const *, VkAllocationCallbacks const *, VkCommandPool * command_pool ) {
+    *command_pool = reinterpret_cast<VkCommandPool>(static_cast<uintptr_t>(NextHandle++));
+    return VK_SUCCESS;
+  }
+
+  VKAPI_ATTR void VKAPI_CALL DestroyCommandPoolStub( VkDevice, VkCommandPool, VkAllocationCallbacks const * ) {
+  }
+
+  VKAPI_ATTR VkResult VKAPI_CALL ResetCommandPoolStub( VkDevice, VkCommandPool, VkCommandPoolResetFlags ) {
+    return VK_SUCCESS;
+  }
+
+  VKAPI_ATTR VkResult VKAPI_CALL AllocateCommandBuffersStub( VkDevice, VkCommandBufferAllocateInfo const * allocate_info, VkCommandBuffer * command_buffers ) {
+    // Called concurrently by workers, but only when a worker's pool runs out of command buffers
+    static std::atomic<uint64_t> next_command_buffer( 0x100000 );
+    for( uint32_t i = 0; i < allocate_info->commandBufferCount; ++i ) {
+      command_buffers[i] = reinterpret_cast<VkCommandBuffer>(static_cast<uintptr_t>(next_command_buffer++));
+    }
+    return VK_SUCCESS;
+  }
+
+  VKAPI_ATTR VkResult VKAPI_CALL QueueSubmitStub( VkQueue, uint32_t, VkSubmitInfo const *, VkFence ) {
+    return VK_SUCCESS;
+  }
+
+  void InstallStubs() {
+    vkCreateCommandPool = CreateCommandPoolStub;
+    vkDestroyCommandPool = DestroyCommandPoolStub;
+    vkResetCommandPool = ResetCommandPoolStub;
+    vkAllocateCommandBuffers = AllocateCommandBuffersStub;
+    vkQueueSubmit = QueueSubmitStub;
+    // Recipes called for every frame use the default dispatch table
+    DefaultDeviceDispatch.vkCreateCommandPool = CreateCommandPoolStub;
+    DefaultDeviceDispatch.vkDestroyCommandPool = DestroyCommandPoolStub;
+    DefaultDeviceDispatch.vkResetCommandPool = ResetCommandPoolStub;
+    DefaultDeviceDispatch.vkAllocateCommandBuffers = AllocateCommandBuffersStub;
+    DefaultDeviceDispatch.vkQueueSubmit = QueueSubmitStub;
+  }
+
+  bool Record( uint32_t recording_time ) {
+    auto end = std::chrono::steady_clock::now() + std::chrono::microseconds( recording_time );
+    while( std::chrono::steady_clock::now() < end ) {
+    }
+    return true;
+  }
+
+  void Report( char const                                * name,
+               std::chrono::steady_clock::duration         duration,
+               uint32_t                                    frames_count,
+               uint32_t                                    command_buffers_count ) {
+    double microseconds = std::chrono::duration<double, std::micro>( duration ).count();
+    std::cout << name << ": " << microseconds / frames_count << " us per frame, "
+              << microseconds / (frames_count * command_buffers_count) << " us per command buffer" << std::endl;
+  }
+
+} // namespace
+
+int main( int argc, char ** argv ) {
+  uint32_t command_buffers_count = (argc > 1) ? static_cast<uint32_t>(std::atoi( argv[1] )) : 16;
+  uint32_t frames_count = (argc > 2) ? static_cast<uint32_t>(std::atoi( argv[2] )) : 1000;
+  uint32_t recording_time = (argc > 3) ? static_cast<uint32_t>(std::atoi( argv[3] )) : 50;
+  uint32_t threads_count = (argc > 4) ? static_cast<uint32_t>(std::atoi( argv[4] )) : std::max( 1u, std::thread::hardware_concurrency() );
+  if( (0 == command_buffers_count) ||
+      (0 == frames_count) ||
+      (0 == threads_count) ) {
+    std::cout << "Usage: ThreadPoolBenchmark [<command buffers per frame> [<frames count> [<recording time in microseconds> [<workers count>]]]]" << std::endl;
+    return -1;
+  }
+  InstallStubs();
+
+  VkDevice device = reinterpret_cast<VkDevice>(static_cast<uintptr_t>(0x10));
+  std::cout << command_buffers_count << " command buffers per frame, " << frames_count << " frames, "
+            << recording_time << " us of recording per command buffer, " << threads_count << " workers" << std::endl;
+
+  // Thread spawned for each command buffer in every frame
+  std::vector<CommandBufferRecordingThreadParameters> threads_parameters;
+  for( uint32_t i = 0; i < command_buffers_count; ++i ) {
+    threads_parameters.push_back( {
+      reinterpret_cast<VkCommandBuffer>(static_cast<uintptr_t>(0x100 + i)),
+      [recording_time]( VkCommandBuffer ) { return Record( recording_time ); }
+    } );
+  }
+  auto start = std::chrono::steady_clock::now();
+  for( uint32_t frame = 0; frame < frames_count; ++frame ) {
+    if( !RecordCommandBuffersOnMultipleThreads( threads_parameters, VK_NULL_HANDLE, {}, {}, VK_NULL_HANDLE ) ) {
+      return -1;
+    }
+  }
+  Report( "Thread per command buffer", std::chrono::steady_clock::now() - start, frames_count, command_buffers_count );
+
+  // Persistent workers
+  ThreadPool thread_pool;
+  if( !thread_pool.Initialize( device, 0, threads_count, FRAMES_IN_FLIGHT ) ) {
+    return -1;
+  }
+  std::vector<std::function<bool( VkCommandBuffer )>> recording_functions( command_buffers_count, [recording_time]( VkCommandBuffer ) {
+    return Record( recording_time );
+  } );
+  start = std::chrono::steady_clock::now();
+  for( uint32_t frame = 0; frame < frames_count; ++frame ) {
+    if( !thread_pool.BeginFrame( frame % FRAMES_IN_FLIGHT ) ||
+        !RecordCommandBuffersOnMultipleThreads( thread_pool, recording_functions, VK_NULL_HANDLE, {}, {}, VK_NULL_HANDLE ) ) {
+      return -1;
+    }
+  }
+  Report( "Persistent thread pool   ", std::chrono::steady_clock::now() - start, frames_count, command_buffers_count );
+
+  // Idle workers should sleep - processor time used while nothing is submitted shows busy waiting
+  std::clock_t idle_start = std::clock();
+  std::this_thread::sleep_for( std::chrono::milliseconds( 200 ) );
+  double idle_time = static_cast<double>(std::clock() - idle_start) / CLOCKS_PER_SEC;
+  std::cout << "Processor time used by idle workers during 200 ms: " << idle_time * 1000.0 << " ms" << std::endl;
+  thread_pool.Destroy();
+
+  if( idle_time > 0.1 ) {
+    std::cout << "Idle workers are busy waiting." << std::endl;
+    return -1;
+  }
+  return 0;
+}
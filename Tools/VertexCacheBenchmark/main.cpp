@@ -0,0 +1,132 @@
+// MIT License
+//
+// Copyright( c ) 2017 Packt
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// Vulkan Cookbook
+// ISBN: 9781786468154
+//  Packt Publishing Limited
+//
+// Author:   Pawel Lapinski
+// LinkedIn: https://www.linkedin.com/in/pawel-lapinski-84522329
+//
+// VertexCacheBenchmark
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include "Common.h"
+#include "10 Helper Recipes/09 Optimizing an indexed mesh for the post-transform vertex cache.h"
+
+// Reports the vertex cache efficiency of models before and after optimization, and the time the optimization takes:
+//
+//   VertexCacheBenchmark [<cache size> [<OBJ file> ...]]
+//
+// Without files, models from the Data/Models directory are used (run it from the build directory, like samples).
+// Each model is optimized twice - the results must be identical, as they depend only on the input data.
+
+using namespace VulkanCookbook;
+
+namespace {
+
+  bool Optimize( IndexedMesh const          & source_mesh,
+                 uint32_t                     vertex_stride,
+                 uint32_t                     cache_size,
+                 bool                         reduce_overdraw,
+                 IndexedMesh                & mesh,
+                 MeshOptimizationStatistics & statistics,
+                 double                     & milliseconds ) {
+    mesh = source_mesh;
+    auto start = std::chrono::steady_clock::now();
+    if( !OptimizeIndexedMesh( mesh, vertex_stride, cache_size, reduce_overdraw, &statistics ) ) {
+      return false;
+    }
+    milliseconds = std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - start ).count();
+    return true;
+  }
+
+  bool AreIdentical( IndexedMesh const & left,
+                     IndexedMesh const & right ) {
+    return (left.IndexType == right.IndexType) &&
+           (left.Data == right.Data) &&
+           (left.Indices == right.Indices) &&
+           (left.Parts.size() == right.Parts.size()) &&
+           (0 == std::memcmp( left.Parts.data(), right.Parts.data(), left.Parts.size() * sizeof( IndexedMesh::Part ) ));
+  }
+
+  void Report( char const                       * name,
+               MeshOptimizationStatistics const & statistics,
+               double                             milliseconds ) {
+    std::cout << "  " << std::left << std::setw( 20 ) << name << std::right << std::fixed << std::setprecision( 3 )
+              << "ACMR " << statistics.Before.ACMR << " -> " << statistics.After.ACMR << "   "
+              << "ATVR " << statistics.Before.ATVR << " -> " << statistics.After.ATVR << "   "
+              << statistics.ClusterCount << " clusters, " << std::setprecision( 2 ) << milliseconds << " ms" << std::endl;
+  }
+
+} // namespace
+
+int main( int argc, char ** argv ) {
+  uint32_t cache_size = (argc > 1) ? static_cast<uint32_t>(std::atoi( argv[1] )) : 16;
+  if( 0 == cache_size ) {
+    std::cout << "Usage: VertexCacheBenchmark [<cache size> [<OBJ file> ...]]" << std::endl;
+    return 1;
+  }
+
+  std::vector<std::string> filenames;
+  for( int i = 2; i < argc; ++i ) {
+    filenames.push_back( argv[i] );
+  }
+  if( filenames.empty() ) {
+    filenames = { "Data/Models/knot.obj", "Data/Models/teapot.obj", "Data/Models/sphere.obj", "Data/Models/ice.obj" };
+  }
+
+  bool deterministic = true;
+  std::cout << "FIFO cache of " << cache_size << " vertices" << std::endl;
+  for( auto & filename : filenames ) {
+    IndexedMesh source_mesh;
+    uint32_t vertex_stride;
+    IndexedMeshStatistics mesh_statistics;
+    if( !Load3DModelFromObjFile( filename.c_str(), true, false, false, true, source_mesh, &vertex_stride, &mesh_statistics ) ) {
+      return 1;
+    }
+    std::cout << filename << ": " << mesh_statistics.SourceVertexCount / 3 << " triangles, " << mesh_statistics.UniqueVertexCount << " unique vertices" << std::endl;
+
+    for( int reduce_overdraw = 0; reduce_overdraw < 2; ++reduce_overdraw ) {
+      IndexedMesh mesh;
+      IndexedMesh repeated_mesh;
+      MeshOptimizationStatistics statistics;
+      MeshOptimizationStatistics repeated_statistics;
+      double milliseconds;
+      double repeated_milliseconds;
+      if( !Optimize( source_mesh, vertex_stride, cache_size, 0 != reduce_overdraw, mesh, statistics, milliseconds ) ||
+          !Optimize( source_mesh, vertex_stride, cache_size, 0 != reduce_overdraw, repeated_mesh, repeated_statistics, repeated_milliseconds ) ) {
+        return 1;
+      }
+      Report( reduce_overdraw ? "Tipsify + overdraw" : "Tipsify", statistics, std::min( milliseconds, repeated_milliseconds ) );
+
+      if( !AreIdentical( mesh, repeated_mesh ) ) {
+        std::cout << "  Optimization results differ between runs!" << std::endl;
+        deterministic = false;
+      }
+    }
+  }
+  return deterministic ? 0 : 1;
+}